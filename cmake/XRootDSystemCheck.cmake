@@ -80,6 +80,22 @@ if( NOT MacOSX )
   endif()
 endif()
 
+#-------------------------------------------------------------------------------
+# Kernel-side file copy
+#-------------------------------------------------------------------------------
+if( LINUX )
+  check_function_exists( copy_file_range HAVE_COPY_FILE_RANGE )
+  compiler_define_if_found( HAVE_COPY_FILE_RANGE HAVE_COPY_FILE_RANGE )
+endif()
+
+#-------------------------------------------------------------------------------
+# Partial stat() for name space walks
+#-------------------------------------------------------------------------------
+if( LINUX )
+  check_function_exists( statx HAVE_STATX )
+  compiler_define_if_found( HAVE_STATX HAVE_STATX )
+endif()
+
 #-------------------------------------------------------------------------------
 # Check for libcrypt
 #-------------------------------------------------------------------------------
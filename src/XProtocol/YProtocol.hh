@@ -77,7 +77,13 @@
 namespace XrdCms
 {
 
-static const unsigned char kYR_Version = 3;
+static const unsigned char kYR_Version = 4;
+
+// The protocol version that introduced a feature. A peer at an older version
+// must not be sent requests or data that depend on that feature.
+//
+static const unsigned char kYR_VerBLR  = 3; // Login SID & env, BL redirect
+static const unsigned char kYR_VerBSQ  = 4; // Batched state queries (statev)
 
 struct CmsRRHdr
 {  kXR_unt32  streamid;    // Essentially opaque
@@ -115,6 +121,9 @@ enum CmsReqCode            // Request Codes
      kYR_update  = 25,
      kYR_usage   = 26,
      kYR_xauth   = 27,
+     kYR_nsum    = 28,
+     kYR_statev  = 29,
+     kYR_havev   = 30,
      kYR_MaxReq            // Count of request numbers (highest + 1)
 };
 
@@ -237,6 +246,24 @@ struct CmsHaveRequest
 //     kXR_string    Path;
 };
 
+/******************************************************************************/
+/*                         h a v e v   R e q u e s t                          */
+/******************************************************************************/
+  
+// Request: havev <count> <online> <pending>
+// Respond: n/a
+//
+// Response to a statev request. The streamid is that of the request and bit
+// i (LSB first) of each bitmap corresponds to the i'th path in the request.
+// Each bitmap is (<count>+7)/8 bytes long. Always sent with kYR_raw.
+//
+struct CmsHaveVRequest
+{      CmsRRHdr      Hdr;
+//     kXR_unt32     Count;
+//     kXR_char      Online[];
+//     kXR_char      Pending[];
+};
+
 /******************************************************************************/
 /*                        l o c a t e   R e q u e s t                         */
 /******************************************************************************/
@@ -376,6 +403,30 @@ struct CmsMvRequest {
 //     kXR_string    New_Path;
 };
 
+/******************************************************************************/
+/*                          n s u m   R e q u e s t                           */
+/******************************************************************************/
+  
+// Request: nsum <gen> <base> <size> <offset> <hashes> <data>
+// Respond: n/a
+//
+// A namespace summary is a Bloom filter of the paths a server exports. It is
+// sent as a sequence of segments, the first flagged kYR_nsfirst and the last
+// kYR_nslast. A full summary starts from an all zero filter and omits zero
+// segments; a delta starts from the summary whose generation is <base> and
+// only carries segments that changed. Always sent with the kYR_raw modifier.
+//
+struct CmsNSumRequest
+{      CmsRRHdr      Hdr;
+       enum         {kYR_nsfirst = 0x01, kYR_nsfull = 0x02, kYR_nslast = 0x04};
+//     kXR_unt32     Gen;      // Generation of the summary being sent
+//     kXR_unt32     Base;     // Generation the delta applies to
+//     kXR_unt32     Size;     // Size of the summary in bytes (power of 2)
+//     kXR_unt32     Offset;   // Offset of this segment in the summary
+//     kXR_unt32     Hashes;   // Number of hash functions
+//     kXR_char      Data[];   // Segment data
+};
+
 /******************************************************************************/
 /*                          p i n g   R e q u e s t                           */
 /******************************************************************************/
@@ -554,6 +605,24 @@ enum  {kYR_refresh = 0x01,   // Modifier
        kYR_metaman = 0x08
       };
 };
+
+/******************************************************************************/
+/*                        s t a t e v   R e q u e s t                         */
+/******************************************************************************/
+  
+// Request: statev <path> [<path> [...]]
+// Respond: havev <count> <online> <pending>
+//
+// A batch of state requests, each path null terminated, identified by the
+// streamid. A node only responds if it has at least one of the files. Always
+// sent with kYR_raw.
+//
+struct CmsStateVRequest
+{      CmsRRHdr      Hdr;
+//     kXR_string    Path[];
+
+enum  {maxPaths = 1024};     // Maximum paths in a batch
+};
   
 /******************************************************************************/
 /*                        s t a t f s   R e q u e s t                         */
@@ -107,6 +107,19 @@ if( NOT XRDCL_ONLY )
     XrdServer
     XrdUtils )
 
+  #-------------------------------------------------------------------------------
+  # cmssim
+  #-------------------------------------------------------------------------------
+  add_executable(
+    cmssim
+    XrdApps/XrdCmsSim.cc )
+
+  target_link_libraries(
+    cmssim
+    XrdServer
+    XrdUtils
+    ${CMAKE_THREAD_LIBS_INIT} )
+
   #-------------------------------------------------------------------------------
   # xrdmapc
   #-------------------------------------------------------------------------------
@@ -0,0 +1,686 @@
+/******************************************************************************/
+/*                                                                            */
+/*                          X r d C m s S i m . c c                           */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+  
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <netdb.h>
+#include <unistd.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <vector>
+
+#include "XProtocol/YProtocol.hh"
+#include "XrdCms/XrdCmsParser.hh"
+#include "XrdCms/XrdCmsRRData.hh"
+#include "XrdCms/XrdCmsTypes.hh"
+#include "XrdOuc/XrdOucPup.hh"
+#include "XrdSys/XrdSysPthread.hh"
+#include "XrdSys/XrdSysRAtomic.hh"
+#include "XrdSys/XrdSysTimer.hh"
+
+using namespace XrdCms;
+
+// cmssim drives a running cms manager with simulated data servers and clients
+// that speak the real cms wire protocol over the network. The servers log in,
+// answer pings, usage and state queries for a synthetic namespace; the clients
+// log in as redirectors and issue locate and select requests, honouring waits
+// just as an xrootd redirector would. At the end it reports the request
+// latency, how requests were answered, and how many queries the servers saw.
+
+/******************************************************************************/
+/*                        G l o b a l   O b j e c t s                         */
+/******************************************************************************/
+
+namespace
+{
+const char *manHost   = 0;
+int         manPort   = 0;
+int         numSrv    = 16;     // Simulated servers
+int         numCln    = 4;      // Simulated redirector connections
+int         numReq    = 1000;   // Requests per client
+int         numFile   = 10000;  // Files in the namespace
+int         numRep    = 2;      // Servers holding each file
+int         pctWrite  = 0;      // Percentage of selects for creation
+int         pctLoc    = 0;      // Percentage of locates
+double      zipfS     = 0.0;    // File popularity skew (0 -> uniform)
+int         svcDelay  = 0;      // Lookup time of a server (usec)
+int         numSlow   = 0;      // Number of slow servers
+int         slowDelay = 0;      // Lookup time of a slow server (usec)
+int         maxDelay  = 0;      // Largest wait honoured (0 -> as told)
+int         settle    = 5;      // Seconds to wait after all servers log in
+int         basePort  = 20000;  // Data port of the first server
+
+const char  pfxPath[] = "/sim/f";
+
+std::vector<double> zipfCDF;
+
+RAtomic_int    srvLogins(0);
+RAtomic_int    srvFails(0);
+
+RAtomic_llong  nState(0);       // state requests received
+RAtomic_llong  nStateV(0);      // statev requests received
+RAtomic_llong  nStateVP(0);     // paths in statev requests
+RAtomic_llong  nHave(0);        // have and havev responses sent
+RAtomic_llong  nPing(0);
+RAtomic_llong  nUsage(0);
+
+RAtomic_llong *srvRdr = 0;      // Redirects to each server
+RAtomic_int   *fileQry = 0;     // Queries received for each file
+
+struct ClnStats
+      {std::vector<int> lat;    // End-to-end latency (usec)
+       std::vector<int> first;  // Time to first reply (usec)
+       long long nRedir;
+       long long nData;
+       long long nWait;
+       long long nError;
+       long long nHit;          // Answered without querying any server
+
+       ClnStats() : nRedir(0), nData(0), nWait(0), nError(0), nHit(0) {}
+      };
+
+std::vector<ClnStats> clnStats;
+}
+  
+/******************************************************************************/
+/*                       L o c a l   F u n c t i o n s                        */
+/******************************************************************************/
+
+namespace
+{
+long long Now()
+{
+   struct timespec tNow;
+
+   clock_gettime(CLOCK_MONOTONIC, &tNow);
+   return static_cast<long long>(tNow.tv_sec)*1000000 + tNow.tv_nsec/1000;
+}
+
+/******************************************************************************/
+
+unsigned int Rand(unsigned int &seed)
+{
+   seed ^= seed << 13; seed ^= seed >> 17; seed ^= seed << 5;
+   return seed;
+}
+
+/******************************************************************************/
+
+int Connect()
+{
+   struct addrinfo hints, *res;
+   char sport[16];
+   int fd, one = 1;
+
+   memset(&hints, 0, sizeof(hints));
+   hints.ai_socktype = SOCK_STREAM;
+   snprintf(sport, sizeof(sport), "%d", manPort);
+   if (getaddrinfo(manHost, sport, &hints, &res)) return -1;
+
+   if ((fd = socket(res->ai_family, SOCK_STREAM, 0)) >= 0
+   &&  connect(fd, res->ai_addr, res->ai_addrlen))
+      {close(fd); fd = -1;}
+   freeaddrinfo(res);
+
+   if (fd >= 0) setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+   return fd;
+}
+
+/******************************************************************************/
+
+bool RecvAll(int fd, char *buff, int blen)
+{
+   int rc;
+
+   while(blen > 0)
+        {if ((rc = read(fd, buff, blen)) <= 0)
+            {if (rc < 0 && errno == EINTR) continue;
+             return false;
+            }
+         buff += rc; blen -= rc;
+        }
+   return true;
+}
+
+/******************************************************************************/
+
+bool Recv(int fd, CmsRRHdr &Hdr, std::vector<char> &Data)
+{
+   int dlen;
+
+   if (!RecvAll(fd, (char *)&Hdr, sizeof(Hdr))) return false;
+   dlen = ntohs(Hdr.datalen);
+   Data.resize(dlen+1);
+   if (dlen && !RecvAll(fd, Data.data(), dlen)) return false;
+   Data[dlen] = 0;
+   return true;
+}
+
+/******************************************************************************/
+
+bool SendAll(int fd, struct iovec *iov, int iovcnt)
+{
+   ssize_t rc;
+
+   while(iovcnt > 0)
+        {if ((rc = writev(fd, iov, iovcnt)) < 0)
+            {if (errno == EINTR) continue;
+             return false;
+            }
+         while(iovcnt > 0 && rc >= (ssize_t)iov->iov_len)
+              {rc -= iov->iov_len; iov++; iovcnt--;}
+         if (iovcnt > 0)
+            {iov->iov_base = (char *)iov->iov_base + rc; iov->iov_len -= rc;}
+        }
+   return true;
+}
+
+/******************************************************************************/
+
+bool Send(int fd, CmsRRHdr &Hdr, const char *data, int dlen)
+{
+   struct iovec iov[2] = {{(char *)&Hdr, sizeof(Hdr)},
+                          {(char *)data, (size_t)dlen}};
+
+   Hdr.datalen = htons(static_cast<unsigned short>(dlen));
+   return SendAll(fd, iov, (dlen ? 2 : 1));
+}
+
+/******************************************************************************/
+
+bool Login(int fd, CmsLoginData &Data, const char *who)
+{
+   static const int xNum = 20;
+   struct iovec Liov[xNum];
+   char         Work[xNum*12];
+   CmsRRHdr     Hdr = {0, kYR_login, 0, 0};
+   std::vector<char> Resp;
+   int iovcnt;
+
+// Send the login request
+//
+   if (!(iovcnt = XrdCmsParser::Pack(kYR_login, &Liov[1], &Liov[xNum],
+                                     (char *)&Data, Work))) return false;
+   Hdr.datalen = Data.Size;
+   Liov[0].iov_base = (char *)&Hdr;
+   Liov[0].iov_len  = sizeof(Hdr);
+   if (!SendAll(fd, Liov, iovcnt+1)) return false;
+
+// Get the response
+//
+   if (!Recv(fd, Hdr, Resp)) return false;
+   if (Hdr.rrCode == kYR_login) return true;
+
+        if (Hdr.rrCode == kYR_xauth)
+           fprintf(stderr, "cmssim: %s login failed; authentication is not "
+                           "supported.\n", who);
+   else if (Hdr.rrCode == kYR_try)
+           fprintf(stderr, "cmssim: %s login redirected; the manager has no "
+                           "free slot.\n", who);
+   else if (Hdr.rrCode == kYR_error && Resp.size() > sizeof(kXR_unt32))
+           fprintf(stderr, "cmssim: %s login failed; %s\n", who,
+                           Resp.data()+sizeof(kXR_unt32));
+   else    fprintf(stderr, "cmssim: %s login failed.\n", who);
+   return false;
+}
+
+/******************************************************************************/
+
+// Returns the file number of a path or -1 if it is not in the namespace.
+//
+int FileNum(const char *path)
+{
+   static const int pfxLen = sizeof(pfxPath)-1;
+   unsigned long i;
+   char *eP;
+
+   if (strncmp(path, pfxPath, pfxLen)) return -1;
+   i = strtoul(path+pfxLen, &eP, 10);
+   return (*eP || i >= (unsigned long)numFile ? -1 : static_cast<int>(i));
+}
+
+/******************************************************************************/
+
+// Server n has file i when n is one of the numRep servers following the one
+// the file hashes to. Every lookup is counted against the file so that clients
+// can tell whether the manager had to ask for it.
+//
+bool Has(int n, const char *path)
+{
+   int i = FileNum(path);
+   unsigned int base;
+
+   if (i < 0) return false;
+   fileQry[i]++;
+   base = (static_cast<unsigned int>(i) * 2654435761U) % numSrv;
+   return (n + numSrv - base) % numSrv < (unsigned int)numRep;
+}
+
+/******************************************************************************/
+
+int PickFile(unsigned int &seed)
+{
+   double r;
+
+   if (zipfCDF.empty()) return Rand(seed) % numFile;
+
+   r = (Rand(seed) & 0xffffff) / double(0x1000000);
+   return std::lower_bound(zipfCDF.begin(), zipfCDF.end(), r) - zipfCDF.begin();
+}
+}
+  
+/******************************************************************************/
+/*                                S e r v e r                                 */
+/******************************************************************************/
+
+void *Server(void *carg)
+{
+   static const char loadV[CmsLoadRequest::numLoad] = {20,20,20,20,20,20};
+   int n = static_cast<int>((long)carg), fd;
+   int myDelay = (n < numSlow ? slowDelay : svcDelay);
+   CmsLoginData Data;
+   CmsRRHdr     Hdr;
+   std::vector<char> Req;
+   std::vector<unsigned char> Bits;
+   char sid[64], who[32], buff[64], *bp;
+   int blen;
+
+// Log in as a data server exporting the simulated namespace
+//
+   snprintf(who, sizeof(who), "server %d", n);
+   snprintf(sid, sizeof(sid), "sim%d-s@cmssim simcluster", n);
+   memset(&Data, 0, sizeof(Data));
+   Data.Version  = kYR_Version;
+   Data.Mode     = CmsLoginData::kYR_server | CmsLoginData::kYR_nostage;
+   Data.HoldTime = static_cast<int>(getpid());
+   Data.tSpace   = 1000;
+   Data.fSpace   = 500000;
+   Data.fsNum    = 1;
+   Data.fsUtil   = 50;
+   Data.dPort    = static_cast<kXR_unt16>(basePort + n);
+   Data.SID      = (kXR_char *)sid;
+   Data.Paths    = (kXR_char *)"w /sim";
+
+   if ((fd = Connect()) < 0 || !Login(fd, Data, who))
+      {if (fd >= 0) close(fd);
+       srvFails++;
+       return 0;
+      }
+   srvLogins++;
+
+// Process requests until the manager goes away. Lookups take the configured
+// service time and, like a real server, only files we have get a response.
+//
+   while(Recv(fd, Hdr, Req))
+        {switch(Hdr.rrCode)
+               {case kYR_ping:
+                     nPing++;
+                     Hdr.rrCode = kYR_pong;
+                     Send(fd, Hdr, 0, 0);
+                     break;
+                case kYR_usage:
+                     nUsage++;
+                     bp = buff;
+                     blen  = XrdOucPup::Pack(&bp, loadV, sizeof(loadV));
+                     blen += XrdOucPup::Pack(&bp, 500000U);
+                     Hdr.rrCode = kYR_load; Hdr.modifier = 0;
+                     Send(fd, Hdr, buff, blen);
+                     break;
+                case kYR_state:
+                     nState++;
+                     if (myDelay) usleep(myDelay);
+                     if (Hdr.modifier & CmsStateRequest::kYR_noresp
+                     ||  !Has(n, Req.data())) break;
+                     nHave++;
+                     Hdr.rrCode   = kYR_have;
+                     Hdr.modifier = kYR_raw | CmsHaveRequest::Online;
+                     Send(fd, Hdr, Req.data(), ntohs(Hdr.datalen));
+                     break;
+                case kYR_statev:
+                    {int num = 0, hits = 0, mBytes;
+                     kXR_unt32 Count;
+                     const char *pP = Req.data(), *pE = pP + Req.size() - 1;
+                     nStateV++;
+                     Bits.assign(CmsStateVRequest::maxPaths/8*2, 0);
+                     while(pP < pE && num < CmsStateVRequest::maxPaths)
+                          {if (Has(n, pP))
+                              {Bits[num>>3] |= 1 << (num & 7); hits++;}
+                           pP += strlen(pP)+1; num++;
+                          }
+                     nStateVP += num;
+                     if (myDelay) usleep(myDelay);
+                     if (!hits) break;
+                     nHave++;
+                     mBytes = (num+7)/8;
+                     memmove(Bits.data()+sizeof(Count), Bits.data(), mBytes);
+                     Count = htonl(num);
+                     memcpy(Bits.data(), &Count, sizeof(Count));
+                     memset(Bits.data()+sizeof(Count)+mBytes, 0, mBytes);
+                     Hdr.rrCode = kYR_havev; Hdr.modifier = kYR_raw;
+                     Send(fd, Hdr, (char *)Bits.data(),
+                          sizeof(Count)+2*mBytes);
+                    }
+                     break;
+                default: break;
+               }
+        }
+
+   close(fd);
+   return 0;
+}
+  
+/******************************************************************************/
+/*                                C l i e n t                                 */
+/******************************************************************************/
+
+void *Client(void *carg)
+{
+   static const int xNum = 12;
+   int n = static_cast<int>((long)carg), fd, iovcnt, wTime;
+   unsigned int seed = (n+1) * 2654435761U, streamID = 0;
+   ClnStats    &myStats = clnStats[n];
+   CmsLoginData Data;
+   CmsRRHdr     Hdr;
+   XrdCmsRRData Req;
+   std::vector<char> Resp;
+   struct iovec xmsg[xNum];
+   char Work[xNum*12], who[32], path[64];
+   long long tBeg, tFirst;
+   int fNum, fQry;
+
+// Log in as a redirector
+//
+   snprintf(who, sizeof(who), "client %d", n);
+   memset(&Data, 0, sizeof(Data));
+   Data.Version  = kYR_Version;
+   Data.Mode     = CmsLoginData::kYR_director;
+   Data.HoldTime = static_cast<int>(getpid());
+
+   if ((fd = Connect()) < 0 || !Login(fd, Data, who))
+      {if (fd >= 0) close(fd);
+       return 0;
+      }
+
+// Issue requests one at a time, waiting when told to as a redirector would
+//
+   for (int i = 0; i < numReq; i++)
+       {memset(&Req, 0, sizeof(Req));
+        fNum = PickFile(seed);
+        snprintf(path, sizeof(path), "%s%d", pfxPath, fNum);
+        Req.Ident = (char *)"";
+        Req.Path  = path;
+        if ((int)(Rand(seed) % 100) < pctLoc)
+           {Req.Request.rrCode = kYR_locate;
+            Req.Opts = CmsLocateRequest::kYR_retipv46;
+           } else {
+            Req.Request.rrCode = kYR_select;
+            Req.Opts = CmsSelectRequest::kYR_retipv46
+                     | ((int)(Rand(seed) % 100) < pctWrite
+                     ?  CmsSelectRequest::kYR_create|CmsSelectRequest::kYR_write
+                     :  CmsSelectRequest::kYR_read);
+           }
+        if (!(iovcnt = XrdCmsParser::Pack(Req.Request.rrCode, &xmsg[1],
+                                          &xmsg[xNum], (char *)&Req, Work)))
+           {fprintf(stderr, "cmssim: unable to pack request.\n");
+            break;
+           }
+        Req.Request.streamid = ++streamID;
+        tBeg = Now(); tFirst = 0; fQry = fileQry[fNum];
+
+        do {xmsg[0].iov_base = (char *)&Req.Request;
+            xmsg[0].iov_len  = sizeof(Req.Request);
+            if (!SendAll(fd, xmsg, iovcnt+1)) goto Done;
+            do {if (!Recv(fd, Hdr, Resp)) goto Done;
+               } while(Hdr.streamid != streamID || Hdr.rrCode == kYR_waitresp);
+            if (!tFirst) tFirst = Now();
+            if (Hdr.rrCode != kYR_wait) break;
+            myStats.nWait++;
+            memcpy(&wTime, Resp.data(), sizeof(wTime));
+            wTime = ntohl(wTime);
+            if (maxDelay && wTime > maxDelay) wTime = maxDelay;
+            if (wTime > 0) XrdSysTimer::Wait(wTime*1000);
+            iovcnt = XrdCmsParser::Pack(Req.Request.rrCode, &xmsg[1],
+                                        &xmsg[xNum], (char *)&Req, Work);
+           } while(iovcnt);
+
+        switch(Hdr.rrCode)
+              {case kYR_redirect:
+                    {kXR_unt32 port;
+                     int sNum;
+                     memcpy(&port, Resp.data(), sizeof(port));
+                     sNum = static_cast<int>(ntohl(port)) - basePort;
+                     if (sNum >= 0 && sNum < numSrv) srvRdr[sNum]++;
+                     myStats.nRedir++;
+                    }
+                     break;
+               case kYR_data:  myStats.nData++;  break;
+               default:        myStats.nError++; break;
+              }
+        if (fQry == fileQry[fNum]) myStats.nHit++;
+        myStats.lat.push_back(static_cast<int>(Now() - tBeg));
+        myStats.first.push_back(static_cast<int>(tFirst - tBeg));
+       }
+
+Done:
+   close(fd);
+   return 0;
+}
+  
+/******************************************************************************/
+/*                                R e p o r t                                 */
+/******************************************************************************/
+
+void Report(const char *what, std::vector<int> &vec)
+{
+   static const double pct[] = {0.50, 0.90, 0.99, 0.999};
+   size_t num = vec.size();
+
+   if (!num) return;
+   std::sort(vec.begin(), vec.end());
+   printf("%-16s", what);
+   for (int i = 0; i < 4; i++)
+       printf(" p%-5g %9.3f", pct[i]*100,
+              vec[std::min(num-1, (size_t)(pct[i]*num))]/1000.0);
+   printf(" max %9.3f ms\n", vec[num-1]/1000.0);
+}
+
+/******************************************************************************/
+/*                                 U s a g e                                  */
+/******************************************************************************/
+
+void Usage(const char *msg)
+{
+   if (msg) fprintf(stderr, "cmssim: %s\n", msg);
+   fprintf(stderr,
+   "Usage: cmssim [-c <clients>] [-d <usec>] [-f <files>] [-l <pct>]\n"
+   "              [-m <sec>] [-n <requests>] [-p <port>] [-r <replicas>]\n"
+   "              [-s <servers>] [-t <sec>] [-w <pct>] [-x <n>:<usec>]\n"
+   "              [-z <skew>] <host>:<port>\n\n"
+   "-c number of redirector connections issuing requests (default 4)\n"
+   "-d time each server takes to look up a file (default 0)\n"
+   "-f number of files in the simulated namespace (default 10000)\n"
+   "-l percentage of requests that are locates (default 0)\n"
+   "-m longest wait to honour; longer waits are shortened (default none)\n"
+   "-n number of requests per connection (default 1000)\n"
+   "-p data port of the first server; others follow (default 20000)\n"
+   "-r number of servers holding each file (default 2)\n"
+   "-s number of simulated servers (default 16, at most %d)\n"
+   "-t seconds to let the cluster settle after logins (default 5)\n"
+   "-w percentage of selects that create files (default 0)\n"
+   "-x the first n servers take usec to look up a file\n"
+   "-z Zipf exponent of file popularity (default 0, uniform)\n"
+   "<host>:<port> is the cms port of the manager (cms.port)\n", STMax);
+   exit(msg ? 1 : 0);
+}
+  
+/******************************************************************************/
+/*                                  m a i n                                   */
+/******************************************************************************/
+
+int main(int argc, char *argv[])
+{
+   extern char *optarg;
+   extern int   optind, opterr;
+   pthread_t tid;
+   long long tBeg, tEnd, nReq = 0;
+   ClnStats  All;
+   char *colon, c;
+
+// Process the options
+//
+   opterr = 0;
+   while ((c = getopt(argc, argv, "c:d:f:hl:m:n:p:r:s:t:w:x:z:")) != (char)-1)
+         {switch(c)
+                {case 'c': numCln   = atoi(optarg); break;
+                 case 'd': svcDelay = atoi(optarg); break;
+                 case 'f': numFile  = atoi(optarg); break;
+                 case 'h': Usage(0); break;
+                 case 'l': pctLoc   = atoi(optarg); break;
+                 case 'm': maxDelay = atoi(optarg); break;
+                 case 'n': numReq   = atoi(optarg); break;
+                 case 'p': basePort = atoi(optarg); break;
+                 case 'r': numRep   = atoi(optarg); break;
+                 case 's': numSrv   = atoi(optarg); break;
+                 case 't': settle   = atoi(optarg); break;
+                 case 'w': pctWrite = atoi(optarg); break;
+                 case 'x': if (!(colon = index(optarg, ':')))
+                              Usage("-x requires <n>:<usec>");
+                           numSlow = atoi(optarg); slowDelay = atoi(colon+1);
+                           break;
+                 case 'z': zipfS    = atof(optarg); break;
+                 default:  Usage("Invalid option.");
+                }
+         }
+
+// Validate the parameters
+//
+   if (optind >= argc) Usage("Manager not specified.");
+   if (!(colon = rindex(argv[optind], ':')) || !(manPort = atoi(colon+1)))
+      Usage("Manager port not specified.");
+   *colon = 0; manHost = argv[optind];
+   if (*manHost == '[' && *(colon-1) == ']') {*(colon-1) = 0; manHost++;}
+   if (numSrv < 1 || numSrv > STMax) Usage("Invalid number of servers.");
+   if (numCln < 1 || numReq < 1 || numFile < 1) Usage("Invalid workload.");
+   if (numRep < 1 || numRep > numSrv) Usage("Invalid number of replicas.");
+
+// Compute the file popularity distribution if skewed
+//
+   if (zipfS > 0.0)
+      {double sum = 0.0;
+       zipfCDF.resize(numFile);
+       for (int i = 0; i < numFile; i++)
+           zipfCDF[i] = (sum += 1.0/pow(i+1, zipfS));
+       for (int i = 0; i < numFile; i++) zipfCDF[i] /= sum;
+      }
+
+// Start the servers and wait until they all logged in
+//
+   srvRdr = new RAtomic_llong[numSrv];
+   for (int i = 0; i < numSrv; i++) srvRdr[i] = 0;
+   fileQry = new RAtomic_int[numFile];
+   for (int i = 0; i < numFile; i++) fileQry[i] = 0;
+   for (long i = 0; i < numSrv; i++)
+       if (XrdSysThread::Run(&tid, Server, (void *)i, XRDSYSTHREAD_BIND, "sim"))
+          {fprintf(stderr, "cmssim: unable to start server thread.\n");
+           exit(2);
+          }
+   while(srvLogins + srvFails < numSrv) XrdSysTimer::Wait(100);
+   if (!srvLogins) {fprintf(stderr, "cmssim: no server logged in.\n"); exit(3);}
+   printf("cmssim: %d of %d servers logged in; settling for %d seconds.\n",
+          int(srvLogins), numSrv, settle);
+   if (settle > 0) XrdSysTimer::Snooze(settle);
+
+// Run the clients to completion
+//
+   clnStats.resize(numCln);
+   std::vector<pthread_t> clnTid(numCln);
+   tBeg = Now();
+   for (long i = 0; i < numCln; i++)
+       if (XrdSysThread::Run(&clnTid[i], Client, (void *)i,
+                             XRDSYSTHREAD_HOLD, "sim"))
+          {fprintf(stderr, "cmssim: unable to start client thread.\n");
+           exit(2);
+          }
+   for (int i = 0; i < numCln; i++) XrdSysThread::Join(clnTid[i], 0);
+   tEnd = Now();
+
+// Merge the statistics
+//
+   for (int i = 0; i < numCln; i++)
+       {ClnStats &cS = clnStats[i];
+        All.lat.insert(All.lat.end(), cS.lat.begin(), cS.lat.end());
+        All.first.insert(All.first.end(), cS.first.begin(), cS.first.end());
+        All.nRedir += cS.nRedir; All.nData  += cS.nData;
+        All.nWait  += cS.nWait;  All.nError += cS.nError;
+        All.nHit   += cS.nHit;
+       }
+   nReq = All.lat.size();
+
+// Report the results
+//
+   printf("cmssim: %lld requests from %d connections in %.3f sec (%.1f/sec)\n",
+          nReq, numCln, (tEnd-tBeg)/1000000.0,
+          (tEnd > tBeg ? nReq*1000000.0/(tEnd-tBeg) : 0.0));
+   Report("latency",     All.lat);
+   Report("first reply", All.first);
+   printf("replies          redirect %lld data %lld error %lld wait %lld\n",
+          All.nRedir, All.nData, All.nError, All.nWait);
+   printf("cache hit rate   %.2f%% answered without querying a server\n",
+          (nReq ? All.nHit*100.0/nReq : 0.0));
+   printf("server queries   state %lld statev %lld (%lld paths) have %lld "
+          "ping %lld usage %lld\n", (long long)nState, (long long)nStateV,
+          (long long)nStateVP, (long long)nHave, (long long)nPing,
+          (long long)nUsage);
+   if (nReq) printf("per request      %.3f queries (%.3f messages) sent\n",
+                    (nState + nStateVP)/double(nReq),
+                    (nState + nStateV)/double(nReq));
+   if (All.nRedir)
+      {long long rMin = srvRdr[0], rMax = srvRdr[0];
+       for (int i = 1; i < numSrv; i++)
+           {rMin = std::min(rMin, (long long)srvRdr[i]);
+            rMax = std::max(rMax, (long long)srvRdr[i]);
+           }
+       printf("redirects/server min %lld avg %.1f max %lld",
+              rMin, All.nRedir/double(numSrv), rMax);
+       if (numSlow)
+          {long long rSlow = 0;
+           for (int i = 0; i < numSlow && i < numSrv; i++) rSlow += srvRdr[i];
+           printf("; slow servers got %.2f%%", rSlow*100.0/All.nRedir);
+          }
+       printf("\n");
+      }
+   fflush(stdout);
+   _exit(0);
+}
@@ -115,6 +115,8 @@ std::map<const char *, const char *, vCmp> vnMap {
 {"xrootd.lgn.af",   "XRootD login auths bad:  "},
 {"xrootd.lgn.au",   "XRootD login auths good: "},
 {"xrootd.lgn.ua",   "XRootD login auths none: "},
+{"xrootd.mon.calls","XRootD monitor send calls:"},
+{"xrootd.mon.pkts", "XRootD monitor packets sent:"},
 {"ofs.role",        "Server role:"},
 {"ofs.opr",         "Ofs reads:"},
 {"ofs.opw",         "Ofs writes:"},
@@ -132,8 +134,28 @@ std::map<const char *, const char *, vCmp> vnMap {
 {"ofs.tpc.deny",    "TPC denials:"},
 {"ofs.tpc.err",     "TPC errors:"},
 {"ofs.tpc.exp",     "TPC expires:"},
+{"ofs.psq.cmt",     "POSC queue group commits:"},
+{"ofs.psq.req",     "POSC queue records committed:"},
+{"ofs.psq.max",     "POSC queue max group commit:"},
+{"ofs.psq.tus",     "POSC queue commit time (us):"},
 {"oss.paths",       "Oss exports:"},
 {"oss.space",       "Oss space:"},
+{"oss.ra.str",      "Oss readahead streams:"},
+{"oss.ra.iss",      "Oss readahead bytes issued:"},
+{"oss.ra.use",      "Oss readahead bytes used:"},
+{"oss.ra.wst",      "Oss readahead bytes wasted:"},
+{"oss.cpy.lnk.n",   "Oss copies by link:"},
+{"oss.cpy.lnk.b",   "Oss copy link bytes:"},
+{"oss.cpy.lnk.us",  "Oss copy link time (us):"},
+{"oss.cpy.cln.n",   "Oss copies by reflink:"},
+{"oss.cpy.cln.b",   "Oss copy reflink bytes:"},
+{"oss.cpy.cln.us",  "Oss copy reflink time (us):"},
+{"oss.cpy.kcp.n",   "Oss copies by kernel:"},
+{"oss.cpy.kcp.b",   "Oss copy kernel bytes:"},
+{"oss.cpy.kcp.us",  "Oss copy kernel time (us):"},
+{"oss.cpy.ucp.n",   "Oss copies by user:"},
+{"oss.cpy.ucp.b",   "Oss copy user bytes:"},
+{"oss.cpy.ucp.us",  "Oss copy user time (us):"},
 {"sched.jobs",      "Tasks scheduled: "},
 {"sched.inq",       "Tasks now queued:"},
 {"sched.maxinq",    "Max tasks queued:"},
@@ -127,6 +127,23 @@ virtual void  Update(const char *Buff, int BLen) = 0;
 //------------------------------------------------------------------------------
 
 virtual      ~XrdCksCalc() {}
+
+//------------------------------------------------------------------------------
+//! Append the checksum of the data that immediately follows the data seen by
+//! this object. The following data must have been checksummed by a separate
+//! object of the same type obtained via New(). This allows a checksum to be
+//! computed in independent segments. A default is given that fails as not all
+//! checksums are combinable (this method follows the destructor so that
+//! existing plugins remain usable).
+//!
+//! @param    segCalc -> The object that checksummed the following data.
+//! @param    segLen  -> The number of bytes that segCalc checksummed.
+//!
+//! @return   true if the checksums were combined and false otherwise.
+//------------------------------------------------------------------------------
+
+virtual bool  Combine(XrdCksCalc &segCalc, long long segLen)
+                     {(void)segCalc; (void)segLen; return false;}
 };
 
 /******************************************************************************/
@@ -90,6 +90,18 @@ char *Final()
              return (char *)&AdlerValue;
             }
 
+bool        Combine(XrdCksCalc &segCalc, long long segLen)
+                   {XrdCksCalcadler32 *sP;
+                    unsigned long long s1, s2, rem = segLen % AdlerBase;
+                    if (!(sP = dynamic_cast<XrdCksCalcadler32 *>(&segCalc)))
+                       return false;
+                    s1 = unSum1 + sP->unSum1 + AdlerBase - AdlerStart;
+                    s2 = unSum2 + sP->unSum2 + AdlerBase - rem
+                       + (rem * unSum1) % AdlerBase;
+                    unSum1 = s1 % AdlerBase; unSum2 = s2 % AdlerBase;
+                    return true;
+                   }
+
 void        Init() {unSum1 = AdlerStart; unSum2 = 0;}
 
 XrdCksCalc *New() {return (XrdCksCalc *)new XrdCksCalcadler32;}
@@ -176,3 +176,43 @@ void XrdCksCalccrc32::Update(const char *p, int reclen)
         C32Result = (C32Result<<8) 
                   ^ crctable[(unsigned char)((C32Result>>24)^*p++)];
 }
+
+/*****************************************************************/
+/* Combine a CRC-32 with the CRC-32 of the data that follows it. */
+/* Since the initial value is zero, the CRC is linear and the    */
+/* combined value is the first CRC multiplied by x^(8*len) plus  */
+/* the second CRC, all modulo the polynomial. The multiplier is  */
+/* computed by repeated squaring so the cost is log(len).        */
+/*****************************************************************/
+
+bool XrdCksCalccrc32::Combine(XrdCksCalc &segCalc, long long segLen)
+{
+   XrdCksCalccrc32 *sP = dynamic_cast<XrdCksCalccrc32 *>(&segCalc);
+   unsigned int xPow = 0x00000100, xMul = 0x00000001; // x^8 and x^0
+
+   if (!sP || segLen < 0) return false;
+
+   for (unsigned long long n = segLen; n; n >>= 1)
+       {if (n & 1) xMul = MulMod(xMul, xPow);
+        xPow = MulMod(xPow, xPow);
+       }
+
+   C32Result = MulMod(C32Result, xMul) ^ sP->C32Result;
+   TotLen   += sP->TotLen;
+   return true;
+}
+
+/*****************************************************************/
+/* Multiply two polynomials modulo the CRC-32 polynomial.        */
+/*****************************************************************/
+
+unsigned int XrdCksCalccrc32::MulMod(unsigned int a, unsigned int b)
+{
+   unsigned int r = 0;
+
+   for (int i = 31; i >= 0; i--)
+       {r = (r & 0x80000000 ? (r << 1) ^ CRC32_POLY : r << 1);
+        if ((b >> i) & 1) r ^= a;
+       }
+   return r;
+}
@@ -56,6 +56,8 @@ char *Final() {char buff[sizeof(long long)];
                return (char *)&TheResult;
               }
 
+bool        Combine(XrdCksCalc &segCalc, long long segLen);
+
 void        Init() {C32Result = CRC32_XINIT; TotLen = 0;}
 
 XrdCksCalc *New() {return (XrdCksCalc *)new XrdCksCalccrc32;}
@@ -68,6 +70,9 @@ const char *Type(int &csSz) {csSz = sizeof(TheResult); return "crc32";}
 virtual    ~XrdCksCalccrc32() {}
 
 private:
+static unsigned int MulMod(unsigned int a, unsigned int b);
+
+static const unsigned int CRC32_POLY  = 0x04C11DB7;
 static const unsigned int CRC32_XINIT = 0;
 static const unsigned int CRC32_XOROT = 0xffffffff;
 static       unsigned int crctable[256];
@@ -17,6 +17,40 @@
 
 */
 
+/*
+    The CRC-32C of two adjacent pieces of data may be combined as
+    crc(A|B) = crc(A) * x^(8*len(B)) + crc(B) modulo the polynomial
+    (see zlib's crc32_combine()). Everything is in the reflected
+    bit order used by the checksum itself.
+*/
+
+bool XrdCksCalccrc32C::Combine(XrdCksCalc &segCalc, long long segLen)
+{
+    XrdCksCalccrc32C *sP = dynamic_cast<XrdCksCalccrc32C *>(&segCalc);
+    unsigned int xPow = 0x00800000, xMul = 0x80000000; // x^8 and x^0
+
+    if (!sP || segLen < 0) return false;
+
+    for (unsigned long long n = segLen; n; n >>= 1)
+        {if (n & 1) xMul = MulMod(xMul, xPow);
+         xPow = MulMod(xPow, xPow);
+        }
+
+    C32CResult = MulMod(xMul, C32CResult) ^ sP->C32CResult;
+    return true;
+}
+
+unsigned int XrdCksCalccrc32C::MulMod(unsigned int a, unsigned int b)
+{
+    unsigned int r = 0;
+
+    for (unsigned int m = 0x80000000; m; m >>= 1)
+        {if (a & m) r ^= b;
+         b = (b & 1 ? (b >> 1) ^ C32C_POLY : b >> 1);
+        }
+    return r;
+}
+
 void XrdCksCalccrc32C::Update(const char *Buff, int BLen)
 {
     C32CResult = (unsigned int)XrdOucCRC::Calc32C(Buff, BLen, C32CResult);
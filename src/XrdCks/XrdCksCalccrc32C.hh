@@ -42,6 +42,8 @@
 class XrdCksCalccrc32C : public XrdCksCalc
 {
 public:
+    bool Combine(XrdCksCalc &segCalc, long long segLen);
+
     char *Final();
     
     void Init();
@@ -53,6 +55,9 @@ public:
     virtual ~XrdCksCalccrc32C(); 
 
 private:
+    static unsigned int MulMod(unsigned int a, unsigned int b);
+
+    static const unsigned int C32C_POLY  = 0x82F63B78; // Reflected
     static const unsigned int C32C_XINIT = 0;
     unsigned int C32CResult;
     unsigned int TheResult;
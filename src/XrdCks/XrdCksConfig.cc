@@ -114,9 +114,9 @@ XrdCks *XrdCksConfig::addCks(XrdCks *pCks, XrdOucEnv *envP)
 /******************************************************************************/
   
 XrdCks *XrdCksConfig::Configure(const char *dfltCalc, int rdsz,
-                                XrdOss *ossP, XrdOucEnv *envP)
+                                XrdOss *ossP, XrdOucEnv *envP, int rdThr)
 {
-   XrdCks *myCks = getCks(ossP, rdsz);
+   XrdCks *myCks = getCks(ossP, rdsz, rdThr);
    XrdOucTList *tP = CksList;
    int NoGo = 0;
 
@@ -147,16 +147,19 @@ XrdCks *XrdCksConfig::Configure(const char *dfltCalc, int rdsz,
 /* Private:                       g e t C k s                                 */
 /******************************************************************************/
 
-XrdCks *XrdCksConfig::getCks(XrdOss *ossP, int rdsz)
+XrdCks *XrdCksConfig::getCks(XrdOss *ossP, int rdsz, int rdThr)
 {
    XrdOucPinLoader *myLib;
    XrdCks          *(*ep)(XRDCKSINITPARMS);
+   XrdCksManager   *manP;
 
 // Cks manager comes from the library or we use the default
 //
    if (!CksLib)
       {if (ossP) return (XrdCks *)new XrdCksManOss (ossP,eDest,rdsz,myVersion);
-          else   return (XrdCks *)new XrdCksManager(     eDest,rdsz,myVersion);
+       manP = new XrdCksManager(eDest, rdsz, myVersion);
+       manP->SetThreads(rdThr);
+       return (XrdCks *)manP;
       }
 
 // Create a plugin object (we will throw this away without deletion because
@@ -45,7 +45,7 @@ class XrdCksConfig
 public:
 
 XrdCks *Configure(const char *dfltCalc=0, int rdsz=0,
-                  XrdOss *ossP=0, XrdOucEnv *envP=0);
+                  XrdOss *ossP=0, XrdOucEnv *envP=0, int rdThr=0);
 
 int     Manager() {return CksLib != 0;}
 
@@ -67,7 +67,7 @@ int     ParseLib(XrdOucStream &Config, int &libType);
 
 private:
 XrdCks      *addCks(XrdCks *pCks, XrdOucEnv *envP);
-XrdCks      *getCks(XrdOss *ossP, int rdsz);
+XrdCks      *getCks(XrdOss *ossP, int rdsz, int rdThr);
 
 XrdSysError    *eDest;
 const char     *cfgFN;
@@ -37,6 +37,7 @@
 #include <sys/mman.h>
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <vector>
   
 #include "XrdCks/XrdCksCalc.hh"
 #include "XrdCks/XrdCksCalcadler32.hh"
@@ -85,6 +86,10 @@ XrdCksManager::XrdCksManager(XrdSysError *erP, int rdsz, XrdVersionInfo &vInfo,
 //
    if (rdsz <= 65536) segSize = 67108864;
       else segSize = ((rdsz/65536) + (rdsz%65536 != 0)) * 65536;
+
+// Checksums are computed sequentially unless we are told otherwise
+//
+   parThreads = 1;
 }
 
 /******************************************************************************/
@@ -158,10 +163,9 @@ int XrdCksManager::Calc(const char *Pfn, time_t &MTime, XrdCksCalc *csP)
             ~ioFD() {if (FD >= 0) close(FD);}
         } In;
    struct stat Stat;
-   char *inBuff;
-   off_t  Offset=0, fileSize;
-   size_t ioSize, calcSize;
-   int rc;
+   csInfo *csIP;
+   const char *csName;
+   int csLen;
 
 // Open the input file
 //
@@ -171,20 +175,118 @@ int XrdCksManager::Calc(const char *Pfn, time_t &MTime, XrdCksCalc *csP)
 //
    if (fstat(In.FD, &Stat)) return -errno;
    if (!(Stat.st_mode & S_IFREG)) return -EPERM;
-   calcSize = fileSize = Stat.st_size;
    MTime = Stat.st_mtime;
 
+// Large files whose checksum can be computed in pieces are done in parallel
+//
+   if (parThreads > 1 && Stat.st_size >= 2*(off_t)segSize
+   &&  (csName = csP->Type(csLen)) && (csIP = Find(csName)) && csIP->doPar)
+      return CalcPar(Pfn, In.FD, Stat.st_size, csP);
+
+// Compute the checksum sequentially
+//
+   return CalcSeg(Pfn, In.FD, 0, Stat.st_size, csP);
+}
+
+/******************************************************************************/
+/* Private:                      C a l c P a r                                */
+/******************************************************************************/
+
+int XrdCksManager::CalcPar(const char *Pfn, int FD, off_t fileSize,
+                           XrdCksCalc *csP)
+{
+   XrdSysSemaphore segDone(0);
+   pthread_t tid;
+   off_t segLen;
+   int i, nSeg, rc = 0;
+
+// Split the file into at most parThreads segments of at least segSize bytes
+// each. Segments must be page aligned because they are memory mapped.
+//
+   nSeg = (fileSize/segSize < parThreads ? int(fileSize/segSize) : parThreads);
+   segLen = (fileSize + nSeg - 1) / nSeg;
+   segLen = ((segLen + 65535) / 65536) * 65536;
+   nSeg   = int((fileSize + segLen - 1) / segLen);
+
+// Allocate the segments. The first one is done by the supplied object in
+// this thread while the rest are handed off to their own thread. If we can't
+// get a checksum object for each segment, we simply do it sequentially.
+//
+   std::vector<ParSeg> segTab(nSeg);
+   for (i = 0; i < nSeg; i++)
+       {segTab[i].Mgr    = this;
+        segTab[i].Pfn    = Pfn;
+        segTab[i].FD     = FD;
+        segTab[i].Offset = i * segLen;
+        segTab[i].Length = (i+1 < nSeg ? segLen : fileSize - i*segLen);
+        segTab[i].Done   = &segDone;
+        if (!(segTab[i].csP = (i ? csP->New() : csP)))
+           {while(--i > 0) segTab[i].csP->Recycle();
+            return CalcSeg(Pfn, FD, 0, fileSize, csP);
+           }
+       }
+
+// Start the threads. Should we not be able to start one, we do it ourselves.
+//
+   for (i = 1; i < nSeg; i++)
+       {if (XrdSysThread::Run(&tid, CalcRun, (void *)&segTab[i], 0,
+                              "Cks segment")) CalcRun((void *)&segTab[i]);
+       }
+
+// Do our segment and wait for everyone else to finish
+//
+   segTab[0].rc = CalcSeg(Pfn, FD, 0, segTab[0].Length, csP);
+   for (i = 1; i < nSeg; i++) segDone.Wait();
+   for (i = 0; i < nSeg && !rc; i++) rc = segTab[i].rc;
+
+// Combine the segment checksums, in order, into the final result
+//
+   for (i = 1; i < nSeg; i++)
+       {if (!rc && !csP->Combine(*segTab[i].csP, segTab[i].Length))
+           rc = -ENOTSUP;
+        segTab[i].csP->Recycle();
+       }
+   return rc;
+}
+
+/******************************************************************************/
+/* Private:                      C a l c R u n                                */
+/******************************************************************************/
+
+void *XrdCksManager::CalcRun(void *pp)
+{
+   ParSeg *segP = (ParSeg *)pp;
+
+// Compute the checksum for this segment and tell the owner we are done
+//
+   segP->rc = segP->Mgr->CalcSeg(segP->Pfn, segP->FD, segP->Offset,
+                                 segP->Length, segP->csP);
+   segP->Done->Post();
+   return (void *)0;
+}
+
+/******************************************************************************/
+/* Private:                      C a l c S e g                                */
+/******************************************************************************/
+
+int XrdCksManager::CalcSeg(const char *Pfn, int FD, off_t Offset,
+                           size_t calcSize, XrdCksCalc *csP)
+{
+   char *inBuff;
+   size_t ioSize;
+   int rc;
+
 // We now compute checksum 64MB at a time using mmap I/O
 //
-   ioSize = (fileSize < (off_t)segSize ? fileSize : segSize); rc = 0;
+   ioSize = (calcSize < (size_t)segSize ? calcSize : segSize); rc = 0;
    while(calcSize)
         {if ((inBuff = (char *)mmap(0, ioSize, PROT_READ, 
 #if defined(__FreeBSD__)
-                       MAP_RESERVED0040|MAP_PRIVATE, In.FD, Offset)) == MAP_FAILED)
+                       MAP_RESERVED0040|MAP_PRIVATE, FD, Offset)) == MAP_FAILED)
 #elif defined(__GNU__)
-                       MAP_PRIVATE, In.FD, Offset)) == MAP_FAILED)
+                       MAP_PRIVATE, FD, Offset)) == MAP_FAILED)
 #else
-                       MAP_NORESERVE|MAP_PRIVATE, In.FD, Offset)) == MAP_FAILED)
+                       MAP_NORESERVE|MAP_PRIVATE, FD, Offset)) == MAP_FAILED)
 #endif
             {rc = errno; eDest->Emsg("Cks", rc, "memory map", Pfn); break;}
          madvise(inBuff, ioSize, MADV_SEQUENTIAL);
@@ -306,6 +408,7 @@ int XrdCksManager::Init(const char *ConfigFN, const char *DfltCalc)
                        return 0;
                       }
                  csTab[i].Obj->Type(csTab[i].Len);
+                 csTab[i].doPar = strcmp("md5", csTab[i].Name) != 0;
                 }
        }
 
@@ -614,6 +717,18 @@ int XrdCksManager::Set(const char *Pfn, XrdCksData &Cks, int myTime)
    return xCS.Set(Pfn);
 }
 
+/******************************************************************************/
+/*                            S e t T h r e a d s                             */
+/******************************************************************************/
+
+void XrdCksManager::SetThreads(int nThreads)
+{
+   static const int maxThreads = 64;
+
+   if (nThreads < 1) parThreads = 1;
+      else parThreads = (nThreads > maxThreads ? maxThreads : nThreads);
+}
+
 /******************************************************************************/
 /*                                   V e r                                    */
 /******************************************************************************/
@@ -43,6 +43,7 @@
 class  XrdCksCalc;
 class  XrdCksLoader;
 class  XrdSysError;
+class  XrdSysSemaphore;
 struct XrdVersionInfo;
   
 class XrdCksManager : public XrdCks
@@ -68,6 +69,13 @@ virtual int         Size( const char  *Name=0);
 
 virtual int         Set(  const char *Pfn, XrdCksData &Cks, int myTime=0);
 
+/* SetThreads() sets the number of threads used to compute the checksum of a
+                large file. The file is split into that many segments that are
+                checksummed in parallel and then combined. This is only done
+                for native checksums that can be combined (i.e. not md5).
+*/
+        void        SetThreads(int nThreads);
+
 virtual int         Ver(  const char *Pfn, XrdCksData &Cks);
 
                     XrdCksManager(XrdSysError *erP, int iosz,
@@ -98,11 +106,31 @@ struct csInfo
        XrdSysPlugin *Plugin;
        int           Len;
        bool          doDel;
+       bool          doPar;
                      csInfo() : Obj(0), Path(0), Parms(0), Plugin(0), Len(0),
-                                doDel(true)
+                                doDel(true), doPar(false)
                                 {memset(Name, 0, sizeof(Name));}
       };
 
+struct ParSeg
+      {XrdCksManager   *Mgr;
+       const char      *Pfn;
+       XrdCksCalc      *csP;
+       XrdSysSemaphore *Done;
+       off_t            Offset;
+       size_t           Length;
+       int              FD;
+       int              rc;
+                        ParSeg() : Mgr(0), Pfn(0), csP(0), Done(0), Offset(0),
+                                   Length(0), FD(-1), rc(0) {}
+      };
+
+int     CalcPar(const char *Pfn, int FD, off_t fileSize, XrdCksCalc *csP);
+static
+void   *CalcRun(void *pp);
+int     CalcSeg(const char *Pfn, int FD, off_t Offset, size_t calcSize,
+                XrdCksCalc *csP);
+
 int     Config(const char *cFN, csInfo &Info);
 csInfo *Find(const char *Name);
 
@@ -110,6 +138,7 @@ static const int csMax = 8;
 csInfo           csTab[csMax];
 int              csLast;
 int              segSize;
+int              parThreads;
 XrdCksLoader    *cksLoader;
 XrdVersionInfo  &myVersion;
 };
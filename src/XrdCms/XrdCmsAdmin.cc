@@ -40,6 +40,7 @@
 #include "XProtocol/YProtocol.hh"
 
 #include "XrdCms/XrdCmsAdmin.hh"
+#include "XrdCms/XrdCmsBaseFS.hh"
 #include "XrdCms/XrdCmsConfig.hh"
 #include "XrdCms/XrdCmsManager.hh"
 #include "XrdCms/XrdCmsMeter.hh"
@@ -827,6 +828,10 @@ void XrdCmsAdmin::do_RmDud(int isPfn)
           } else tp = apath;
       }
 
+// The file is no longer missing should we be remembering such things
+//
+   baseFS.Added(tp);
+
 // Check if we are relaying remove events and, if so, vector through that.
 //
    if (areFunc) AddEvent(tp, kYR_have, Mods);
@@ -33,12 +33,14 @@
 #include <sys/time.h>
 #include <sys/types.h>
 #include <cstdio>
+#include <vector>
   
 #include "XProtocol/YProtocol.hh"
 #include "XProtocol/XPtypes.hh"
 
 #include "XrdCms/XrdCmsBaseFS.hh"
 #include "XrdCms/XrdCmsConfig.hh"
+#include "XrdCms/XrdCmsKey.hh"
 #include "XrdCms/XrdCmsPrepare.hh"
 #include "XrdCms/XrdCmsTrace.hh"
 
@@ -60,11 +62,32 @@ void *XrdCmsBasePacer(void *carg)
        return (void *)0;
       }
 
+void *XrdCmsBaseLooker(void *carg)
+      {((XrdCmsBaseFS *)carg)->Looker();
+       return (void *)0;
+      }
+
 void *XrdCmsBaseRunner(void *carg)
       {((XrdCmsBaseFS *)carg)->Runner();
        return (void *)0;
       }
 
+/******************************************************************************/
+/*                                 A d d e d                                  */
+/******************************************************************************/
+
+void XrdCmsBaseFS::Added(const char *Path)
+{
+
+// Forget that the file was missing, if we remember such things
+//
+   if (mfLife)
+      {fsMutex.Lock();
+       fsNegMP.Del(Path);
+       fsMutex.UnLock();
+      }
+}
+
 /******************************************************************************/
 /* Private:                       B y p a s s                                 */
 /******************************************************************************/
@@ -151,13 +174,27 @@ int XrdCmsBaseFS::Exists(XrdCmsRRData &Arg, XrdCmsPInfo &Who, int noLim)
 int XrdCmsBaseFS::Exists(char *Path, int fnPos, int UpAT)
 {
    EPNAME("Exists");
-   static struct dMoP dirMiss = {0}, dirPres = {1};
+   static struct dMoP dirMiss = {0}, dirPres = {1}, fileMiss = {0};
    static int badDStat = 0;
    static int badFStat = 0;
    struct stat buf;
    int eCnt, fRC, dRC;
    int Opts = (UpAT ? XRDOSS_resonly|XRDOSS_updtatm : XRDOSS_resonly);
 
+// If we remember missing files, check if we already know this one is missing.
+// A staging server must still report a file being staged as pending.
+//
+   if (mfLife)
+      {fsMutex.Lock();
+       eCnt = (fsNegMP.Find(Path) != 0);
+       fsMutex.UnLock();
+       if (eCnt)
+          {if (Config.DiskSS && PrepQ.Exists(Path))
+              return CmsHaveRequest::Pending;
+           return -1;
+          }
+      }
+
 // If directory checking is enabled, find where the directory component ends 
 // if so requested.
 //
@@ -169,7 +206,8 @@ int XrdCmsBaseFS::Exists(char *Path, int fnPos, int UpAT)
 // Issue stat() via oss plugin. If it succeeds, return result.
 //
    if (!(fRC = Config.ossFS->Stat(Path, &buf, Opts)))
-      {if ((buf.st_mode & S_IFMT) == S_IFREG)
+      {if (mfLife) Added(Path);
+       if ((buf.st_mode & S_IFMT) == S_IFREG)
           return (buf.st_mode & XRDSFS_POSCPEND ? CmsHaveRequest::Pending
                                                 : CmsHaveRequest::Online);
 
@@ -181,9 +219,19 @@ int XrdCmsBaseFS::Exists(char *Path, int fnPos, int UpAT)
 //
    if (Config.DiskSS && PrepQ.Exists(Path)) return CmsHaveRequest::Pending;
 
-// The entry does not exist. Check if the directory exists and if not, put it
-// in our directory missing table so we don't keep hitting this directory.
-// This is disabled by default and enabled by the cms.dfs directive.
+// The entry does not exist. Remember that, if so wanted, so that repeated
+// queries for the file do not each require a stat().
+//
+   if (mfLife && fRC == -ENOENT)
+      {fsMutex.Lock();
+       if (fsNegMP.Num() >= mfMax) fsNegMP.Purge();
+       fsNegMP.Rep(Path, &fileMiss, mfLife, Hash_keepdata);
+       fsMutex.UnLock();
+      }
+
+// Check if the directory exists and if not, put it in our directory missing
+// table so we don't keep hitting this directory. This is disabled by default
+// and enabled by the cms.dfs directive.
 //
    if (fnPos > 0 && dmLife)
       {struct dMoP *xVal = &dirMiss;
@@ -219,6 +267,84 @@ int XrdCmsBaseFS::Exists(char *Path, int fnPos, int UpAT)
    return -1;
 }
 
+/******************************************************************************/
+/* Public:                       E x i s t s V                                */
+/******************************************************************************/
+
+void XrdCmsBaseFS::ExistsV(char **Path, int *Plen, int *Rslt, int Num)
+{
+   EPNAME("ExistsV");
+   LkupBatch theB;
+   std::vector<int> Dupl(Num, -1), Todo;
+   std::vector<int> hTab;
+   unsigned int hMask;
+   int i, j, n, nDup = 0;
+
+// Size a small open hash table at twice the number of paths
+//
+   hMask = 15;
+   while(hMask < static_cast<unsigned int>(Num)*2) hMask = hMask*2+1;
+   hTab.assign(hMask+1, -1);
+   Todo.reserve(Num);
+
+// Find the paths that need to be looked up, noting which are duplicates of
+// an earlier one in the batch. Empty paths never exist.
+//
+   for (i = 0; i < Num; i++)
+       {Rslt[i] = -1;
+        if (!Plen[i]) continue;
+        XrdCmsKey theKey(Path[i], Plen[i]);
+        theKey.setHash();
+        j = theKey.Hash & hMask;
+        while((n = hTab[j]) >= 0)
+             {if (Plen[n] == Plen[i] && !strcmp(Path[n], Path[i])) break;
+              j = (j+1) & hMask;
+             }
+        if (n >= 0) {Dupl[i] = n; nDup++;}
+           else {hTab[j] = i; Todo.push_back(i);}
+       }
+
+// Setup the batch
+//
+   theB.Path = Path; theB.Plen = Plen; theB.Rslt = Rslt;
+   theB.Todo = Todo.data(); theB.Num = Todo.size();
+   DEBUG(theB.Num <<" lookups " <<nDup <<" duplicates");
+
+// If there is more than one lookup, make the batch available to the lookup
+// threads so that they can help us out. We do our share as well.
+//
+   if (theB.Num > 1 && lkThreads > 1)
+      {lkMutex.Lock();
+       if (lkLast) lkLast->Next = &theB;
+          else lkFirst = &theB;
+       lkLast = &theB;
+       lkMutex.UnLock();
+       n = (theB.Num-1 < lkThreads ? theB.Num-1 : lkThreads);
+       for (i = 0; i < n; i++) lkAvail.Post();
+       LkupRun(&theB);
+
+// Remove the batch from the queue and wait for any helper to finish with it
+//
+       lkMutex.Lock();
+       LkupBatch *pP = 0, *bP = lkFirst;
+       while(bP && bP != &theB) {pP = bP; bP = bP->Next;}
+       if (bP)
+          {if (pP) pP->Next = theB.Next;
+              else lkFirst  = theB.Next;
+           if (lkLast == &theB) lkLast = pP;
+          }
+       theB.Gone = true;
+       n = theB.Refs;
+       lkMutex.UnLock();
+       if (n) theB.Fini.Wait();
+      } else LkupRun(&theB);
+
+// Copy results to the duplicates
+//
+   if (nDup)
+      for (i = 0; i < Num; i++) if (Dupl[i] >= 0) Rslt[i] = Rslt[Dupl[i]];
+}
+
 /******************************************************************************/
 /* Private:                       h a s D i r                                 */
 /******************************************************************************/
@@ -271,6 +397,60 @@ void XrdCmsBaseFS::Limit(int rLim, int Qmax)
       else if (!(theQ.qMax = theQ.rLimit*2 + theQ.rLimit/2)) theQ.qMax = 1;
 }
 
+/******************************************************************************/
+/*                                L o o k u p                                 */
+/******************************************************************************/
+
+void XrdCmsBaseFS::Lookup(int tNum, int mfHold)
+{
+
+// Establish the number of lookup threads and how long to remember a miss
+//
+   lkThreads = (tNum > 0 ? tNum : 1);
+   mfLife    = mfHold;
+}
+
+/******************************************************************************/
+/*                                L o o k e r                                 */
+/******************************************************************************/
+
+void XrdCmsBaseFS::Looker()
+{
+   LkupBatch *bP;
+
+// Help out with the oldest batch that still has paths to be looked up
+//
+do{lkAvail.Wait();
+   lkMutex.Lock();
+   bP = lkFirst;
+   while(bP && bP->Claim >= bP->Num) bP = bP->Next;
+   if (bP) bP->Refs++;
+   lkMutex.UnLock();
+   if (bP)
+      {LkupRun(bP);
+       lkMutex.Lock();
+       if (!(--bP->Refs) && bP->Gone) bP->Fini.Post();
+       lkMutex.UnLock();
+      }
+  } while(1);
+}
+
+/******************************************************************************/
+/* Private:                      L k u p R u n                                */
+/******************************************************************************/
+
+void XrdCmsBaseFS::LkupRun(LkupBatch *bP)
+{
+   int i, k;
+
+// Claim paths from the batch one at a time until all have been claimed
+//
+   while((k = bP->Claim++) < bP->Num)
+        {i = bP->Todo[k];
+         bP->Rslt[i] = Exists(bP->Path[i], -(bP->Plen[i]));
+        }
+}
+
 /******************************************************************************/
 /*                                 P a c e r                                  */
 /******************************************************************************/
@@ -291,8 +471,9 @@ do{theQ.pqAvail.Wait();
             {delete rP; continue;}
          theQ.Mutex.Lock();
          if (theQ.rqFirst) {theQ.rqLast->Next = rP; theQ.rqLast = rP;}
-            else {theQ.rqFirst  = theQ.rqLast = rP; theQ.rqAvail.Post();}
+            else  theQ.rqFirst  = theQ.rqLast = rP;
          theQ.Mutex.UnLock();
+         theQ.rqAvail.Post();
          XrdSysTimer::Wait(rqRate);
          if (!inQ) break;
          theQ.Mutex.Lock();
@@ -354,21 +535,18 @@ void XrdCmsBaseFS::Queue(XrdCmsRRData &Arg, XrdCmsPInfo &Who,
 void XrdCmsBaseFS::Runner()
 {
    XrdCmsBaseFR *rP;
-   int inQ;
 
-// Process requests at the given rate
+// Process requests as the pacer releases them. There may be several runners
+// so that a slow stat() does not hold up the requests behind it.
 //
 do{theQ.rqAvail.Wait();
-   theQ.Mutex.Lock(); inQ = 1;
-   while((rP = theQ.rqFirst))
-        {if (!(theQ.rqFirst = rP->Next)) {theQ.rqLast = 0; inQ = 0;}
-         theQ.qNum--;
-         theQ.Mutex.UnLock();
-         Xeq(rP); delete rP;
-         if (!inQ) break;
-         theQ.Mutex.Lock();
-        }
-   if (inQ) theQ.Mutex.UnLock();
+   theQ.Mutex.Lock();
+   if ((rP = theQ.rqFirst))
+      {if (!(theQ.rqFirst = rP->Next)) theQ.rqLast = 0;
+       theQ.qNum--;
+      }
+   theQ.Mutex.UnLock();
+   if (rP) {Xeq(rP); delete rP;}
   } while(1);
 }
 
@@ -401,8 +579,26 @@ void XrdCmsBaseFS::Start()
        ||  XrdSysThread::Run(&tid, XrdCmsBaseRunner, Me, 0, "fsQ runner"))
           {Say.Emsg("cmsd", errno, "start baseFS queue handler");
            theQ.rLimit = 0;
+          } else {
+           for (int i = 1; i < lkThreads; i++)
+               if (XrdSysThread::Run(&tid,XrdCmsBaseRunner,Me,0,"fsQ runner"))
+                  break;
           }
       }
+
+// Start the threads that look up batches of paths in parallel. These are only
+// needed where batches are received, that is, on data servers.
+//
+   if (Config.asServer() && !Config.asManager() && !Config.asPeer())
+      {int i;
+       for (i = 1; i < lkThreads; i++)
+           if (XrdSysThread::Run(&tid, XrdCmsBaseLooker, Me, 0, "fs lookup"))
+              {Say.Emsg("cmsd", errno, "start baseFS lookup thread");
+               break;
+              }
+       lkThreads = i;
+       DEBUG(lkThreads <<" lookup threads; missing files held " <<mfLife);
+      } else lkThreads = 1;
 }
 
 /******************************************************************************/
@@ -38,6 +38,7 @@
 #include "XrdCms/XrdCmsTypes.hh"
 #include "XrdOuc/XrdOucHash.hh"
 #include "XrdSys/XrdSysPthread.hh"
+#include "XrdSys/XrdSysRAtomic.hh"
 
 /******************************************************************************/
 /*                    C l a s s   X r d C m s B a s e F R                     */
@@ -107,6 +108,18 @@ public:
 
        int              Exists(char *Path, int fnPos, int UpAT=0);
 
+// ExistsV() checks a batch of Num paths, each as Exists(Path[i], -Plen[i])
+// would, placing the result in Rslt[i]. Identical paths are only checked once
+// and the remaining lookups are spread across the lookup threads.
+//
+       void             ExistsV(char **Path, int *Plen, int *Rslt, int Num);
+
+// Added() is called when a file is created, renamed into place, or found to
+// exist so that it is no longer reported as missing should missing files be
+// remembered.
+//
+       void             Added(const char *Path);
+
 // Valid Opts for Init()
 //
 static const int        Cntrl  = 0x0001; // Centralize stat() o/w distribute it
@@ -124,6 +137,10 @@ inline int              Limit() {return theQ.rLimit;}
 
 inline int              Local() {return lclStat;}
 
+       void             Lookup(int tNum, int mfLife);
+
+       void             Looker();
+
        void             Pacer();
 
        void             Runner();
@@ -149,7 +166,8 @@ inline int              Traverse() {return Punt;}
        XrdCmsBaseFS(void (*theCB)(XrdCmsBaseFR *, int))
                    : cBack(theCB), dfsMaxTries(dfltDfsTries),
                                    stgMaxTries(dfltStgTries),
-                     dmLife(0), dpLife(0), lclStat(0), preSel(1),
+                     dmLife(0), dpLife(0), mfLife(0), lkThreads(8), lkAvail(0),
+                     lkFirst(0), lkLast(0), lclStat(0), preSel(1),
                      dfsSys(0), Server(0), Fixed(0), Punt(0) {}
       ~XrdCmsBaseFS() {}
 
@@ -157,15 +175,34 @@ private:
 
 struct dMoP {int        Present;};
 
+static const int mfMax = 262144; // Most missing files remembered
+
+struct LkupBatch
+      {LkupBatch       *Next;
+       char           **Path;
+       int             *Plen;
+       int             *Rslt;
+       int             *Todo;     // Indices of the paths to be looked up
+       int              Num;      // Number of elements in Todo
+       RAtomic_int      Claim;    // Next element of Todo to be looked up
+       int              Refs;     // Lookup threads using this batch
+       bool             Gone;     // Batch no longer queued
+       XrdSysSemaphore  Fini;
+       LkupBatch() : Next(0), Claim(0), Refs(0), Gone(false), Fini(0) {}
+      ~LkupBatch() {}
+      };
+
        int              Bypass();
        int              FStat( char *Path, int fnPos, int upat=0);
        int              hasDir(char *Path, int fnPos);
+       void             LkupRun(LkupBatch *bP);
        void             Queue(XrdCmsRRData &Arg, XrdCmsPInfo &Who,
                               int dln, int Frc=0);
        void             Xeq(XrdCmsBaseFR *rP);
 
        XrdSysMutex      fsMutex;
        XrdOucHash<dMoP> fsDirMP;
+       XrdOucHash<dMoP> fsNegMP;  // Missing files (only if mfLife)
        void             (*cBack)(XrdCmsBaseFR *, int);
 
 struct RequestQ
@@ -193,6 +230,13 @@ struct RequestQ
        int              stgMaxTries;
        int              dmLife;
        int              dpLife;
+       int              mfLife;
+       int              lkThreads;
+
+       XrdSysMutex      lkMutex;
+       XrdSysSemaphore  lkAvail;
+       LkupBatch       *lkFirst;
+       LkupBatch       *lkLast;
        char             lclStat;  // 1-> Local stat() calls wanted
        char             preSel;   // 1-> Preselect before redirect
        char             dfsSys;   // 1-> Distributed Filesystem
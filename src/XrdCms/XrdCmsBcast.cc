@@ -0,0 +1,255 @@
+/******************************************************************************/
+/*                                                                            */
+/*                        X r d C m s B c a s t . c c                         */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <sys/uio.h>
+
+#include "XrdCms/XrdCmsBcast.hh"
+#include "XrdCms/XrdCmsNode.hh"
+#include "XrdCms/XrdCmsTrace.hh"
+#include "XrdSys/XrdSysError.hh"
+
+using namespace XrdCms;
+
+/******************************************************************************/
+/*                               G l o b a l s                                */
+/******************************************************************************/
+
+       XrdCmsBcast  XrdCms::Bcast;
+
+/******************************************************************************/
+/*                      X r d C m s B c a s t : : M s g                       */
+/******************************************************************************/
+
+
+// A message is shared by all of the nodes it is queued for and is freed when
+// the last of them has been written.
+
+struct XrdCmsBcast::Msg
+      {long long  tBeg;    // When the message was broadcast
+       int        Refs;    // Protected by bcMutex
+       int        Dlen;
+       char      *Data;
+      };
+
+/******************************************************************************/
+/*            E x t e r n a l   T h r e a d   I n t e r f a c e s             */
+/******************************************************************************/
+
+namespace
+{
+void *BcastRun(void *carg)
+      {XrdCmsBcast *bp = (XrdCmsBcast *)carg;
+       return bp->Writer();
+      }
+}
+
+/******************************************************************************/
+/*                               P e n d i n g                                */
+/******************************************************************************/
+
+bool XrdCmsBcast::Pending(XrdCmsNode *nP)
+{
+   bool busy;
+
+   bcMutex.Lock();
+   busy = nP->bcQ.qBusy;
+   bcMutex.UnLock();
+   return busy;
+}
+
+/******************************************************************************/
+/*                                  S e n d                                   */
+/******************************************************************************/
+
+SMask_t XrdCmsBcast::Send(XrdCmsNode **nVec, int nNum,
+                          const struct iovec *iod, int iovcnt, int iotot)
+{
+   SMask_t skipped(0);
+   Msg *mP;
+   char *bP;
+   int i, k, nRdy = 0;
+
+// Copy the message into a single buffer that all of the nodes will share
+//
+   if (iotot <= 0) for (iotot = 0, i = 0; i < iovcnt; i++)
+                       iotot += iod[i].iov_len;
+   if (!(mP = (Msg *)malloc(sizeof(Msg) + iotot)))
+      {for (i = 0; i < nNum; i++) skipped |= nVec[i]->Mask();
+       return skipped;
+      }
+   mP->Data = bP = (char *)(mP + 1);
+   for (i = 0; i < iovcnt; i++)
+       {memcpy(bP, iod[i].iov_base, iod[i].iov_len); bP += iod[i].iov_len;}
+   mP->Dlen = iotot;
+   mP->Refs = 1;
+   mP->tBeg = XrdCmsNode::Microsec();
+
+// Queue the message for each node. A node that is not being written becomes
+// ready and we keep a reference to it until its queue has been drained.
+//
+   bcMutex.Lock();
+   Stats.Bcast++;
+   for (i = 0; i < nNum; i++)
+       {Queue &qR = nVec[i]->bcQ;
+        if (qR.qNum >= qMax)
+           {skipped |= nVec[i]->Mask(); Stats.Skips++; continue;}
+        k = (qR.qHead + qR.qNum) % maxQ;
+        qR.qMsg[k] = mP; qR.qNum++; mP->Refs++;
+        if (!qR.qBusy)
+           {qR.qBusy = true; qR.qNext = 0;
+            nVec[i]->Ref();
+            if (rdyLast) rdyLast->bcQ.qNext = nVec[i];
+               else      rdyFirst           = nVec[i];
+            rdyLast = nVec[i];
+            nRdy++;
+           }
+       }
+   Release(mP);
+   bcMutex.UnLock();
+
+// Wake up enough writers to handle the nodes that became ready
+//
+   if (nRdy > wrThreads) nRdy = wrThreads;
+   for (i = 0; i < nRdy; i++) rdyAvail.Post();
+   return skipped;
+}
+
+/******************************************************************************/
+/*                                 S t a r t                                  */
+/******************************************************************************/
+
+int XrdCmsBcast::Start()
+{
+   pthread_t tid;
+   int i;
+
+// A zero thread count means broadcasts are to be written inline
+//
+   if (wrThreads <= 0) return 1;
+
+// Start the writers
+//
+   for (i = 0; i < wrThreads; i++)
+       if (XrdSysThread::Run(&tid, BcastRun, (void *)this, 0, "Bcast writer"))
+          {Say.Emsg("Bcast", errno, "start broadcast writer");
+           break;
+          }
+   if (!(wrThreads = i)) return 0;
+   Active = true;
+   return 1;
+}
+
+/******************************************************************************/
+/*                            S t a t i s t i c s                             */
+/******************************************************************************/
+
+void XrdCmsBcast::Statistics(XrdCmsBcast::Info &Data)
+{
+   bcMutex.Lock();
+   Data = Stats;
+   bcMutex.UnLock();
+}
+
+/******************************************************************************/
+/*                                W r i t e r                                 */
+/******************************************************************************/
+
+void *XrdCmsBcast::Writer()
+{
+   static const int maxTurn = 8;
+   XrdCmsNode *nP;
+   Msg *mP;
+   int n, rc;
+
+// Write the queued messages of each ready node in turn. We write a few at a
+// time so that a busy node does not keep the others waiting; a node that can't
+// be written to loses whatever it has queued and is marked offline so that
+// later broadcasts and queries report it as unqueried instead of waiting.
+//
+do{rdyAvail.Wait();
+   bcMutex.Lock();
+   while((nP = rdyFirst))
+        {Queue &qR = nP->bcQ;
+         if (!(rdyFirst = qR.qNext)) rdyLast = 0;
+         for (n = 0; qR.qNum && n < maxTurn; n++)
+             {mP = qR.qMsg[qR.qHead];
+              qR.qHead = (qR.qHead + 1) % maxQ; qR.qNum--;
+              bcMutex.UnLock();
+              rc = nP->Send(mP->Data, mP->Dlen);
+              bcMutex.Lock();
+              Release(mP);
+              if (rc < 0)
+                 {nP->isOffline = 1;  // STMutex not needed here
+                  while(qR.qNum)
+                       {Release(qR.qMsg[qR.qHead]);
+                        qR.qHead = (qR.qHead + 1) % maxQ; qR.qNum--;
+                       }
+                 } else Stats.Wrote++;
+             }
+         if (qR.qNum)
+            {qR.qNext = 0;
+             if (rdyLast) rdyLast->bcQ.qNext = nP;
+                else      rdyFirst           = nP;
+             rdyLast = nP;
+            } else {
+             qR.qBusy = false;
+             nP->unRef();
+            }
+        }
+   bcMutex.UnLock();
+  } while(1);
+
+// Keep compiler happy
+//
+   return (void *)0;
+}
+
+/******************************************************************************/
+/*                       P r i v a t e   M e t h o d s                        */
+/******************************************************************************/
+/******************************************************************************/
+/*                               R e l e a s e                                */
+/******************************************************************************/
+
+// Caller must hold bcMutex. When the last reference goes away the message has
+// reached every node it was queued for and we know how long that took.
+
+void XrdCmsBcast::Release(XrdCmsBcast::Msg *mP)
+{
+   long long tDone;
+
+   if (--(mP->Refs)) return;
+
+   tDone = XrdCmsNode::Microsec() - mP->tBeg;
+   Stats.tTot += tDone;
+   if (tDone > Stats.tMax) Stats.tMax = tDone;
+   free(mP);
+}
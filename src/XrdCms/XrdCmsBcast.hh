@@ -0,0 +1,124 @@
+#ifndef __XRDCMSBCAST__H
+#define __XRDCMSBCAST__H
+/******************************************************************************/
+/*                                                                            */
+/*                        X r d C m s B c a s t . h h                         */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <cstring>
+
+#include "XrdCms/XrdCmsTypes.hh"
+#include "XrdSys/XrdSysPthread.hh"
+
+class XrdCmsNode;
+
+/******************************************************************************/
+/*                     C l a s s   X r d C m s B c a s t                      */
+/******************************************************************************/
+
+// XrdCmsBcast writes the messages broadcast by XrdCmsCluster so that the
+// broadcasting thread never waits on a node. Each node has a short queue of
+// messages drained, in order, by a small pool of writer threads. A node whose
+// queue is full is too slow to keep up and is skipped; the caller sees this
+// as the node not having been queried, just as if it were unreachable.
+//
+class XrdCmsBcast
+{
+public:
+
+struct Info
+      {long long Bcast;    // Messages broadcast
+       long long Wrote;    // Messages written to nodes
+       long long Skips;    // Messages skipped as a node was too far behind
+       long long tTot;     // Total time to reach all nodes (microseconds)
+       long long tMax;     // Longest time to reach all nodes (microseconds)
+      };
+
+static const int maxQ = 64;       // Largest allowed queue per node
+
+struct Msg;
+
+struct Queue
+      {Msg        *qMsg[maxQ];
+       XrdCmsNode *qNext;  // Next node ready to be written
+       int         qHead;
+       int         qNum;
+       bool        qBusy;  // Node is ready or being written
+
+                   Queue() : qNext(0), qHead(0), qNum(0), qBusy(false) {}
+                  ~Queue() {}
+      };
+
+// Pending() returns true if the node still has messages queued or being
+//           written. Anything else sent to such a node must go through Send()
+//           so that it does not overtake what was queued before it.
+//
+bool       Pending(XrdCmsNode *nP);
+
+// Send() queues a message for each of the nodes and returns the mask of the
+//        nodes that were skipped. The caller must hold the cluster lock so
+//        that the node pointers remain valid.
+//
+SMask_t    Send(XrdCmsNode **nVec, int nNum,
+                const struct iovec *iod, int iovcnt, int iotot);
+
+// Set the writer parameters (cms.bcast directive). Zero threads turns the
+// writer off so that broadcasts are written inline, as they once were.
+//
+void       setParms(int thr, int qmax) {wrThreads = thr; qMax = qmax;}
+
+int        Start();
+
+void       Statistics(Info &Data);
+
+void      *Writer();
+
+inline bool isActive() {return Active;}
+
+      XrdCmsBcast() : rdyFirst(0), rdyLast(0), rdyAvail(0), wrThreads(4),
+                      qMax(32), Active(false)
+                      {memset(&Stats, 0, sizeof(Stats));}
+     ~XrdCmsBcast() {}  // Never gets deleted
+
+private:
+
+void        Release(Msg *mP);
+
+XrdSysMutex      bcMutex;   // Protects the queues and everything below
+XrdCmsNode      *rdyFirst;
+XrdCmsNode      *rdyLast;
+XrdSysSemaphore  rdyAvail;
+Info             Stats;
+int              wrThreads;
+int              qMax;
+bool             Active;
+};
+
+namespace XrdCms
+{
+extern    XrdCmsBcast Bcast;
+}
+#endif
@@ -33,6 +33,7 @@
 
 #include "XrdCms/XrdCmsCache.hh"
 #include "XrdCms/XrdCmsRRQ.hh"
+#include "XrdCms/XrdCmsSnap.hh"
 #include "XrdCms/XrdCmsTrace.hh"
 
 #include "XrdSys/XrdSysTimer.hh"
@@ -61,15 +62,16 @@ class XrdCmsCacheJob : XrdJob
 {
 public:
 
-void   DoIt() {Cache.Recycle(myList); delete this;}
+void   DoIt() {Cache.Recycle(myShard, myList); delete this;}
 
-       XrdCmsCacheJob(XrdCmsKeyItem *List)
-                     : XrdJob("cache scrubber"), myList(List) {}
+       XrdCmsCacheJob(int sNum, XrdCmsKeyItem *List)
+                     : XrdJob("cache scrubber"), myList(List), myShard(sNum) {}
       ~XrdCmsCacheJob() {}
 
 private:
 
 XrdCmsKeyItem *myList;
+int            myShard;
 };
 
 /******************************************************************************/
@@ -119,15 +121,16 @@ int XrdCmsCache::AddFile(XrdCmsSelect &Sel, SMask_t mask)
    XrdCmsKeyItem *iP;
    SMask_t xmask;
    int isrw = (Sel.Opts & XrdCmsSelect::Write), isnew = 0;
+   Shard &sP = getShard(Sel.Path);
 
 // Serialize processing
 //
-   myMutex.Lock();
+   sP.Lock();
 
 // Check for fast path processing
 //
    if (  !(iP = Sel.Path.TODRef) || !(iP->Key.Equiv(Sel.Path)))
-      if ((iP = Sel.Path.TODRef = CTable.Find(Sel.Path)))
+      if ((iP = Sel.Path.TODRef = sP.CTable.Find(Sel.Path)))
          Sel.Path.Ref = iP->Key.Ref;
 
 // Add/Modify the entry
@@ -137,8 +140,8 @@ int XrdCmsCache::AddFile(XrdCmsSelect &Sel, SMask_t mask)
           {iP->Loc.deadline = QDelay + time(0);
            iP->Loc.lifeline = nilTMO + iP->Loc.deadline;
            iP->Loc.hfvec = 0; iP->Loc.pfvec = 0; iP->Loc.qfvec = 0;
-           iP->Loc.TOD_B = BClock;
-           iP->Key.TOD = Tock;
+           iP->Loc.TOD_B = sP.BClock;
+           iP->Key.TOD = sP.Tock;
           } else {
            xmask = iP->Loc.pfvec;
            if (Sel.Opts & XrdCmsSelect::Pending) iP->Loc.pfvec |= mask;
@@ -155,11 +158,11 @@ int XrdCmsCache::AddFile(XrdCmsSelect &Sel, SMask_t mask)
                      }
           }
       } else if (!(Sel.Opts & XrdCmsSelect::Advisory))
-                {Sel.Path.TOD = Tock;
-                 if ((iP = CTable.Add(Sel.Path)))
+                {Sel.Path.TOD = sP.Tock;
+                 if ((iP = sP.CTable.Add(Sel.Path)))
                     {iP->Loc.pfvec    = (Sel.Opts&XrdCmsSelect::Pending?mask:0);
                      iP->Loc.hfvec    = mask;
-                     iP->Loc.TOD_B    = BClock;
+                     iP->Loc.TOD_B    = sP.BClock;
                      iP->Loc.qfvec    = 0;
                      iP->Loc.deadline = QDelay + time(0);
                      iP->Loc.lifeline = nilTMO + iP->Loc.deadline;
@@ -170,7 +173,7 @@ int XrdCmsCache::AddFile(XrdCmsSelect &Sel, SMask_t mask)
 
 // All done
 //
-   myMutex.UnLock();
+   sP.UnLock();
    return isnew;
 }
   
@@ -192,27 +195,34 @@ int XrdCmsCache::DelFile(XrdCmsSelect &Sel, SMask_t mask)
 {
    XrdCmsKeyItem *iP;
    int gone4good;
+   Shard &sP = getShard(Sel.Path);
 
 // Lock the hash table
 //
-   myMutex.Lock();
+   sP.Lock();
+
+// The previous snapshot must not bring the location back on a later miss,
+// whether or not the entry is currently cached.
+//
+   if (Snap.isLoaded()) Snap.Kill(Sel.Path);
 
 // Look up the entry and remove server
 //
-   if ((iP = CTable.Find(Sel.Path)))
+   if ((iP = sP.CTable.Find(Sel.Path)))
       {iP->Loc.hfvec &= ~mask;
        iP->Loc.pfvec &= ~mask;
        if ((gone4good = (iP->Loc.hfvec == 0)))
           {if (nilTMO) iP->Loc.lifeline = nilTMO + time(0);
            if (!(Sel.Opts & XrdCmsSelect::Advisory)
-           &&  XrdCmsKeyItem::Unload(iP) && !CTable.Recycle(iP))
+           &&  XrdCmsKeyItem::Unload(sP.CTable.Items, iP)
+           &&  !sP.CTable.Recycle(iP))
               Say.Emsg("DelFile", "Delete failed for", iP->Key.Val);
           }
       } else gone4good = 0;
 
 // All done
 //
-   myMutex.UnLock();
+   sP.UnLock();
    return gone4good;
 }
   
@@ -234,16 +244,18 @@ int  XrdCmsCache::GetFile(XrdCmsSelect &Sel, SMask_t mask)
    XrdCmsKeyItem *iP;
    SMask_t bVec;
    int retc;
+   Shard &sP = getShard(Sel.Path);
 
 // Lock the hash table
 //
-   myMutex.Lock();
+   sP.Lock();
 
 // Look up the entry and return location information
 //
-   if ((iP = CTable.Find(Sel.Path)))
-      {if ((bVec = (iP->Loc.TOD_B < BClock 
-                 ? getBVec(iP->Key.TOD, iP->Loc.TOD_B) & mask : 0)))
+   if ((iP = sP.CTable.Find(Sel.Path)))
+      {sP.Hits++;
+       if ((bVec = (iP->Loc.TOD_B < sP.BClock
+                 ? getBVec(sP, iP->Key.TOD, iP->Loc.TOD_B) & mask : 0)))
           {iP->Loc.hfvec &= ~bVec; 
            iP->Loc.pfvec &= ~bVec;
            iP->Loc.qfvec &= ~mask;
@@ -258,15 +270,23 @@ int  XrdCmsCache::GetFile(XrdCmsSelect &Sel, SMask_t mask)
        if (nilTMO && retc == 1 && iP->Loc.hfvec == 0
        &&  iP->Loc.lifeline <= time(0)) retc = 0;
 
-       Sel.Vec.hf      = okVec & iP->Loc.hfvec;
-       Sel.Vec.pf      = okVec & iP->Loc.pfvec;
-       Sel.Vec.bf      = okVec & (bVec | iP->Loc.qfvec); iP->Loc.qfvec = 0;
+       Sel.Vec.hf      = sP.okVec & iP->Loc.hfvec;
+       Sel.Vec.pf      = sP.okVec & iP->Loc.pfvec;
+       Sel.Vec.bf      = sP.okVec & (bVec | iP->Loc.qfvec); iP->Loc.qfvec = 0;
        Sel.Path.Ref    = iP->Key.Ref;
-      } else retc = 0;
+      } else {sP.Miss++;
+              if (Snap.isLoaded() && (iP = Restore(sP, Sel.Path)))
+                 {Sel.Vec.hf   = sP.okVec & iP->Loc.hfvec;
+                  Sel.Vec.pf   = 0;
+                  Sel.Vec.bf   = 0;
+                  Sel.Path.Ref = iP->Key.Ref;
+                  retc = 1;
+                 } else retc = 0;
+             }
 
 // All done
 //
-   myMutex.UnLock();
+   sP.UnLock();
    Sel.Path.TODRef = iP;
    return retc;
 }
@@ -279,10 +299,11 @@ int XrdCmsCache::UnkFile(XrdCmsSelect &Sel, SMask_t mask)
 {
    EPNAME("UnkFile");
    XrdCmsKeyItem *iP;
+   Shard &sP = getShard(Sel.Path);
 
 // Make sure we have the proper information. If so, lock the hash table
 //
-   myMutex.Lock();
+   sP.Lock();
 
 // Look up the entry and if valid update the unqueried vector. Note that
 // this method may only be called after GetFile() or AddFile() for a new entry
@@ -294,7 +315,7 @@ int XrdCmsCache::UnkFile(XrdCmsSelect &Sel, SMask_t mask)
 
 // Return result
 //
-   myMutex.UnLock();
+   sP.UnLock();
    DEBUG("rc=" <<(iP ? 1 : 0) <<" path=" <<Sel.Path.Val);
    return (iP ? 1 : 0);
 }
@@ -313,7 +334,8 @@ int XrdCmsCache::WT4File(XrdCmsSelect &Sel, SMask_t mask)
 // Make sure we have the proper information. If so, lock the hash table
 //
    if (!Sel.InfoP) return DLTime;
-   myMutex.Lock();
+   Shard &sP = getShard(Sel.Path);
+   sP.Lock();
 
 // Look up the entry and if valid add it to the callback queue. Note that
 // this method may only be called after GetFile() or AddFile() for a new entry
@@ -328,7 +350,7 @@ int XrdCmsCache::WT4File(XrdCmsSelect &Sel, SMask_t mask)
 
 // Return result
 //
-   myMutex.UnLock();
+   sP.UnLock();
    DEBUG("rc=" <<retc <<" path=" <<Sel.Path.Val);
    return retc;
 }
@@ -343,13 +365,17 @@ int XrdCmsCache::WT4File(XrdCmsSelect &Sel, SMask_t mask)
 void XrdCmsCache::Bounce(SMask_t smask, int SNum)
 {
 
-// Simply indicate that this server bounced
-//
-   myMutex.Lock();
-   Bounced[SNum] = ++BClock;
-   okVec |= smask;
-   if (SNum > vecHi) vecHi = SNum;
-   myMutex.UnLock();
+// Simply indicate that this server bounced. Each shard keeps its own bounce
+// history so the update must be applied to all of them.
+//
+   for (int i = 0; i < numShards; i++)
+       {Shard &sP = Shards[i];
+        sP.Lock();
+        sP.Bounced[SNum] = ++sP.BClock;
+        sP.okVec |= smask;
+        if (SNum > sP.vecHi) sP.vecHi = SNum;
+        sP.UnLock();
+       }
 }
 
 /******************************************************************************/
@@ -364,13 +390,16 @@ void XrdCmsCache::Drop(SMask_t smask, int SNum, int xHi)
 //
    Paths.Remove(smask);
 
-// Remove the node from the list of valid nodes
+// Remove the node from the list of valid nodes in every shard
 //
-   myMutex.Lock();
-   Bounced[SNum] = 0;
-   okVec &= nmask;
-   vecHi = xHi;
-   myMutex.UnLock();
+   for (int i = 0; i < numShards; i++)
+       {Shard &sP = Shards[i];
+        sP.Lock();
+        sP.Bounced[SNum] = 0;
+        sP.okVec &= nmask;
+        sP.vecHi = xHi;
+        sP.UnLock();
+       }
 }
 
 /******************************************************************************/
@@ -409,17 +438,76 @@ int XrdCmsCache::Init(int fxHold, int fxDelay, int fxQuery, int seFS, int nxHold
        return 0;
       }
 
-// Get the first reserve of cache items
+// Get the first reserve of cache items for each shard
 //
-   iP = XrdCmsKeyItem::Alloc(0);
-   XrdCmsKeyItem::Unload((unsigned int)0);
-   iP->Recycle();
+   for (int i = 0; i < numShards; i++)
+       {XrdCmsKeyItem::Pool &Items = Shards[i].CTable.Items;
+        Shards[i].Lock();
+        iP = XrdCmsKeyItem::Alloc(Items, 0);
+        XrdCmsKeyItem::Unload(Items, (unsigned int)0);
+        iP->Recycle(Items);
+        Shards[i].UnLock();
+       }
 
 // All done
 //
    return 1;
 }
 
+/******************************************************************************/
+/* public                       S n a p s h o t                               */
+/******************************************************************************/
+
+void XrdCmsCache::Snapshot(XrdCmsSnap &snap)
+{
+   XrdCmsKeyItem *iP;
+   SMask_t hVec;
+   time_t Now = time(0);
+   unsigned int Age, todB;
+
+// Pass along every entry whose locations are known. The time a location was
+// learned is approximated by the entry's window so that, upon reload, the
+// entry expires when it would have had we not restarted. Servers that have
+// since been bounced, as well as pending and staging locations, are omitted.
+//
+   for (int i = 0; i < numShards; i++)
+       {Shard &sP = Shards[i];
+        sP.Lock();
+        for (unsigned int t = 0; t < XrdCmsKeyItem::TickRate; t++)
+            {Age = (sP.Tock - t) & XrdCmsKeyItem::TickMask;
+             for (iP = sP.CTable.Items.TockTable[t]; iP; iP = iP->Key.TODRef)
+                 {if (!iP->Key.Hash || iP->Loc.deadline) continue;
+                  hVec = sP.okVec & iP->Loc.hfvec & ~iP->Loc.pfvec;
+                  if (hVec && iP->Loc.TOD_B < sP.BClock)
+                     {todB = iP->Loc.TOD_B;
+                      hVec &= ~getBVec(sP, iP->Key.TOD, todB);
+                     }
+                  if (hVec) snap.Add(iP->Key, Now - Age*Tick, hVec);
+                 }
+            }
+        sP.UnLock();
+       }
+}
+
+/******************************************************************************/
+/* public                     S t a t i s t i c s                             */
+/******************************************************************************/
+
+void XrdCmsCache::Statistics(ShardStats sVec[numShards])
+{
+
+// Return a snapshot of each shard's counters
+//
+   for (int i = 0; i < numShards; i++)
+       {Shard &sP = Shards[i];
+        sP.myMutex.Lock();
+        sVec[i].Hits = sP.Hits;
+        sVec[i].Miss = sP.Miss;
+        sVec[i].Cont = sP.Cont;
+        sP.myMutex.UnLock();
+       }
+}
+
 /******************************************************************************/
 /* public                       T i c k T o c k                               */
 /******************************************************************************/
@@ -428,15 +516,18 @@ void *XrdCmsCache::TickTock()
 {
    XrdCmsKeyItem *iP;
 
-// Simply adjust the clock and trim old entries
+// Simply adjust the clock and trim old entries in each shard
 //
    do {XrdSysTimer::Snooze(Tick);
-       myMutex.Lock();
-       Tock = (Tock+1) & XrdCmsKeyItem::TickMask;
-       Bhistory[Tock].Start = Bhistory[Tock].End = 0;
-       iP = XrdCmsKeyItem::Unload(Tock);
-       myMutex.UnLock();
-       if (iP) Sched->Schedule((XrdJob *)new XrdCmsCacheJob(iP));
+       for (int i = 0; i < numShards; i++)
+           {Shard &sP = Shards[i];
+            sP.Lock();
+            sP.Tock = (sP.Tock+1) & XrdCmsKeyItem::TickMask;
+            sP.Bhistory[sP.Tock].Start = sP.Bhistory[sP.Tock].End = 0;
+            iP = XrdCmsKeyItem::Unload(sP.CTable.Items, sP.Tock);
+            sP.UnLock();
+            if (iP) Sched->Schedule((XrdJob *)new XrdCmsCacheJob(i, iP));
+           }
       } while(1);
 
 // Keep compiler happy
@@ -502,7 +593,7 @@ void XrdCmsCache::Dispatch(XrdCmsSelect &Sel, XrdCmsKeyItem *iP,
 /*                               g e t B V e c                                */
 /******************************************************************************/
   
-SMask_t XrdCmsCache::getBVec(unsigned int TODa, unsigned int &TODb)
+SMask_t XrdCmsCache::getBVec(Shard &sP, unsigned int TODa, unsigned int &TODb)
 {
    EPNAME("getBVec");
    SMask_t BVec(0);
@@ -510,20 +601,20 @@ SMask_t XrdCmsCache::getBVec(unsigned int TODa, unsigned int &TODb)
 
 // See if we can use a previously calculated bVec
 //
-   if (Bhistory[TODa].End == BClock && Bhistory[TODa].Start <= TODb)
-      {Bhits++; TODb = BClock; return Bhistory[TODa].Vec;}
+   if (sP.Bhistory[TODa].End == sP.BClock && sP.Bhistory[TODa].Start <= TODb)
+      {sP.Bhits++; TODb = sP.BClock; return sP.Bhistory[TODa].Vec;}
 
 // Calculate the new vector
 //
-   for (i = 0; i <= vecHi; i++)
-       if (TODb < Bounced[i]) BVec |= 1ULL << i;
+   for (i = 0; i <= sP.vecHi; i++)
+       if (TODb < sP.Bounced[i]) BVec.Set(i);
 
-   Bhistory[TODa].Vec   = BVec;
-   Bhistory[TODa].Start = TODb;
-   Bhistory[TODa].End   = BClock;
-   TODb                 = BClock;
-   Bmiss++;
-   if (!(Bmiss & 0xff)) DEBUG("hits=" <<Bhits <<" miss=" <<Bmiss);
+   sP.Bhistory[TODa].Vec   = BVec;
+   sP.Bhistory[TODa].Start = TODb;
+   sP.Bhistory[TODa].End   = sP.BClock;
+   TODb                    = sP.BClock;
+   sP.Bmiss++;
+   if (!(sP.Bmiss & 0xff)) DEBUG("hits=" <<sP.Bhits <<" miss=" <<sP.Bmiss);
    return BVec;
 }
 
@@ -531,10 +622,11 @@ SMask_t XrdCmsCache::getBVec(unsigned int TODa, unsigned int &TODb)
 /*                               R e c y c l e                                */
 /******************************************************************************/
   
-void XrdCmsCache::Recycle(XrdCmsKeyItem *theList)
+void XrdCmsCache::Recycle(int sNum, XrdCmsKeyItem *theList)
 {
+   Shard &sP = Shards[sNum];
    XrdCmsKeyItem *iP;
-   char msgBuff[100];
+   char msgBuff[120];
    int numNull, numHave, numFree, numRecycled = 0;
 
 // Recycle the list of cache items, as needed
@@ -543,28 +635,62 @@ void XrdCmsCache::Recycle(XrdCmsKeyItem *theList)
         {theList = iP->Key.TODRef;
          if (iP->Loc.roPend) RRQ.Del(iP->Loc.roPend, iP);
          if (iP->Loc.rwPend) RRQ.Del(iP->Loc.rwPend, iP);
-         myMutex.Lock(); CTable.Recycle(iP); myMutex.UnLock();
+         sP.Lock(); sP.CTable.Recycle(iP); sP.UnLock();
          numRecycled++;
         }
 
 // See if we have enough items in reserve
 //
-   myMutex.Lock();
-   XrdCmsKeyItem::Stats(numHave, numFree, numNull);
+   sP.Lock();
+   XrdCmsKeyItem::Stats(sP.CTable.Items, numHave, numFree, numNull);
    if (numFree < XrdCmsKeyItem::minFree)
-      {myMutex.UnLock();
+      {sP.UnLock();
        if (!(numNull /= 4)) numNull = 1;
        numHave += XrdCmsKeyItem::minAlloc * numNull;
        while(numNull--)
-            {myMutex.Lock();
-             numFree = XrdCmsKeyItem::Replenish();
-             myMutex.UnLock();
+            {sP.Lock();
+             numFree = XrdCmsKeyItem::Replenish(sP.CTable.Items);
+             sP.UnLock();
             }
-      } else myMutex.UnLock();
+      } else sP.UnLock();
 
 // Log the stats
 //
-   sprintf(msgBuff, "%d cache items; %d allocated %d free",
-           numRecycled, numHave, numFree);
+   sprintf(msgBuff, "%d cache items in shard %d; %d allocated %d free",
+           numRecycled, sNum, numHave, numFree);
    Say.Emsg("Recycle", msgBuff);
 }
+
+/******************************************************************************/
+/*                               R e s t o r e                                */
+/******************************************************************************/
+
+// Called with the shard locked when a path is not in the cache. If the
+// previous snapshot knows where the path is, the entry is added back in the
+// window it would have been in had we not restarted.
+
+XrdCmsKeyItem *XrdCmsCache::Restore(Shard &sP, XrdCmsKey &Key)
+{
+   XrdCmsKeyItem *iP;
+   SMask_t hVec;
+   time_t Born, Now = time(0);
+   unsigned int Age;
+
+// Look up the path in the snapshot
+//
+   if (!Snap.Find(Key, hVec, Born)) return 0;
+   Age = (Now > Born ? static_cast<unsigned int>(Now - Born)/Tick : 0);
+   if (Age >= XrdCmsKeyItem::TickRate) return 0;
+
+// Add the entry with a completed lookup
+//
+   Key.TOD = (sP.Tock - Age) & XrdCmsKeyItem::TickMask;
+   if (!(iP = sP.CTable.Add(Key))) return 0;
+   iP->Loc.hfvec    = hVec;
+   iP->Loc.pfvec    = 0;
+   iP->Loc.qfvec    = 0;
+   iP->Loc.TOD_B    = sP.BClock;
+   iP->Loc.deadline = 0;
+   iP->Loc.lifeline = nilTMO + Now;
+   return iP;
+}
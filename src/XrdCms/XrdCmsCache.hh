@@ -40,6 +40,8 @@
 #include "XrdSys/XrdSysPthread.hh"
 #include "XrdCms/XrdCmsSelect.hh"
 #include "XrdCms/XrdCmsTypes.hh"
+
+class XrdCmsSnap;
   
 class XrdCmsCache
 {
@@ -76,27 +78,39 @@ void        Drop(SMask_t mask, int SNum, int xHi);
 
 int         Init(int fxHold, int fxDelay, int fxQuery, int seFS, int nxHold);
 
+// Snapshot() passes every entry with known locations to the snapshot object
+//            (see XrdCmsSnap). On a miss, GetFile() consults the previous
+//            snapshot, if any, before reporting the entry as not found.
+//
+void        Snapshot(XrdCmsSnap &snap);
+
 void       *TickTock();
 
+// The cache is split into shards by path hash, each with its own lock, so
+// that lookups for different paths rarely contend. Statistics() returns the
+// per-shard lookup hits and misses and how often a shard's lock was busy.
+//
+static const int numShards  = 16;
+static const int shardShift = 28;   // Hash >> shardShift selects the shard
+
+struct ShardStats
+      {long long Hits;
+       long long Miss;
+       long long Cont;
+      };
+
+void        Statistics(ShardStats sVec[numShards]);
+
 static const int min_nxTime = 60;
 
-            XrdCmsCache() : okVec(0), Tick(8*60*60), Tock(0), BClock(0), 
-                            nilTMO(0),
-                            DLTime(5), QDelay(5), Bhits(0), Bmiss(0), vecHi(-1),
-                            isDFS(0)
-                          {memset(Bounced,  0, sizeof(Bounced));
-                           memset(Bhistory, 0, sizeof(Bhistory));
-                          }
+            XrdCmsCache() : Tick(8*60*60), nilTMO(0),
+                            DLTime(5), QDelay(5), isDFS(0) {}
            ~XrdCmsCache() {}   // Never gets deleted
 
 private:
 
-void          Add2Q(XrdCmsRRQInfo *Info, XrdCmsKeyItem *cp, int selOpts);
-void          Dispatch(XrdCmsSelect &Sel, XrdCmsKeyItem *cinfo,
-                       short roQ, short rwQ);
-SMask_t       getBVec(unsigned int todA, unsigned int &todB);
-void          Recycle(XrdCmsKeyItem *theList);
-
+struct Shard
+{
 struct  {SMask_t      Vec;
          unsigned int Start;
          unsigned int End;
@@ -106,15 +120,45 @@ XrdSysMutex   myMutex;
 XrdCmsNash    CTable;
 unsigned int  Bounced[STMax];
 SMask_t       okVec;
-unsigned int  Tick;
 unsigned int  Tock;
 unsigned int  BClock;
-         int  nilTMO;
-         int  DLTime;
-         int  QDelay;
          int  Bhits;
          int  Bmiss;
          int  vecHi;
+long long     Hits;
+long long     Miss;
+long long     Cont;
+
+inline void   Lock() {if (!myMutex.CondLock()) {myMutex.Lock(); Cont++;}}
+
+inline void   UnLock() {myMutex.UnLock();}
+
+              Shard() : CTable(1597, 2584), okVec(0), Tock(0), BClock(0),
+                        Bhits(0), Bmiss(0), vecHi(-1), Hits(0), Miss(0),
+                        Cont(0)
+                      {memset(Bounced,  0, sizeof(Bounced));
+                       for (unsigned int i = 0; i < XrdCmsKeyItem::TickRate; i++)
+                           Bhistory[i].Start = Bhistory[i].End = 0;
+                      }
+             ~Shard() {}
+};
+
+void          Add2Q(XrdCmsRRQInfo *Info, XrdCmsKeyItem *cp, int selOpts);
+void          Dispatch(XrdCmsSelect &Sel, XrdCmsKeyItem *cinfo,
+                       short roQ, short rwQ);
+SMask_t       getBVec(Shard &sP, unsigned int todA, unsigned int &todB);
+inline Shard &getShard(XrdCmsKey &Key)
+                      {if (!Key.Hash) Key.setHash();
+                       return Shards[Key.Hash >> shardShift];
+                      }
+void          Recycle(int sNum, XrdCmsKeyItem *theList);
+XrdCmsKeyItem *Restore(Shard &sP, XrdCmsKey &Key);
+
+Shard         Shards[numShards];
+unsigned int  Tick;
+         int  nilTMO;
+         int  DLTime;
+         int  QDelay;
          int  isDFS;
 };
 
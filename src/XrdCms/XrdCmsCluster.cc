@@ -29,6 +29,7 @@
 /******************************************************************************/
 
 #include <cerrno>
+#include <cmath>
 #include <fcntl.h>
 #include <cstdio>
 #include <cstdlib>
@@ -43,19 +44,24 @@
 #include "Xrd/XrdScheduler.hh"
 
 #include "XrdCms/XrdCmsBaseFS.hh"
+#include "XrdCms/XrdCmsBcast.hh"
 #include "XrdCms/XrdCmsBlackList.hh"
 #include "XrdCms/XrdCmsCache.hh"
 #include "XrdCms/XrdCmsConfig.hh"
 #include "XrdCms/XrdCmsCluster.hh"
 #include "XrdCms/XrdCmsClustID.hh"
 #include "XrdCms/XrdCmsNode.hh"
+#include "XrdCms/XrdCmsNSum.hh"
 #include "XrdCms/XrdCmsRole.hh"
 #include "XrdCms/XrdCmsRRQ.hh"
 #include "XrdCms/XrdCmsState.hh"
 #include "XrdCms/XrdCmsSelect.hh"
+#include "XrdCms/XrdCmsSnap.hh"
+#include "XrdCms/XrdCmsStateQ.hh"
 #include "XrdCms/XrdCmsTrace.hh"
 #include "XrdCms/XrdCmsTypes.hh"
 
+#include "XrdOuc/XrdOucCRC.hh"
 #include "XrdOuc/XrdOucPup.hh"
 
 #include "XrdSys/XrdSysPlatform.hh"
@@ -101,6 +107,25 @@ int         nodeEnt;
 int         nodeInst;
 };
   
+/******************************************************************************/
+/*                       L o c a l   F u n c t i o n s                        */
+/******************************************************************************/
+
+namespace
+{
+// A cheap per-thread generator is all that random node choice needs.
+//
+int Pick(int n)
+{
+   static thread_local unsigned int rSeed = 0;
+
+   if (!rSeed) rSeed = static_cast<unsigned int>(XrdCmsNode::Microsec()
+                     ^ reinterpret_cast<size_t>(&rSeed)) | 1;
+   rSeed ^= rSeed << 13; rSeed ^= rSeed >> 17; rSeed ^= rSeed << 5;
+   return static_cast<int>(rSeed % static_cast<unsigned int>(n));
+}
+}
+  
 /******************************************************************************/
 /*                           C o n s t r u c t o r                            */
 /******************************************************************************/
@@ -249,6 +274,10 @@ XrdCmsNode *XrdCmsCluster::Add(XrdLink *lp, int port, int Status, int sport,
       else         peerHost &= ~nP->NodeMask;
    peerMask = ~peerHost;
 
+// Let the cache snapshot know which node now occupies this slot
+//
+   if (!Hidden) Snap.Attach(Slot, nP->myNID);
+
 // Document login
 //
    if (QTRACE(Debug))
@@ -349,7 +378,7 @@ void XrdCmsCluster::BlackList(XrdOucTList *blP)
             if (inBL)
                {nP->isBad |= XrdCmsNode::isBlisted | XrdCmsNode::isDoomed;
                 if (blRD < -1)
-                  {if (kYR_Version > nP->myVersion)
+                  {if (kYR_VerBLR > nP->myVersion)
                             etxt = "blacklisted; redirect unsupported.";
                       else  etxt = "blacklisted with redirect.";
                    nP->isBad |= XrdCmsNode::isDoomed;
@@ -383,6 +412,37 @@ SMask_t XrdCmsCluster::Broadcast(SMask_t smask, const struct iovec *iod,
    STMutex.ReadLock(); // Sufficient to prevent modifications
    bmask = smask & peerMask;
 
+// If the message goes to more than one node hand it to the broadcast writer
+// so that we need not wait for each node in turn. A message for a single node
+// also goes to the writer if that node still has messages queued as it must
+// not overtake them. The lock keeps the node pointers valid until the writer
+// has taken its own references.
+//
+   if (Bcast.isActive())
+      {XrdCmsNode *nVec[STMax];
+       int n = 0;
+       for (i = 0; i <= STHi; i++)
+           {if ((nP = NodeTab[i]) && nP->isNode(bmask))
+               {if (nP->isOffline) unQueried |= nP->Mask();
+                   else nVec[n++] = nP;
+               }
+           }
+       if (n > 1 || (n && Bcast.Pending(nVec[0])))
+          unQueried |= Bcast.Send(nVec, n, iod, iovcnt, iotot);
+          else if (n) {nP = nVec[0];
+                       nP->Ref();
+                       STMutex.UnLock();
+                       if (nP->Send(iod, iovcnt, iotot) < 0)
+                          {unQueried |= nP->Mask();
+                           DEBUG(nP->Ident <<" is unreachable");
+                          }
+                       nP->unRef();
+                       return unQueried;
+                      }
+       STMutex.UnLock();
+       return unQueried;
+      }
+
 // Run through the table looking for nodes to send messages to. We don't need
 // the node lock for this but we do need to up the reference count to keep the
 // node pointer valid for the duration of the send() (may or may not block).
@@ -650,12 +710,15 @@ int XrdCmsCluster::Locate(XrdCmsSelect &Sel)
 // First check if we have seen this file before. If so, get nodes that have it.
 // A Refresh request kills this because it's as if we hadn't seen it before.
 // If the file was found but either a query is in progress or we have a server
-// bounce; the client must wait.
+// bounce; the client must wait. Otherwise, the namespace summaries may prune
+// the nodes we query but never decide that the file does not exist.
 //
    if (Sel.Opts & XrdCmsSelect::Refresh 
    || !(retc = Cache.GetFile(Sel, pinfo.rovec)))
       {Cache.AddFile(Sel, 0);
        qfVec = pinfo.rovec; Sel.Vec.hf = 0;
+       if (!(Sel.Opts & XrdCmsSelect::Refresh))
+          qfVec = NSum.Match(Sel.Path.Val, Sel.Path.Len, qfVec, pinfo.ssvec);
       } else qfVec = Sel.Vec.bf;
 
 // Compute the delay, if any
@@ -670,8 +733,7 @@ int XrdCmsCluster::Locate(XrdCmsSelect &Sel)
        if (Sel.Opts & XrdCmsSelect::Refresh)
           QReq.Hdr.modifier |= CmsStateRequest::kYR_refresh;
        TRACE(Files, "seeking " <<Sel.Path.Val);
-       qfVec = Cluster.Broadcast(qfVec, QReq.Hdr, 
-                                 (void *)Sel.Path.Val, Sel.Path.Len+1);
+       qfVec = Cluster.Query(qfVec, QReq.Hdr, Sel);
        if (qfVec) Cache.UnkFile(Sel, qfVec);
       }
    return retc;
@@ -687,7 +749,7 @@ void *XrdCmsCluster::MonPerf()
    struct iovec ioV[] = {{(char *)&Usage, sizeof(Usage)}};
    int ioVnum = sizeof(ioV)/sizeof(struct iovec);
    int ioVtot = sizeof(Usage);
-   SMask_t allNodes(~0);
+   SMask_t allNodes(FULLMASK);
    int uInterval = Config.AskPing*Config.AskPerf;
 
 // Sleep for the indicated amount of time, then ask for load on each server
@@ -744,6 +806,46 @@ void *XrdCmsCluster::MonRefs()
    return (void *)0;
 }
 
+/******************************************************************************/
+/*                                 Q u e r y                                  */
+/******************************************************************************/
+
+// Ask nodes whether they have a file. When batching is enabled, queries to data
+// servers are queued (see XrdCmsStateQ) while refresh queries and those to
+// subordinate managers, which may need to forward them, are sent right away.
+// The nodes that could not be asked are returned.
+
+SMask_t XrdCmsCluster::Query(SMask_t qmask, XrdCms::CmsRRHdr &Hdr,
+                             XrdCmsSelect &Sel)
+{
+   XrdCmsNode *nP;
+   SMask_t bmask(0), unQueried(0);
+
+// Check if we should send the query right away
+//
+   if (Config.QBatch <= 0 || (Hdr.modifier & CmsStateRequest::kYR_refresh))
+      return Broadcast(qmask, Hdr, (void *)Sel.Path.Val, Sel.Path.Len+1);
+
+// Sort out the nodes that can take a batched query. Older data servers do not
+// know about batches and are sent the query for the path alone.
+//
+   STMutex.ReadLock();
+   qmask &= peerMask;
+   for (int i = qmask.First(); i >= 0 && i <= STHi; i = qmask.First(i+1))
+       if ((nP = NodeTab[i]) && !nP->isMan && nP->myVersion >= kYR_VerBSQ)
+          {if (nP->isOffline) unQueried.Set(i);
+              else bmask.Set(i);
+          }
+   STMutex.UnLock();
+
+// Queue what we can and send the rest
+//
+   if (bmask) StateQ.Add(bmask, Sel.Path.Val, Sel.Path.Len);
+   if ((qmask &= ~(bmask | unQueried)))
+      unQueried |= Broadcast(qmask, Hdr, (void *)Sel.Path.Val, Sel.Path.Len+1);
+   return unQueried;
+}
+
 /******************************************************************************/
 /*                                R e m o v e                                 */
 /******************************************************************************/
@@ -933,7 +1035,8 @@ int XrdCmsCluster::Select(XrdCmsSelect &Sel)
    XrdCmsPInfo  pinfo;
    const char  *Amode;
    int dowt = 0, retc = 0, isRW, fRD, noSel = (Sel.Opts & XrdCmsSelect::Defer);
-   SMask_t amask, smask, pmask;
+   SMask_t amask, smask, pmask, hmask(0);
+   bool isNew;
 
 // Establish some local options
 //
@@ -945,6 +1048,7 @@ int XrdCmsCluster::Select(XrdCmsSelect &Sel)
           else fRD = 1;
       }
       else {isRW = 0; Amode = "read"; fRD = 1;}
+   isNew = isRW && (Sel.Opts & (XrdCmsSelect::Trunc | XrdCmsSelect::NewFile));
 
 // Find out who serves this path
 //
@@ -990,8 +1094,10 @@ int XrdCmsCluster::Select(XrdCmsSelect &Sel)
 // meta-operation (e.g., remove) in which case the file itself remain unmodified
 // or a replica request, in which case we select a new target server.
 //
-   if (!(Sel.Opts & XrdCmsSelect::Refresh)
-   &&   (retc = Cache.GetFile(Sel, pinfo.rovec)))
+   if (!(Sel.Opts & XrdCmsSelect::Refresh))
+      retc = Cache.GetFile(Sel, pinfo.rovec);
+
+   if (retc)
       {if (isRW)
           {     if (retc<0) return Config.LUPDelay;
               else if (Sel.Opts & XrdCmsSelect::Replica)
@@ -1020,9 +1126,19 @@ int XrdCmsCluster::Select(XrdCmsSelect &Sel)
            else smask = (retc < 0 ? 0 : pinfo.ssvec & amask);
           }
        if (Sel.Vec.hf & Sel.nmask) Cache.UnkFile(Sel, Sel.nmask);
+      } else if (Config.HashList && !Sel.nmask
+             &&  !(Sel.Opts & (XrdCmsSelect::Refresh | XrdCmsSelect::Replica))
+             &&  (hmask = HashPlace(Sel, (isNew ? pinfo.rwvec : pinfo.rovec)
+                                         & amask, isNew)) && isNew)
+      {if (noSel) return 0;
+       Cache.AddFile(Sel, hmask);
+       TRACE(Redirect, "hashed " <<Sel.Path.Val);
+       return SelNode(Sel, hmask, 0);
       } else {
        Cache.AddFile(Sel, 0); 
-       Sel.Vec.bf = pinfo.rovec; 
+       if (Sel.Opts & XrdCmsSelect::Refresh) Sel.Vec.bf = pinfo.rovec;
+          else Sel.Vec.bf = NSum.Match(Sel.Path.Val, Sel.Path.Len,
+                                       pinfo.rovec, pinfo.ssvec);
        Sel.Vec.hf = Sel.Vec.pf = pmask = smask = 0;
        retc = 0;
       }
@@ -1040,8 +1156,10 @@ int XrdCmsCluster::Select(XrdCmsSelect &Sel)
           QReq.Hdr.modifier |= CmsStateRequest::kYR_refresh;
        if (dowt) retc= (fRD ? Cache.WT4File(Sel,Sel.Vec.hf) : Config.LUPDelay);
        TRACE(Files, "seeking " <<Sel.Path.Val);
-       amask = Cluster.Broadcast(Sel.Vec.bf, QReq.Hdr,
-                                 (void *)Sel.Path.Val,Sel.Path.Len+1);
+       if ((hmask &= Sel.Vec.bf) && (Sel.Vec.bf & ~hmask))
+          {amask  = Cluster.Query(hmask, QReq.Hdr, Sel);
+           amask |= Cluster.Query(Sel.Vec.bf & ~hmask, QReq.Hdr, Sel);
+          } else amask = Cluster.Query(Sel.Vec.bf, QReq.Hdr, Sel);
        if (amask) Cache.UnkFile(Sel, amask);
        if (dowt) return retc;
       } else if (dowt && retc < 0 && !noSel)
@@ -1085,11 +1203,9 @@ int XrdCmsCluster::Select(XrdCmsSelect &Sel)
 int XrdCmsCluster::Select(SMask_t pmask, int &port, char *hbuff, int &hlen,
                           int isrw, int isMulti, int ifWant)
 {
-   static const SMask_t smLow(255);
    XrdCmsSelector selR;
    XrdCmsNode *nP = 0;
-   SMask_t tmask;
-   int Snum = 0;
+   int Snum;
    XrdNetIF::ifType nType = static_cast<XrdNetIF::ifType>(ifWant);
 
 // If there is nothing to select from, return failure
@@ -1115,7 +1231,9 @@ int XrdCmsCluster::Select(SMask_t pmask, int &port, char *hbuff, int &hlen,
 //
    if (isMulti || baseFS.isDFS())
       {STMutex.ReadLock();
-       nP = (Config.sched_RR ? SelbyRef(pmask,selR) : SelbyLoad(pmask,selR));
+            if (Config.sched_Lat) nP = SelbyLat(pmask, selR);
+       else if (Config.sched_RR)  nP = SelbyRef(pmask, selR);
+       else                       nP = SelbyLoad(pmask, selR);
        if (nP) hlen = nP->netIF.GetName(hbuff, port, nType) + 1;
           else hlen = 0;
        STMutex.UnLock();
@@ -1125,9 +1243,7 @@ int XrdCmsCluster::Select(SMask_t pmask, int &port, char *hbuff, int &hlen,
 // In shared-nothing systems the incoming mask will only have a single node.
 // Compute the a single node number that is contained in the mask.
 //
-   do {if (!(tmask = pmask & smLow)) Snum += 8;
-         else {while((tmask = tmask>>1)) Snum++; break;}
-      } while((pmask = pmask >> 8));
+   Snum = pmask.First();
 
 // See if the node passes muster
 //
@@ -1284,12 +1400,23 @@ int XrdCmsCluster::Statt(char *bfr, int bln)
    static const char statfmt5[] =
           "<frq><add>%lld<d>%lld</d></add><rsp>%lld<m>%lld</m></rsp>"
           "<lf>%lld</lf><ls>%lld</ls><rf>%lld</rf><rs>%lld</rs></frq>";
-
+   static const char statfmt6[] = "<csh>";
+   static const char statfmt7[] =
+          "<s id=\"%d\"><h>%lld</h><m>%lld</m><c>%lld</c></s>";
+   static const char statfmt8[] = "</csh>";
+   static const char statfmt9[] = "<bcs><n>%lld</n><w>%lld</w><s>%lld</s>"
+          "<t>%lld</t><m>%lld</m></bcs>";
+
+   static int AddCsh = (Config.RepStats & XrdCmsConfig::RepStat_csh);
    static int AddFrq = (Config.RepStats & XrdCmsConfig::RepStat_frq);
+   static int AddBcs = (Config.RepStats & XrdCmsConfig::RepStat_bcs)
+                       && Bcast.isActive();
    static int AddShr = (Config.RepStats & XrdCmsConfig::RepStat_shr)
                        && Config.asMetaMan();
 
    XrdCmsRRQ::Info Frq;
+   XrdCmsCache::ShardStats Csh[XrdCmsCache::numShards];
+   XrdCmsBcast::Info Bcs;
    XrdCmsSelected *sp;
    int mlen, tlen, n = 0;
    char shrBuff[80], stat[6], *stp;
@@ -1312,12 +1439,17 @@ int XrdCmsCluster::Statt(char *bfr, int bln)
           (sizeof(statfmt2) + 10*2 + 256 + 16) * STMax + sizeof(statfmt4);
        if (AddShr) n += sizeof(statfmt3) + 12;
        if (AddFrq) n += sizeof(statfmt4) + (10*8);
+       if (AddCsh) n += sizeof(statfmt6) + sizeof(statfmt8)
+                     + (sizeof(statfmt7) + 3 + 20*3) * XrdCmsCache::numShards;
+       if (AddBcs) n += sizeof(statfmt9) + 20*5;
        return n;
       }
 
 // Get the statistics
 //
    if (AddFrq) RRQ.Statistics(Frq);
+   if (AddCsh) Cache.Statistics(Csh);
+   if (AddBcs) Bcast.Statistics(Bcs);
    mngrsp.sp = sp = List(FULLMASK, LS_NULL, oksel);
 
 // Count number of nodes we have
@@ -1362,6 +1494,25 @@ int XrdCmsCluster::Statt(char *bfr, int bln)
        bfr += mlen; bln -= mlen; tlen += mlen;
       }
 
+   if (AddCsh && bln > (int)sizeof(statfmt6))
+      {strcpy(bfr, statfmt6); mlen = sizeof(statfmt6) - 1;
+       bfr += mlen; bln -= mlen; tlen += mlen;
+       for (int i = 0; i < XrdCmsCache::numShards && bln > 0; i++)
+           {mlen = snprintf(bfr, bln, statfmt7, i,
+                            Csh[i].Hits, Csh[i].Miss, Csh[i].Cont);
+            bfr += mlen; bln -= mlen; tlen += mlen;
+           }
+       if (bln <= (int)sizeof(statfmt8)) return 0;
+       strcpy(bfr, statfmt8); mlen = sizeof(statfmt8) - 1;
+       bfr += mlen; bln -= mlen; tlen += mlen;
+      }
+
+   if (AddBcs && bln > 0)
+      {mlen = snprintf(bfr, bln, statfmt9, Bcs.Bcast, Bcs.Wrote, Bcs.Skips,
+                       (Bcs.Bcast ? Bcs.tTot/Bcs.Bcast : 0LL), Bcs.tMax);
+       bfr += mlen; bln -= mlen; tlen += mlen;
+      }
+
 // See if we overflowed. otherwise finish up
 //
    if (sp || bln < (int)sizeof(statfmt0)) return 0;
@@ -1474,6 +1625,9 @@ int XrdCmsCluster::Drop(int sent, int sinst, XrdCmsDrop *djp)
 // Invalidate any cached entries for this node
 //
    if (nP->NodeMask) Cache.Drop(nP->NodeMask, sent, STHi);
+   NSum.Drop(sent);
+   Snap.Detach(sent);
+   StateQ.Drop(sent);
 
 // We can now delete the node object if we were called via a job as we are on
 // a different thread. Direct calls require that we schedule the deletion as
@@ -1488,36 +1642,60 @@ int XrdCmsCluster::Drop(int sent, int sinst, XrdCmsDrop *djp)
    return 0;
 }
 
+/******************************************************************************/
+/*                             H a s h P l a c e                              */
+/******************************************************************************/
+
+// Paths listed by the hashplace directive are placed on the node they hash to.
+// Each node is ranked by a hash of the path and the node's name and port,
+// weighted by its disk capacity (rendezvous hashing), so that adding or
+// removing a node only moves the paths that hash to that node. New files go to
+// the best node with enough free space. Since a file may not be where it hashes
+// to (e.g. that node was full), other files are still looked for by querying;
+// the best node is merely queried first.
+
+SMask_t XrdCmsCluster::HashPlace(XrdCmsSelect &Sel, SMask_t mask, bool isNew)
+{
+   XrdOucTList *tP = Config.HashList;
+   XrdCmsNode  *nP;
+   SMask_t      hMask(0);
+   unsigned long long x;
+   double bestScore = 0.0, u, w;
+   unsigned int nKey;
+
+// Check if this path is placed by hashing
+//
+   while(tP && strncmp(Sel.Path.Val, tP->text, tP->val)) tP = tP->next;
+   if (!tP || !mask) return hMask;
+
+// Rank the nodes and pick the best one that can be used
+//
+   STMutex.ReadLock();
+   for (int i = mask.First(); i >= 0 && i <= STHi; i = mask.First(i+1))
+       {if (!(nP = NodeTab[i]) || nP->isOffline || nP->isBad) continue;
+        if (isNew && nP->DiskFree < nP->DiskMinF) continue;
+        nKey = XrdOucCRC::CRC32((const unsigned char *)nP->Name(),
+                                strlen(nP->Name()))
+             ^ (static_cast<unsigned int>(nP->netIF.Port()) * 0x9e3779b1U);
+        x  = (static_cast<unsigned long long>(Sel.Path.Hash) << 32) | nKey;
+        x  = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x  = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        x ^= (x >> 31);
+        u  = (static_cast<double>(x >> 11) + 0.5) / 9007199254740992.0;
+        w  = (nP->DiskTotal ? static_cast<double>(nP->DiskTotal) : 1.0);
+        if ((w = w / -log(u)) > bestScore) {bestScore = w; hMask = nP->Mask();}
+       }
+   STMutex.UnLock();
+   return hMask;
+}
+
 /******************************************************************************/
 /*                              M u l t i p l e                               */
 /******************************************************************************/
 
 int XrdCmsCluster::Multiple(SMask_t mVec)
 {
-   static const unsigned long long Left32  = 0xffffffff00000000LL;
-   static const unsigned long long Right32 = 0x00000000ffffffffLL;
-   static const unsigned long long Left16  = 0x00000000ffff0000LL;
-   static const unsigned long long Right16 = 0x000000000000ffffLL;
-   static const unsigned long long Left08  = 0x000000000000ff00LL;
-   static const unsigned long long Right08 = 0x00000000000000ffLL;
-   static const unsigned long long Left04  = 0x00000000000000f0LL;
-   static const unsigned long long Right04 = 0x000000000000000fLL;
-//                                0 1 2 3 4 5 6 7 8 9 A B C D E F
-   static const int isMult[16] = {0,0,0,1,0,1,1,1,0,1,1,1,1,1,1,1};
-
-   if (mVec & Left32) {if (mVec & Right32) return 1;
-                          else mVec = mVec >> 32LL;
-                      }
-   if (mVec & Left16) {if (mVec & Right16) return 1;
-                          else mVec = mVec >> 16LL;
-                      }
-   if (mVec & Left08) {if (mVec & Right08) return 1;
-                          else mVec = mVec >>  8LL;
-                      }
-   if (mVec & Left04) {if (mVec & Right04) return 1;
-                          else mVec = mVec >>  4LL;
-                      }
-   return isMult[mVec];
+   return mVec.Multiple();
 }
   
 /******************************************************************************/
@@ -1526,19 +1704,7 @@ int XrdCmsCluster::Multiple(SMask_t mVec)
   
 bool XrdCmsCluster::maxBits(SMask_t mVec, int mbits)
 {
-   int count = 0;
-
-// Count bits. This is the fastest way assuming few bits are set
-//
-   while(mVec)
-        {mVec &= (mVec - 1);
-         count++;
-         if (count >= mbits) return true;
-        }
-
-// Indicate we have not reached the maximum bits set
-//
-   return false;
+   return mVec.Count() >= mbits;
 }
 
 /******************************************************************************/
@@ -1583,8 +1749,7 @@ int XrdCmsCluster::SelNode(XrdCmsSelect &Sel, SMask_t pmask, SMask_t amask)
    if (!(Sel.Opts & XrdCmsSelect::Pack)) selR.selPack = 0;
       else {unsigned int theHash = (Sel.Opts & XrdCmsSelect::UseAH
                                  ?  Sel.AltHash : Sel.Path.Hash);
-            SMask_t sVec = pmask;
-            for (count = 0; sVec; count++) sVec &= (sVec - 1);
+            count = pmask.Count();
             if (count > 1) selR.selPack = affsel = (theHash % count) + 1;
                else        selR.selPack = 0;
            }
@@ -1604,8 +1769,10 @@ int XrdCmsCluster::SelNode(XrdCmsSelect &Sel, SMask_t pmask, SMask_t amask)
    mask = pmask & peerMask;
    while(pass--)
         {if (mask)
-            {nP = (Config.sched_RR || (Sel.Opts & XrdCmsSelect::UseRef)
-                ?  SelbyRef(mask,selR) : SelbyLoad(mask,selR));
+            {if (Config.sched_Lat && !selR.selPack
+             &&  !(Sel.Opts & XrdCmsSelect::UseRef)) nP = SelbyLat(mask,selR);
+                else nP = (Config.sched_RR || (Sel.Opts & XrdCmsSelect::UseRef)
+                        ?  SelbyRef(mask,selR) : SelbyLoad(mask,selR));
              if (nP || (selR.nPick && selR.delay)
              ||  NodeCnt < Config.SUPCount) break;
             }
@@ -1744,8 +1911,8 @@ XrdCmsNode *XrdCmsCluster::SelbyCost(SMask_t mask, XrdCmsSelector &selR)
 // Scan for a node (sp points to the selected one)
 //
    selR.Reset(); SelTcnt++;
-   for (int i = 0; i <= STHi; i++)
-       if ((np = NodeTab[i]) && (np->NodeMask & mask))
+   for (int i = mask.First(); i >= 0 && i <= STHi; i = mask.First(i+1))
+       if ((np = NodeTab[i]))
           {if (!(selR.needNet &  np->hasNet))    {selR.xNoNet= true; continue;}
            selR.nPick++;
            if (np->isOffline)                    {selR.xOff  = true; continue;}
@@ -1775,6 +1942,69 @@ XrdCmsNode *XrdCmsCluster::SelbyCost(SMask_t mask, XrdCmsSelector &selR)
    return sp;
 }
   
+/******************************************************************************/
+/*                              S e l b y L a t                               */
+/******************************************************************************/
+
+// Latency selection picks two eligible nodes at random and uses the one whose
+// measured service latency, scaled by the number of recent redirects to it, is
+// lower. Load reports arrive every few seconds and lag; choosing among two
+// random nodes keeps a burst of requests from all landing on the node that last
+// looked best. Nodes whose latency is not yet known are compared by redirects.
+
+// Caller must have the STMutex locked. The returned node, if any, is unlocked.
+
+XrdCmsNode *XrdCmsCluster::SelbyLat(SMask_t mask, XrdCmsSelector &selR)
+{
+    XrdCmsNode *np, *sp, *nList[STMax];
+    long long sCost, nCost;
+    int n = 0, sBusy, nBusy, tNow = XrdCmsNode::Microsec()/1000000;
+    bool reqSS = (selR.needSpace & XrdCmsNode::allowsSS) != 0;
+
+// Gather all of the eligible nodes
+//
+   selR.Reset(); SelTcnt++;
+   for (int i = mask.First(); i >= 0 && i <= STHi; i = mask.First(i+1))
+       if ((np = NodeTab[i]))
+          {if (!(selR.needNet & np->hasNet))      {selR.xNoNet= true; continue;}
+           selR.nPick++;
+           if (np->isOffline)                     {selR.xOff  = true; continue;}
+           if (np->isBad)                         {selR.xSusp = true; continue;}
+           if (!Config.sched_RR && np->myLoad > Config.MaxLoad)
+                                                  {selR.xOvld = true; continue;}
+           if (selR.needSpace && (np->DiskFree < np->DiskMinF
+                                  || (reqSS && np->isNoStage)))
+              {selR.xFull = true; continue;}
+           nList[n++] = np;
+          }
+
+// Check for overloaded node
+//
+   if (!n) return calcDelay(selR);
+
+// Choose between two distinct nodes at random
+//
+   if (n == 1) sp = nList[0];
+      else {int a = Pick(n), b = Pick(n-1);
+            if (b >= a) b++;
+            sp = nList[a]; np = nList[b];
+            sBusy = sp->Redirects(tNow) + 1;
+            nBusy = np->Redirects(tNow) + 1;
+            if (sp->Latency() && np->Latency())
+               {sCost = static_cast<long long>(sp->Latency()) * sBusy;
+                nCost = static_cast<long long>(np->Latency()) * nBusy;
+               } else {sCost = sBusy; nCost = nBusy;}
+            if (nCost < sCost || (nCost == sCost && np->RefR < sp->RefR))
+               sp = np;
+           }
+
+// Return result
+//
+   sp->Redirects(tNow, true);
+   RefCount(sp, n > 1, selR.needSpace);
+   return sp;
+}
+  
 /******************************************************************************/
 /*                             S e l b y L o a d                              */
 /******************************************************************************/
@@ -1789,8 +2019,8 @@ XrdCmsNode *XrdCmsCluster::SelbyLoad(SMask_t mask, XrdCmsSelector &selR)
 // Scan for a node (preset possible, suspended, overloaded, full, and dead)
 //
    selR.Reset(); SelTcnt++;
-   for (int i = 0; i <= STHi; i++)
-       if ((np = NodeTab[i]) && (np->NodeMask & mask))
+   for (int i = mask.First(); i >= 0 && i <= STHi; i = mask.First(i+1))
+       if ((np = NodeTab[i]))
           {if (!(selR.needNet & np->hasNet))      {selR.xNoNet= true; continue;}
            selR.nPick++;
            if (np->isOffline)                     {selR.xOff  = true; continue;}
@@ -1839,8 +2069,8 @@ XrdCmsNode *XrdCmsCluster::SelbyRef(SMask_t mask, XrdCmsSelector &selR)
 // Scan for a node (sp points to the selected one)
 //
    selR.Reset(); SelTcnt++;
-   for (int i = 0; i <= STHi; i++)
-       if ((np = NodeTab[i]) && (np->NodeMask & mask))
+   for (int i = mask.First(); i >= 0 && i <= STHi; i = mask.First(i+1))
+       if ((np = NodeTab[i]))
           {if (!(selR.needNet & np->hasNet))    {selR.xNoNet= true; continue;}
            selR.nPick++;
            if (np->isOffline)                   {selR.xOff  = true; continue;}
@@ -1875,7 +2105,7 @@ int XrdCmsCluster::SelDFS(XrdCmsSelect &Sel, SMask_t amask,
                           SMask_t &pmask, SMask_t &smask, int isRW)
 {
    EPNAME("SelDFS");
-   static const SMask_t allNodes(~0);
+   static const SMask_t allNodes(FULLMASK);
    int oldOpts, rc;
 
 // The first task is to find out if the file exists somewhere. If we are doing
@@ -169,6 +169,11 @@ void           *MonPerf();
 //
 void           *MonRefs();
 
+// Sends, or queues for batching, a state query for Sel.Path to nodes in qmask
+// and returns the nodes that could not be queried.
+//
+SMask_t         Query(SMask_t qmask, XrdCms::CmsRRHdr &Hdr, XrdCmsSelect &Sel);
+
 // Return total number of redirect references
 //
 long long       Refs() {return SelWtot+SelRtot;}
@@ -222,6 +227,7 @@ XrdCmsNode *AddAlt(XrdCmsClustID *cidP, XrdLink *lp, int port, int Status,
                    int sport, const char *theNID, const char *theIF);
 XrdCmsNode *calcDelay(XrdCmsSelector &selR);
 int         Drop(int sent, int sinst, XrdCmsDrop *djp=0);
+SMask_t     HashPlace(XrdCmsSelect &Sel, SMask_t mask, bool isNew);
 void        Record(char *path, const char *reason, bool force=false);
 bool        maxBits(SMask_t mVec, int mbits);
 int         Multiple(SMask_t mVec);
@@ -229,6 +235,7 @@ enum        {eExists, eDups, eROfs, eNoRep, eNoSel, eNoEnt}; // Passed to SelFai
 int         SelFail(XrdCmsSelect &Sel, int rc);
 int         SelNode(XrdCmsSelect &Sel, SMask_t  pmask, SMask_t  amask);
 XrdCmsNode *SelbyCost(SMask_t, XrdCmsSelector &selR);
+XrdCmsNode *SelbyLat (SMask_t, XrdCmsSelector &selR);
 XrdCmsNode *SelbyLoad(SMask_t, XrdCmsSelector &selR);
 XrdCmsNode *SelbyRef (SMask_t, XrdCmsSelector &selR);
 int         SelDFS(XrdCmsSelect &Sel, SMask_t amask,
@@ -51,6 +51,7 @@
 
 #include "XrdCms/XrdCmsAdmin.hh"
 #include "XrdCms/XrdCmsBaseFS.hh"
+#include "XrdCms/XrdCmsBcast.hh"
 #include "XrdCms/XrdCmsBlackList.hh"
 #include "XrdCms/XrdCmsCache.hh"
 #include "XrdCms/XrdCmsCluster.hh"
@@ -58,6 +59,7 @@
 #include "XrdCms/XrdCmsManager.hh"
 #include "XrdCms/XrdCmsMeter.hh"
 #include "XrdCms/XrdCmsNode.hh"
+#include "XrdCms/XrdCmsNSum.hh"
 #include "XrdCms/XrdCmsPrepare.hh"
 #include "XrdCms/XrdCmsPrepArgs.hh"
 #include "XrdCms/XrdCmsProtocol.hh"
@@ -65,7 +67,9 @@
 #include "XrdCms/XrdCmsRRQ.hh"
 #include "XrdCms/XrdCmsSecurity.hh"
 #include "XrdCms/XrdCmsSelect.hh"
+#include "XrdCms/XrdCmsSnap.hh"
 #include "XrdCms/XrdCmsState.hh"
+#include "XrdCms/XrdCmsStateQ.hh"
 #include "XrdCms/XrdCmsSupervisor.hh"
 #include "XrdCms/XrdCmsTrace.hh"
 #include "XrdCms/XrdCmsUtils.hh"
@@ -421,12 +425,12 @@ int XrdCmsConfig::Configure2()
    sprintf(buff, " phase 2 %s initialization started.", myRole);
    Say.Say("++++++ ", myInstance, buff);
 
-// Fix up the QryMinum (we hard code 64 as the max) and P_gshr values.
+// Fix up the QryMinum (it can't exceed the number of nodes) and P_gshr values.
 // The QryMinum only applies to a metamanager and is set as 1 minus the min.
 //
-        if (!isMeta)       QryMinum =  0;
-   else if (QryMinum <  2) QryMinum =  0;
-   else if (QryMinum > 64) QryMinum = 64;
+        if (!isMeta)          QryMinum =  0;
+   else if (QryMinum <  2)    QryMinum =  0;
+   else if (QryMinum > STMax) QryMinum = STMax;
    if (P_gshr < 0) P_gshr = 0;
       else if (P_gshr > 100) P_gshr = 100;
 
@@ -435,7 +439,11 @@ int XrdCmsConfig::Configure2()
 //
    if (QryDelay < 0) QryDelay = LUPDelay;
    if (isManager) 
-      NoGo = !Cache.Init(cachelife,LUPDelay,QryDelay,baseFS.isDFS(),emptylife);
+      {NoGo = !Cache.Init(cachelife,LUPDelay,QryDelay,baseFS.isDFS(),emptylife);
+       if (!NoGo && Snap.isActive()) NoGo = !Snap.Start(cachelife);
+       if (!NoGo) NoGo = !StateQ.Start();
+       if (!NoGo) NoGo = !Bcast.Start();
+      }
 
 // Issue warning if the adminpath resides in /tmp
 //
@@ -476,6 +484,16 @@ int XrdCmsConfig::Configure2()
 //
    if ((LocalRoot || RemotRoot || N2N_Lib) && ConfigN2N()) NoGo = 1;
 
+// Namespace summaries derive logical names by stripping the localroot from
+// physical ones. That is wrong for an arbitrary name mapping, and a summary
+// with the wrong names would keep the node from being asked for its files.
+//
+   if (N2N_Lib && NSum.isActive())
+      {Say.Say("Config warning: nsummary is not supported with a namelib; "
+               "namespace summaries disabled.");
+       NSum.setParms(XrdCmsNSum::dfltSize, XrdCmsNSum::dfltHash, 0);
+      }
+
 // Configure the OSS, the base filesystem, and initialize the prep queue
 //
    if (!NoGo) NoGo = ConfigOSS();
@@ -550,16 +568,20 @@ int XrdCmsConfig::ConfigXeq(char *var, XrdOucStream &CFile, XrdSysError *eDest)
    TS_Xeq("adminpath",     xapath);  // Any,     non-dynamic
    TS_Xeq("allow",         xallow);  // Manager, non-dynamic
    TS_Xeq("altds",         xaltds);  // Server,  non-dynamic
+   TS_Xeq("bcast",         xbcast);  // Manager, non-dynamic
    TS_Xeq("blacklist",     xblk);    // Manager, non-dynamic
    TS_Xeq("cidtag",        xcid);    // Any,     non-dynamic
    TS_Xeq("defaults",      xdefs);   // Server,  non-dynamic
    TS_Xeq("dfs",           xdfs);    // Any,     non-dynamic
    TS_Xeq("export",        xexpo);   // Any,     non-dynamic
+   TS_Xeq("fslookup",      xfslk);   // Server,  non-dynamic
    TS_Xeq("fsxeq",         xfsxq);   // Server,  non-dynamic
+   TS_Xeq("hashplace",     xhashp);  // Manager, non-dynamic
    TS_Xeq("localroot",     xlclrt);  // Any,     non-dynamic
    TS_Xeq("manager",       xmang);   // Server,  non-dynamic
    TS_Lib("namelib", N2N_Lib, &N2N_Parms);
    TS_Xeq("nbsendq",       xnbsq);   // Any      non-dynamic
+   TS_Xeq("nsummary",      xnsum);   // Any,     non-dynamic
    TS_Lib("osslib",  ossLib,  &ossParms);
    TS_Xeq("perf",          xperf);   // Server,  non-dynamic
    TS_Xeq("prep",          xprep);   // Any,     non-dynamic
@@ -568,6 +590,7 @@ int XrdCmsConfig::ConfigXeq(char *var, XrdOucStream &CFile, XrdSysError *eDest)
    TS_Xeq("repstats",      xreps);   // Any,     non-dynamic
    TS_Xeq("role",          xrole);   // Server,  non-dynamic
    TS_Xeq("seclib",        xsecl);   // Server,  non-dynamic
+   TS_Xeq("snapshot",      xsnap);   // Manager, non-dynamic
    TS_Xeq("subcluster",    xsubc);   // Manager, non-dynamic
    TS_Xeq("superport",     xsupp);   // Super,   non-dynamic
    TS_Xeq("vnid",          xvnid);   // Server,  non-dynamic
@@ -653,6 +676,10 @@ void XrdCmsConfig::DoIt()
 //
    if (isManager || isServer || isPeer) XrdCmsManager::Start(ManList);
 
+// Start building namespace summaries if we are a pure data server
+//
+   if (isServer && !isManager && ManList && NSum.isActive()) NSum.Start();
+
 // Start state monitoring thread
 //
    if (XrdSysThread::Run(&tid, XrdCmsStartMonStat, (void *)0,
@@ -712,6 +739,7 @@ void XrdCmsConfig::ConfigDefaults(void)
    QryDelay =-1;
    QryMinum = 0;
    LUPHold  = 178;
+   QBatch   = 0;
    DELDelay = 960;  // 15 minutes
    DRPDelay = 10*60;
    PSDelay  = 0;
@@ -753,6 +781,7 @@ void XrdCmsConfig::ConfigDefaults(void)
    myPaths  = (char *)""; // Default is 'r /'
    ConfigFN = 0;
    sched_RR = sched_Pack = sched_AffPC = sched_Level = 0; sched_Force = 1;
+   sched_Lat = 0;
    isManager= 0;
    isMeta   = 0;
    isPeer   = 0;
@@ -775,6 +804,7 @@ void XrdCmsConfig::ConfigDefaults(void)
    ManList   =0;
    NanList   =0;
    SanList   =0;
+   HashList  =0;
    myVNID   = 0;
    mySID    = 0;
    mySite   = 0;
@@ -1127,6 +1157,7 @@ int XrdCmsConfig::setupManager()
       {Say.Say("Config round robin scheduling in effect.");
        sched_Level = 0;
       }
+   if (sched_Lat) Say.Say("Config latency based selection in effect.");
 
 // Create statistical monitoring thread
 //
@@ -1426,6 +1457,62 @@ int XrdCmsConfig::xapath(XrdSysError *eDest, XrdOucStream &CFile)
    return 0;
 }
 
+/******************************************************************************/
+/*                                x b c a s t                                 */
+/******************************************************************************/
+
+/* Function: xbcast
+
+   Purpose:  To parse the directive: bcast {off | [threads <n>] [maxq <mq>]}
+
+             off       Write broadcasts inline, one node after another.
+             <n>       The number of threads writing broadcast messages to the
+                       nodes. The default is 4.
+             <mq>      The number of broadcast messages that may be queued for
+                       a node. A node that falls further behind is skipped.
+                       The default is 32 and the maximum is 64.
+
+   Type: Manager only, non-dynamic.
+
+   Output: 0 upon success or !0 upon failure.
+*/
+
+int XrdCmsConfig::xbcast(XrdSysError *eDest, XrdOucStream &CFile)
+{
+    char *val;
+    int  tval = 4, qval = 32;
+
+    if (!(val = CFile.GetWord()))
+       {eDest->Emsg("Config", "bcast option not specified"); return 1;}
+    if (!strcmp(val, "off")) {Bcast.setParms(0, qval); return 0;}
+
+    while(val)
+         {     if (!strcmp(val, "threads"))
+                  {if (!(val = CFile.GetWord()))
+                      {eDest->Emsg("Config", "bcast threads not specified");
+                       return 1;
+                      }
+                   if (XrdOuca2x::a2i(*eDest,"bcast threads",val,&tval,1,64))
+                      return 1;
+                  }
+          else if (!strcmp(val, "maxq"))
+                  {if (!(val = CFile.GetWord()))
+                      {eDest->Emsg("Config", "bcast maxq not specified");
+                       return 1;
+                      }
+                   if (XrdOuca2x::a2i(*eDest, "bcast maxq", val, &qval,
+                                      1, XrdCmsBcast::maxQ)) return 1;
+                  }
+          else {eDest->Emsg("Config", "invalid bcast option -", val);
+                return 1;
+               }
+          val = CFile.GetWord();
+         }
+
+    Bcast.setParms(tval, qval);
+    return 0;
+}
+
 /******************************************************************************/
 /*                                  x b l k                                   */
 /******************************************************************************/
@@ -1536,7 +1623,7 @@ int XrdCmsConfig::xcid(XrdSysError *eDest, XrdOucStream &CFile)
                                            [service <sec>] [hold <msec>]
                                            [peer <sec>] [rw <lvl>] [qdl <sec>]
                                            [qdn <cnt>] [delnode <sec>]
-                                           [nostage <cnt>]
+                                           [nostage <cnt>] [qbatch <msec>]
 
    delnode   <sec>     maximum seconds to wait to be able to delete a node.
    discard   <cnt>     maximum number a message may be forwarded.
@@ -1548,6 +1635,9 @@ int XrdCmsConfig::xcid(XrdSysError *eDest, XrdOucStream &CFile)
    overload  <sec>     seconds to delay client when all servers overloaded.
    peer      <sec>     maximum seconds client may be delayed before peer
                        selection is triggered.
+   qbatch    <msec>    milliseconds to collect state queries to data servers
+                       so that each is sent a single batched query. By
+                       default queries are sent individually.
    qdl       <sec>     the query response deadline.
    qdn       <cnt>     Min number of servers that must respond to satisfy qdl.
    rw        <lvl>     how to delay r/w lookups (one of three levels):
@@ -1579,6 +1669,7 @@ int XrdCmsConfig::xdelay(XrdSysError *eDest, XrdOucStream &CFile)
         {"nostage",  &noStage,  01},
         {"overload", &MaxDelay,-1},
         {"peer",     &PSDelay,  1},
+        {"qbatch",   &QBatch,   0},
         {"qdl",      &QryDelay, 1},
         {"qdn",      &QryMinum, 0},
         {"rw",       &RWDelay,  0},
@@ -1809,6 +1900,64 @@ int XrdCmsConfig::xexpo(XrdSysError *eDest, XrdOucStream &CFile)
    return (XrdOucExport::ParsePath(CFile, *eDest, PexpList, DirFlags) ? 0 : 1);
 }
   
+/******************************************************************************/
+/*                                 x f s l k                                  */
+/******************************************************************************/
+  
+/* Function: xfslk
+
+   Purpose:  To parse the directive: fslookup [threads <n>] [mfhold <sec>]
+
+             <n>       the number of threads used to look up the paths in a
+                       batched state query in parallel. The default is 8.
+                       When a lookup rate limit is in effect (cms.dfs limit),
+                       this is also the number of threads issuing the paced
+                       lookups.
+             <sec>     remember that a file is missing for this many seconds
+                       so that repeated queries do not each cost a stat().
+                       Zero (the default) turns this off. Files created via
+                       this server are forgotten as missing immediately.
+
+   Type: Server only, non-dynamic.
+
+   Output: 0 upon success or !0 upon failure.
+*/
+
+int XrdCmsConfig::xfslk(XrdSysError *eDest, XrdOucStream &CFile)
+{
+    char *val;
+    int  tval = 8, hval = 0;
+
+    if (!(val = CFile.GetWord()))
+       {eDest->Emsg("Config", "fslookup option not specified"); return 1;}
+
+    while(val)
+         {     if (!strcmp(val, "threads"))
+                  {if (!(val = CFile.GetWord()))
+                      {eDest->Emsg("Config","fslookup threads not specified");
+                       return 1;
+                      }
+                   if (XrdOuca2x::a2i(*eDest,"fslookup threads",val,&tval,1,64))
+                      return 1;
+                  }
+          else if (!strcmp(val, "mfhold"))
+                  {if (!(val = CFile.GetWord()))
+                      {eDest->Emsg("Config","fslookup mfhold not specified");
+                       return 1;
+                      }
+                   if (XrdOuca2x::a2tm(*eDest,"fslookup mfhold",val,&hval,0))
+                      return 1;
+                  }
+          else {eDest->Emsg("Config", "invalid fslookup option -", val);
+                return 1;
+               }
+          val = CFile.GetWord();
+         }
+
+    baseFS.Lookup(tval, hval);
+    return 0;
+}
+
 /******************************************************************************/
 /*                                 x f s x q                                  */
 /******************************************************************************/
@@ -1928,6 +2077,43 @@ int XrdCmsConfig::xfxhld(XrdSysError *eDest, XrdOucStream &CFile)
     return 0;
 }
 
+/******************************************************************************/
+/*                                x h a s h p                                 */
+/******************************************************************************/
+
+/* Function: xhashp
+
+   Purpose:  To parse the directive: hashplace <path> [<path> [...]]
+
+             <path>    the path prefix of files that are placed by hashing the
+                       file name. A new file is placed on the node the name
+                       hashes to, provided it has enough free space. Any other
+                       file not in the cache is found by the usual query but
+                       the node it hashes to is queried first.
+
+   Type: Manager only, non-dynamic.
+
+   Output: 0 upon success or !0 upon failure.
+*/
+
+int XrdCmsConfig::xhashp(XrdSysError *eDest, XrdOucStream &CFile)
+{
+    char *val;
+
+    if (!isManager) return CFile.noEcho();
+
+    if (!(val = CFile.GetWord()))
+       {eDest->Emsg("Config", "hashplace path not specified"); return 1;}
+
+    do {if (*val != '/')
+           {eDest->Emsg("Config", "hashplace path is not absolute -", val);
+            return 1;
+           }
+        HashList = new XrdOucTList(val, (int)strlen(val), HashList);
+       } while((val = CFile.GetWord()));
+    return 0;
+}
+
 /******************************************************************************/
 /*                                x l c l r t                                 */
 /******************************************************************************/
@@ -2139,6 +2325,82 @@ int XrdCmsConfig::xnbsq(XrdSysError *eDest, XrdOucStream &CFile)
    return 0;
 }
 
+/******************************************************************************/
+/*                                 x n s u m                                  */
+/******************************************************************************/
+
+/* Function: xnsum
+
+   Purpose:  To parse the directive: nsummary {off | [interval <sec>]
+                                                      [size <bytes>]
+                                                      [hashes <n>]}
+
+             off       Do not use namespace summaries (the default).
+             <sec>     Seconds between summary rebuilds on a data server. The
+                       default is 10 minutes.
+             <bytes>   Size of the summary. It is rounded up to a power of two.
+                       The default is 1M which accommodates about 800,000
+                       names at a 1% false positive rate.
+             <n>       Number of hash functions, 1 to 16. The default is 7.
+
+   Type: Any, non-dynamic. Data servers build and send summaries while
+         managers use them to avoid querying servers that lack a file.
+         Summaries are disabled, with a warning, when a namelib is used
+         since only a localroot mapping can be reversed when summarizing.
+
+   Output: 0 upon success or !0 upon failure.
+*/
+
+int XrdCmsConfig::xnsum(XrdSysError *eDest, XrdOucStream &CFile)
+{
+    char *val;
+    long long sval = XrdCmsNSum::dfltSize;
+    int  hval = XrdCmsNSum::dfltHash, ival = 600, nsize;
+
+    if (!(val = CFile.GetWord()))
+       {eDest->Emsg("Config", "nsummary option not specified"); return 1;}
+    if (!strcmp(val, "off")) {NSum.setParms(sval, hval, 0); return 0;}
+
+    while(val)
+         {     if (!strcmp(val, "interval"))
+                  {if (!(val = CFile.GetWord()))
+                      {eDest->Emsg("Config","nsummary interval not specified");
+                       return 1;
+                      }
+                   if (XrdOuca2x::a2tm(*eDest,"nsummary interval",val,&ival,60))
+                      return 1;
+                  }
+          else if (!strcmp(val, "size"))
+                  {if (!(val = CFile.GetWord()))
+                      {eDest->Emsg("Config", "nsummary size not specified");
+                       return 1;
+                      }
+                   if (XrdOuca2x::a2sz(*eDest, "nsummary size", val, &sval,
+                                       XrdCmsNSum::minSize, XrdCmsNSum::maxSize))
+                      return 1;
+                  }
+          else if (!strcmp(val, "hashes"))
+                  {if (!(val = CFile.GetWord()))
+                      {eDest->Emsg("Config", "nsummary hashes not specified");
+                       return 1;
+                      }
+                   if (XrdOuca2x::a2i(*eDest, "nsummary hashes", val, &hval,
+                                      1, XrdCmsNSum::maxHash)) return 1;
+                  }
+          else {eDest->Emsg("Config", "invalid nsummary option -", val);
+                return 1;
+               }
+          val = CFile.GetWord();
+         }
+
+// The summary size must be a power of two
+//
+   nsize = XrdCmsNSum::minSize;
+   while(nsize < sval) nsize <<= 1;
+   NSum.setParms(nsize, hval, ival);
+   return 0;
+}
+
 /******************************************************************************/
 /*                                 x p e r f                                  */
 /******************************************************************************/
@@ -2400,6 +2662,8 @@ int XrdCmsConfig::xreps(XrdSysError *eDest, XrdOucStream &CFile)
     static struct repsopts {const char *opname; int opval;} rsopts[] =
        {
         {"all",      RepStat_All},
+        {"bcs",      RepStat_bcs},
+        {"csh",      RepStat_csh},
         {"frq",      RepStat_frq},
         {"shr",      RepStat_shr}
        };
@@ -2615,6 +2879,7 @@ int XrdCmsConfig::xrole(XrdSysError *eDest, XrdOucStream &CFile)
                                        [nomultisrc[@<host>:<port>]]
                 [affinity [default] {none | weak | strong | strict}]
                 [affpath {all | first m | last n}]
+                [latency {on | off}]
 
              <p>      is the percentage to include in the load as a value
                       between 0 and 100. For fuzz this is the largest
@@ -2624,7 +2889,10 @@ int XrdCmsConfig::xrole(XrdSysError *eDest, XrdOucStream &CFile)
                       between reference counter resets. gshr is the percentage
                       share of requests that should be redirected here via the 
                       metamanager (i.e. global share). The gsdflt is the
-                      default to be used by the metamanager.
+                      default to be used by the metamanager. latency on
+                      selects between two randomly chosen eligible servers
+                      the one with the lower measured service latency scaled
+                      by the number of recent redirects to it.
 
    Type: Any, dynamic.
 
@@ -2776,6 +3044,21 @@ int XrdCmsConfig::xschedx(char *val, XrdSysError *eDest, XrdOucStream &CFile)
        return 0;
       }
 
+// Check for latency
+//
+   if (!strcmp(val, "latency"))
+      {if (!(val = CFile.GetWord()))
+          {eDest->Emsg("Config","sched ","latency argument not specified.");
+           return -1;
+          }
+            if (!strcmp(val, "on"))  sched_Lat = 1;
+       else if (!strcmp(val, "off")) sched_Lat = 0;
+       else {eDest->Emsg("Config", "Invalid sched latency -", val);
+             return -1;
+            }
+       return 0;
+      }
+
 // Check for unqualified nomultisrc
 //
    if (!strcmp(val, "nomultisrc"))
@@ -2884,6 +3167,74 @@ int XrdCmsConfig::xsecl(XrdSysError *eDest, XrdOucStream &CFile)
    return (XrdOucUtils::parseLib(*eDest,CFile,"seclib",SecLib,0) ? 0 : 1);
 }
   
+/******************************************************************************/
+/*                                 x s n a p                                  */
+/******************************************************************************/
+
+/* Function: xsnap
+
+   Purpose:  To parse the directive: snapshot <path> [interval <sec>]
+                                                     [maxage <sec>]
+
+             <path>    Absolute path of the file that holds the snapshot of
+                       the file location cache. By default, no snapshot is
+                       taken.
+             <sec>     For interval, seconds between snapshots. The default
+                       is 5 minutes. For maxage, the oldest snapshot that is
+                       used upon restart. The default is 15 minutes. Entries
+                       older than the fxhold time are never used.
+
+   Type: Manager, non-dynamic.
+
+   Output: 0 upon success or !0 upon failure.
+*/
+
+int XrdCmsConfig::xsnap(XrdSysError *eDest, XrdOucStream &CFile)
+{
+    char *val, path[1024];
+    int  ival = 300, mval = 900;
+
+// If we are a server, ignore this option
+//
+    if (!isManager) return CFile.noEcho();
+
+// Get the path
+//
+    if (!(val = CFile.GetWord()))
+       {eDest->Emsg("Config", "snapshot path not specified"); return 1;}
+    if (*val != '/')
+       {eDest->Emsg("Config", "snapshot path not absolute"); return 1;}
+    if (strlcpy(path, val, sizeof(path)) >= sizeof(path))
+       {eDest->Emsg("Config", "snapshot path is too long"); return 1;}
+
+// Process the options
+//
+    while((val = CFile.GetWord()))
+         {     if (!strcmp(val, "interval"))
+                  {if (!(val = CFile.GetWord()))
+                      {eDest->Emsg("Config","snapshot interval not specified");
+                       return 1;
+                      }
+                   if (XrdOuca2x::a2tm(*eDest,"snapshot interval",val,&ival,10))
+                      return 1;
+                  }
+          else if (!strcmp(val, "maxage"))
+                  {if (!(val = CFile.GetWord()))
+                      {eDest->Emsg("Config", "snapshot maxage not specified");
+                       return 1;
+                      }
+                   if (XrdOuca2x::a2tm(*eDest,"snapshot maxage",val,&mval,1))
+                      return 1;
+                  }
+          else {eDest->Emsg("Config", "invalid snapshot option -", val);
+                return 1;
+               }
+         }
+
+    Snap.setParms(path, ival, mval);
+    return 0;
+}
+  
 /******************************************************************************/
 /*                                x s p a c e                                 */
 /******************************************************************************/
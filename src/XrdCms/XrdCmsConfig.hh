@@ -72,6 +72,7 @@ int   asSolo()    {return isSolo;}
 
 int         LUPDelay;     // Maximum delay at look-up
 int         LUPHold;      // Maximum hold  at look-up (in millisconds)
+int         QBatch;       // Window to batch state queries (in milliseconds)
 int         DELDelay;     // Maximum delay for deleting an offline server
 int         DRPDelay;     // Maximum delay for dropping an offline server
 int         PSDelay;      // Maximum delay time before peer is selected
@@ -130,6 +131,7 @@ char        sched_Pack;   // 1 -> Pick with affinity (>1 same but wait for resps
 char        sched_AffPC;  // Affinity path component count (-255 <= n <= 255)
 char        sched_Level;  // 1 -> Use load-based level for "pack" selection
 char        sched_Force;  // 1 -> Client cannot select mode
+char        sched_Lat;    // 1 -> Select by latency using two random choices
 int         doWait;       // 1 -> Wait for a data end-point
 
 int         adsPort;      // Alternate server port
@@ -179,6 +181,7 @@ const char  *ifList;
 XrdOucTList *ManList;     // From manager directive
 XrdOucTList *NanList;     // From manager directive (managers only)
 XrdOucTList *SanList;     // From subcluster directive (managers only)
+XrdOucTList *HashList;    // From hashplace directive (managers only)
 
 XrdOss      *ossFS;       // The filsesystem interface
 XrdOucProg  *ProgCH;      // Server only chmod
@@ -204,6 +207,8 @@ XrdNetSecurity    *Police;
 //
 static const int RepStat_frq    = 0x0001; // Fast Response Queue
 static const int RepStat_shr    = 0x0002; // Share
+static const int RepStat_csh    = 0x0004; // Location cache shards
+static const int RepStat_bcs    = 0x0008; // Broadcast writer
 static const int RepStat_All    = 0xffff; // All
 
 private:
@@ -222,6 +227,7 @@ void Usage(int rc);
 int  xapath(XrdSysError *edest, XrdOucStream &CFile);
 int  xallow(XrdSysError *edest, XrdOucStream &CFile);
 int  xaltds(XrdSysError *edest, XrdOucStream &CFile);
+int  xbcast(XrdSysError *edest, XrdOucStream &CFile);
 int  Fsysadd(XrdSysError *edest, int chk, char *fn);
 int  xblk(XrdSysError *edest, XrdOucStream &CFile, bool iswl=false);
 int  xcid(XrdSysError *edest, XrdOucStream &CFile);
@@ -229,11 +235,14 @@ int  xdelay(XrdSysError *edest, XrdOucStream &CFile);
 int  xdefs(XrdSysError *edest, XrdOucStream &CFile);
 int  xdfs(XrdSysError *edest, XrdOucStream &CFile);
 int  xexpo(XrdSysError *edest, XrdOucStream &CFile);
+int  xfslk(XrdSysError *edest, XrdOucStream &CFile);
+int  xhashp(XrdSysError *edest, XrdOucStream &CFile);
 int  xfsxq(XrdSysError *edest, XrdOucStream &CFile);
 int  xfxhld(XrdSysError *edest, XrdOucStream &CFile);
 int  xlclrt(XrdSysError *edest, XrdOucStream &CFile);
 int  xmang(XrdSysError *edest, XrdOucStream &CFile);
 int  xnbsq(XrdSysError *edest, XrdOucStream &CFile);
+int  xnsum(XrdSysError *edest, XrdOucStream &CFile);
 int  xperf(XrdSysError *edest, XrdOucStream &CFile);
 int  xping(XrdSysError *edest, XrdOucStream &CFile);
 int  xprep(XrdSysError *edest, XrdOucStream &CFile);
@@ -247,6 +256,7 @@ int  xschedp(char *val, XrdSysError *eDest, XrdOucStream &CFile);
 int  xschedx(char *val, XrdSysError *eDest, XrdOucStream &CFile);
 bool xschedy(char *val, XrdSysError *eDest, char *&host, int &hlen, int &port);
 int  xsecl(XrdSysError *edest, XrdOucStream &CFile);
+int  xsnap(XrdSysError *edest, XrdOucStream &CFile);
 int  xspace(XrdSysError *edest, XrdOucStream &CFile);
 int  xsubc(XrdSysError *edest, XrdOucStream &CFile);
 int  xsupp(XrdSysError *edest, XrdOucStream &CFile);
@@ -120,44 +120,49 @@ XrdCmsKeyLoc&  operator=(const XrdCmsKeyLoc &rhs)
   
 // The XrdCmsKeyItem object marries the XrdCmsKey and XrdCmsKeyLoc objects in
 // the key cache. It is only used by logical manipulator, XrdCmsCache, which
-// always front-ends the physical manipulator, XrdCmsNash.
+// always front-ends the physical manipulator, XrdCmsNash. Items come from a
+// Pool which also holds the time-of-day lists. Each XrdCmsNash has its own
+// pool so that an item is only ever manipulated under its table's lock.
 //
 class XrdCmsKeyItem
 {
 public:
 
+static const unsigned int TickRate =   64;
+static const unsigned int TickMask =   63;
+static const          int minAlloc = 4096;
+static const          int minFree  = 1024;
+
+struct Pool
+      {XrdCmsKeyItem *TockTable[TickRate];
+       XrdCmsKeyItem *Free;
+       int            numFree;
+       int            numHave;
+       int            numNull;
+
+       Pool() : Free(0), numFree(0), numHave(0), numNull(0)
+              {memset(TockTable, 0, sizeof(TockTable));}
+      };
+
        XrdCmsKeyLoc   Loc;
        XrdCmsKey      Key;
        XrdCmsKeyItem *Next;
 
-static XrdCmsKeyItem *Alloc(unsigned int theTock);
+static XrdCmsKeyItem *Alloc(Pool &pool, unsigned int theTock);
 
-       void           Recycle();
+       void           Recycle(Pool &pool);
 
-       void           Reload();
+       void           Reload(Pool &pool);
 
-static int            Replenish();
+static int            Replenish(Pool &pool);
 
-static void           Stats(int &isAlloc, int &isFree, int &wasEmpty);
+static void           Stats(Pool &pool, int &isAlloc, int &isFree, int &wasEmpty);
 
-static XrdCmsKeyItem *Unload(unsigned int   theTock);
+static XrdCmsKeyItem *Unload(Pool &pool, unsigned int   theTock);
 
-static XrdCmsKeyItem *Unload(XrdCmsKeyItem *theItem);
+static XrdCmsKeyItem *Unload(Pool &pool, XrdCmsKeyItem *theItem);
 
        XrdCmsKeyItem() {}  // Warning see the constructor!
       ~XrdCmsKeyItem() {}  // These are usually never deleted
-
-static const unsigned int TickRate =   64;
-static const unsigned int TickMask =   63;
-static const          int minAlloc = 4096;
-static const          int minFree  = 1024;
-
-private:
-
-static XrdCmsKeyItem *TockTable[TickRate];
-static XrdCmsKeyItem *Free;
-static int            numFree;
-static int            numHave;
-static int            numNull;
 };
 #endif
@@ -90,7 +90,7 @@ int XrdCmsLogin::Admit(XrdLink    *Link, CmsLoginData &Data,
       {static const int rbsz = 1024;
        char *rbP, rbuff[rbsz];
        int rc;
-       rbP = (myData.Version <= Data.Version ? rbuff : 0);
+       rbP = (Data.Version >= kYR_VerBLR ? rbuff : 0);
        rc = XrdCmsBlackList::Present(Link->Host(), 0, rbP, rbsz);
             if (rc > 0) return SendErrorBL(Link, rbuff, rc);
        else if (rc < 0) return SendErrorBL(Link);
@@ -98,7 +98,7 @@ int XrdCmsLogin::Admit(XrdLink    *Link, CmsLoginData &Data,
 
 // Fill out additional information if the client can accept it
 //
-   if (myData.Version <= Data.Version)
+   if (Data.Version >= kYR_VerBLR)
       {myData.SID      = (kXR_char *)sid;
        myData.envCGI   = (kXR_char *)envP;
       }
@@ -40,6 +40,7 @@
 #include "XrdCms/XrdCmsManager.hh"
 #include "XrdCms/XrdCmsManTree.hh"
 #include "XrdCms/XrdCmsNode.hh"
+#include "XrdCms/XrdCmsNSum.hh"
 #include "XrdCms/XrdCmsProtocol.hh"
 #include "XrdCms/XrdCmsRouting.hh"
 #include "XrdCms/XrdCmsUtils.hh"
@@ -162,6 +163,10 @@ XrdCmsNode *XrdCmsManager::Add(XrdLink *lp, int Lvl, bool &xit)
    nP->setManager(this);
    MTMutex.UnLock();
 
+// A new manager needs our namespace summary in full
+//
+   NSum.Resync();
+
 // Document login
 //
    DEBUG(nP->Name() <<" to manager config; id=" <<i);
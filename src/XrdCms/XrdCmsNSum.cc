@@ -0,0 +1,515 @@
+/******************************************************************************/
+/*                                                                            */
+/*                         X r d C m s N S u m . c c                          */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <vector>
+#include <netinet/in.h>
+#include <sys/uio.h>
+
+#include "XProtocol/YProtocol.hh"
+
+#include "XrdCms/XrdCmsConfig.hh"
+#include "XrdCms/XrdCmsManager.hh"
+#include "XrdCms/XrdCmsNSum.hh"
+#include "XrdCms/XrdCmsRRData.hh"
+#include "XrdCms/XrdCmsTrace.hh"
+#include "XrdOuc/XrdOucNSWalk.hh"
+#include "XrdSys/XrdSysError.hh"
+
+using namespace XrdCms;
+
+/******************************************************************************/
+/*                               G l o b a l s                                */
+/******************************************************************************/
+
+       XrdCmsNSum    XrdCms::NSum;
+
+namespace
+{
+// Every so many rebuilds the summary is sent in full even when a delta would
+// do. This bounds how long a manager that missed a delta remains without one.
+//
+static const int fullEvery = 6;
+
+// A summary that has been neither replaced nor confirmed for this many build
+// intervals is considered stale and no longer used to prune nodes.
+//
+static const int staleAfter = 2;
+
+// Header preceding each summary segment (see CmsNSumRequest)
+//
+struct NSumHdr
+      {kXR_unt32 Gen;
+       kXR_unt32 Base;
+       kXR_unt32 Size;
+       kXR_unt32 Offset;
+       kXR_unt32 Hashes;
+      };
+}
+
+/******************************************************************************/
+/*            E x t e r n a l   T h r e a d   I n t e r f a c e s             */
+/******************************************************************************/
+
+namespace
+{
+void *NSumRun(void *carg)
+      {XrdCmsNSum *sp = (XrdCmsNSum *)carg;
+       return sp->Summarize();
+      }
+}
+
+/******************************************************************************/
+/*                        C l a s s   F i l t e r                             */
+/******************************************************************************/
+
+XrdCmsNSum::Filter::Filter(unsigned int sz, unsigned int nh, unsigned int gen)
+                          : Size(sz), Mask(sz*8-1), Hashes(nh), Gen(gen),
+                            Stamp(0)
+{
+   Bits = (unsigned char *)calloc(sz, 1);
+}
+
+XrdCmsNSum::Filter::~Filter()
+{
+   if (Bits) free(Bits);
+}
+
+/******************************************************************************/
+
+void XrdCmsNSum::Filter::Add(unsigned int h1, unsigned int h2)
+{
+   unsigned int pos;
+
+   for (unsigned int i = 0; i < Hashes; i++)
+       {pos = (h1 + i*h2) & Mask;
+        Bits[pos >> 3] |= static_cast<unsigned char>(1 << (pos & 7));
+       }
+}
+
+/******************************************************************************/
+
+bool XrdCmsNSum::Filter::Test(unsigned int h1, unsigned int h2)
+{
+   unsigned int pos;
+
+   for (unsigned int i = 0; i < Hashes; i++)
+       {pos = (h1 + i*h2) & Mask;
+        if (!(Bits[pos >> 3] & (1 << (pos & 7)))) return false;
+       }
+   return true;
+}
+
+/******************************************************************************/
+/*                           C o n s t r u c t o r                            */
+/******************************************************************************/
+
+XrdCmsNSum::XrdCmsNSum() : sumCond(0), Current(0), curGen(0), doResync(false),
+                           Size(dfltSize), Hashes(dfltHash), Interval(0)
+{
+   memset(Active,  0, sizeof(Active));
+   memset(Pending, 0, sizeof(Pending));
+}
+
+/******************************************************************************/
+/*                                   A d d                                    */
+/******************************************************************************/
+
+void XrdCmsNSum::Add(int nodeID, const char *Path, int Plen)
+{
+   Filter *fP;
+   unsigned int h1, h2;
+
+// If summaries are not being used, there is nothing to do
+//
+   if (!Interval) return;
+
+// Add the path to the node's active summary so that a file created after the
+// summary was built is still found. A summary being received has been built
+// more recently, so it is left alone.
+//
+   Hash(Path, Plen, h1, h2);
+   fltLock.WriteLock();
+   if ((fP = Active[nodeID])) fP->Add(h1, h2);
+   fltLock.UnLock();
+}
+
+/******************************************************************************/
+/*                                  D r o p                                   */
+/******************************************************************************/
+
+void XrdCmsNSum::Drop(int nodeID)
+{
+   Filter *fP;
+
+// Discard any partially received summary
+//
+   pndMutex.Lock();
+   fP = Pending[nodeID]; Pending[nodeID] = 0;
+   pndMutex.UnLock();
+   if (fP) delete fP;
+
+// Discard the active summary
+//
+   fltLock.WriteLock();
+   fP = Active[nodeID]; Active[nodeID] = 0;
+   fltLock.UnLock();
+   if (fP) delete fP;
+}
+
+/******************************************************************************/
+/*                                 M a t c h                                  */
+/******************************************************************************/
+
+SMask_t XrdCmsNSum::Match(const char *Path, int Plen, SMask_t qMask,
+                                                      SMask_t aMask)
+{
+   Filter *fP;
+   SMask_t mMask = qMask;
+   time_t  Oldest = time(0) - staleAfter*Interval;
+   unsigned int h1, h2;
+
+// If summaries are not being used, everyone matches
+//
+   if (!Interval) return qMask;
+
+// Remove each node whose current summary says it cannot have the path unless
+// the node may stage the path in, in which case its namespace is open ended.
+//
+   Hash(Path, Plen, h1, h2);
+   fltLock.ReadLock();
+   for (int i = qMask.First(); i >= 0; i = qMask.First(i+1))
+       if ((fP = Active[i]) && fP->Stamp >= Oldest && !aMask.Test(i)
+       &&  !fP->Test(h1, h2)) mMask.Clr(i);
+   fltLock.UnLock();
+
+// A summary may miss recent files, so when no node matches the summaries are
+// of no help and everyone must be asked.
+//
+   return (mMask ? mMask : qMask);
+}
+
+/******************************************************************************/
+/*                                R e s y n c                                 */
+/******************************************************************************/
+
+void XrdCmsNSum::Resync()
+{
+   if (!Interval) return;
+   sumCond.Lock();
+   doResync = true;
+   sumCond.Signal();
+   sumCond.UnLock();
+}
+
+/******************************************************************************/
+/*                                 S t a r t                                  */
+/******************************************************************************/
+
+int XrdCmsNSum::Start()
+{
+   pthread_t tid;
+
+// Start the thread that builds and sends the summaries
+//
+   if (XrdSysThread::Run(&tid, NSumRun, (void *)this, 0, "Namespace summary"))
+      {Say.Emsg("NSum", errno, "start namespace summary thread");
+       return 0;
+      }
+   return 1;
+}
+
+/******************************************************************************/
+/*                             S u m m a r i z e                              */
+/******************************************************************************/
+
+void *XrdCmsNSum::Summarize()
+{
+   Filter *fP;
+   time_t Now, nextBuild = 0;
+   int nBuilt = 0;
+   bool resync;
+
+// Rebuild the summary every interval. When a new manager logs in we resend
+// the current summary in full without rebuilding it.
+//
+   do {sumCond.Lock();
+       Now = time(0);
+       if (!doResync && nextBuild > Now)
+          sumCond.Wait(static_cast<int>(nextBuild - Now));
+       resync = doResync; doResync = false;
+       sumCond.UnLock();
+
+       if (time(0) >= nextBuild)
+          {fP = new Filter(Size, Hashes, ++curGen);
+           Build(*fP);
+           Send(*fP, (resync || !Current || !(nBuilt % fullEvery)
+                   || Current->Size != fP->Size ? 0 : Current));
+           if (Current) delete Current;
+           Current = fP; curGen = fP->Gen; nBuilt++;
+           nextBuild = time(0) + Interval;
+          } else if (resync && Current) Send(*Current, 0);
+      } while(1);
+
+// Keep the compiler happy
+//
+   return (void *)0;
+}
+
+/******************************************************************************/
+/*                                U p d a t e                                 */
+/******************************************************************************/
+
+void XrdCmsNSum::Update(int nodeID, const char *nodeName, XrdCmsRRData &Arg)
+{
+   EPNAME("NSum");
+   NSumHdr hdr;
+   Filter *aP, *pP, *oP = 0;
+   const char *Data;
+   unsigned int Gen, Base, Size, Offset, Hashes, Dlen;
+   int mod = Arg.Request.modifier;
+
+// If we are not using summaries, ignore this
+//
+   if (!Interval) return;
+
+// Extract the segment header and validate it
+//
+   if (Arg.PathLen < (int)sizeof(hdr))
+      {Say.Emsg("NSum", "Invalid namespace summary from", nodeName); return;}
+   memcpy(&hdr, Arg.Path, sizeof(hdr));
+   Gen    = ntohl(hdr.Gen);
+   Base   = ntohl(hdr.Base);
+   Size   = ntohl(hdr.Size);
+   Offset = ntohl(hdr.Offset);
+   Hashes = ntohl(hdr.Hashes);
+   Data   = Arg.Path + sizeof(hdr);
+   Dlen   = Arg.PathLen - sizeof(hdr);
+
+   if (Size < (unsigned int)minSize || Size > (unsigned int)maxSize
+   ||  (Size & (Size-1)) || !Hashes || Hashes > (unsigned int)maxHash
+   ||  Offset > Size || Dlen > Size - Offset)
+      {Say.Emsg("NSum", "Invalid namespace summary from", nodeName); return;}
+
+// An empty delta against the generation we have means that nothing changed.
+// It merely confirms that our summary is current.
+//
+   if (!(mod & CmsNSumRequest::kYR_nsfull) && !Dlen && Gen == Base
+   &&  (mod & CmsNSumRequest::kYR_nsfirst)
+   &&  (mod & CmsNSumRequest::kYR_nslast))
+      {fltLock.WriteLock();
+       if ((aP = Active[nodeID]) && aP->Gen == Gen) aP->Stamp = time(0);
+       fltLock.UnLock();
+       return;
+      }
+
+// Start a new summary if this is the first segment. A delta is only usable if
+// we have the summary it was computed against; if not, we discard what we
+// have as it is now stale and wait for the next full summary.
+//
+   pndMutex.Lock();
+   if (mod & CmsNSumRequest::kYR_nsfirst)
+      {if ((pP = Pending[nodeID])) delete pP;
+       Pending[nodeID] = 0;
+       if (mod & CmsNSumRequest::kYR_nsfull)
+          Pending[nodeID] = new Filter(Size, Hashes, Gen);
+          else {fltLock.ReadLock();
+                if ((aP = Active[nodeID]) && aP->Gen == Base
+                &&  aP->Size == Size && aP->Hashes == Hashes)
+                   {Pending[nodeID] = new Filter(Size, Hashes, Gen);
+                    memcpy(Pending[nodeID]->Bits, aP->Bits, Size);
+                   }
+                fltLock.UnLock();
+                if (!Pending[nodeID])
+                   {DEBUG(nodeName <<" summary delta " <<Gen <<" has no base "
+                                   <<Base);
+                    fltLock.WriteLock();
+                    oP = Active[nodeID]; Active[nodeID] = 0;
+                    fltLock.UnLock();
+                   }
+               }
+      }
+
+// Apply the segment. If this is the last one, make the summary active.
+//
+   if ((pP = Pending[nodeID]) && pP->Gen == Gen && pP->Size == Size)
+      {if (Dlen) memcpy(pP->Bits + Offset, Data, Dlen);
+       if (mod & CmsNSumRequest::kYR_nslast)
+          {pP->Stamp = time(0);
+           fltLock.WriteLock();
+           oP = Active[nodeID]; Active[nodeID] = pP;
+           fltLock.UnLock();
+           Pending[nodeID] = 0;
+           DEBUG(nodeName <<" summary " <<Gen <<" installed");
+          }
+      }
+   pndMutex.UnLock();
+   if (oP) delete oP;
+}
+
+/******************************************************************************/
+/*                       P r i v a t e   M e t h o d s                        */
+/******************************************************************************/
+/******************************************************************************/
+/*                                 B u i l d                                  */
+/******************************************************************************/
+
+int XrdCmsNSum::Build(Filter &fP)
+{
+   EPNAME("Build");
+   static const int wOpts = XrdOucNSWalk::retFile | XrdOucNSWalk::retDir
+                          | XrdOucNSWalk::Recurse | XrdOucNSWalk::skpErrs;
+   XrdOucNSWalk::NSEnt *nP, *nX;
+   XrdCmsPList *pP = Config.PathList.First();
+   char lfn[XrdCmsMAX_PATH_LEN+1], pfn[XrdCmsMAX_PATH_LEN+1];
+   unsigned int h1, h2;
+   int rc, lfnLen, pfnLen, eLen, numEnt = 0;
+
+// Walk each exported path and add every file and directory to the summary.
+// The logical name is the export plus the entry's path relative to the
+// physical name of the export.
+//
+   while(pP)
+        {lfnLen = strlen(pP->Path());
+         while(lfnLen > 1 && pP->Path()[lfnLen-1] == '/') lfnLen--;
+         if (lfnLen >= (int)sizeof(lfn)
+         ||  Config.GenLocalPath(pP->Path(), pfn))
+            {pP = pP->Next(); continue;}
+         strncpy(lfn, pP->Path(), lfnLen); lfn[lfnLen] = 0;
+         pfnLen = strlen(pfn);
+         while(pfnLen > 1 && pfn[pfnLen-1] == '/') pfn[--pfnLen] = 0;
+         Hash(lfn, lfnLen, h1, h2); fP.Add(h1, h2); numEnt++;
+
+         XrdOucNSWalk nsWalk(0, pfn, 0, wOpts);
+         while((nP = nsWalk.Index(rc)))
+              {while((nX = nP))
+                    {nP = nP->Next;
+                     eLen = nX->Plen - pfnLen;
+                     if (eLen > 0 && lfnLen + eLen < (int)sizeof(lfn)
+                     &&  !strncmp(nX->Path, pfn, pfnLen))
+                        {strcpy(lfn+lfnLen, nX->Path+pfnLen);
+                         Hash(lfn, lfnLen+eLen, h1, h2); fP.Add(h1, h2);
+                         numEnt++;
+                        }
+                     delete nX;
+                    }
+              }
+         if (rc) Say.Emsg("NSum", rc, "fully summarize", pfn);
+         pP = pP->Next();
+        }
+
+// Document what we did
+//
+   DEBUG("summary " <<fP.Gen <<" has " <<numEnt <<" entries");
+   return numEnt;
+}
+
+/******************************************************************************/
+/*                                  H a s h                                   */
+/******************************************************************************/
+
+void XrdCmsNSum::Hash(const char *Path, int Plen, unsigned int &h1,
+                                                  unsigned int &h2)
+{
+   unsigned long long hv = 0xcbf29ce484222325ULL;
+
+// Trailing slashes are not significant
+//
+   while(Plen > 1 && Path[Plen-1] == '/') Plen--;
+
+// Compute a 64-bit FNV-1a hash and split it for double hashing. The second
+// hash must be odd so that successive probes cover the whole filter.
+//
+   for (int i = 0; i < Plen; i++)
+       {hv ^= static_cast<unsigned char>(Path[i]);
+        hv *= 0x100000001b3ULL;
+       }
+   h1 = static_cast<unsigned int>(hv);
+   h2 = static_cast<unsigned int>(hv >> 32) | 1;
+}
+
+/******************************************************************************/
+/*                                  S e n d                                   */
+/******************************************************************************/
+
+// Send a summary to all of our managers. When oP is nil a full summary is
+// sent, otherwise only the segments that differ from oP are sent. A delta
+// with no changes keeps the previous generation and is sent as an empty
+// segment so that managers know the summary they have is still current.
+//
+void XrdCmsNSum::Send(Filter &fP, Filter *oP)
+{
+   CmsRRHdr Hdr = {0, kYR_nsum, 0, 0};
+   NSumHdr  sHdr;
+   struct iovec ioV[3];
+   std::vector<unsigned int> segs;
+   unsigned int sLen = (fP.Size < (unsigned int)segSize ? fP.Size : segSize);
+   unsigned int dLen = sLen;
+   int mod;
+
+// Determine which segments must be sent
+//
+   for (unsigned int off = 0; off < fP.Size; off += sLen)
+       {if (oP) {if (memcmp(fP.Bits+off, oP->Bits+off, sLen)) segs.push_back(off);}
+           else {for (unsigned int i = 0; i < sLen; i++)
+                     if (fP.Bits[off+i]) {segs.push_back(off); break;}
+                }
+       }
+
+// Handle the case where nothing needs to be sent
+//
+   if (segs.empty())
+      {if (oP) {fP.Gen = oP->Gen; dLen = 0;}
+       segs.push_back(0);
+      }
+
+// Send each segment
+//
+   sHdr.Gen    = htonl(fP.Gen);
+   sHdr.Base   = htonl(oP ? oP->Gen : 0);
+   sHdr.Size   = htonl(fP.Size);
+   sHdr.Hashes = htonl(fP.Hashes);
+   ioV[0].iov_base = (char *)&Hdr;  ioV[0].iov_len = sizeof(Hdr);
+   ioV[1].iov_base = (char *)&sHdr; ioV[1].iov_len = sizeof(sHdr);
+   ioV[2].iov_len  = dLen;
+   Hdr.datalen = htons(static_cast<unsigned short>(sizeof(sHdr) + dLen));
+
+   for (unsigned int i = 0; i < segs.size(); i++)
+       {mod = kYR_raw;
+        if (!oP) mod |= CmsNSumRequest::kYR_nsfull;
+        if (!i)  mod |= CmsNSumRequest::kYR_nsfirst;
+        if (i == segs.size()-1) mod |= CmsNSumRequest::kYR_nslast;
+        Hdr.modifier    = static_cast<kXR_char>(mod);
+        sHdr.Offset     = htonl(segs[i]);
+        ioV[2].iov_base = (char *)fP.Bits + segs[i];
+        XrdCmsManager::Inform("nsum", ioV, 3, sizeof(Hdr)+sizeof(sHdr)+dLen);
+       }
+}
@@ -0,0 +1,145 @@
+#ifndef __CMS_NSUM__H
+#define __CMS_NSUM__H
+/******************************************************************************/
+/*                                                                            */
+/*                         X r d C m s N S u m . h h                          */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <ctime>
+
+#include "XrdCms/XrdCmsTypes.hh"
+#include "XrdSys/XrdSysPthread.hh"
+
+class XrdCmsRRData;
+
+/******************************************************************************/
+/*                      C l a s s   X r d C m s N S u m                       */
+/******************************************************************************/
+
+// XrdCmsNSum manages namespace summaries. A data server periodically walks
+// its exported paths and builds a Bloom filter of every file and directory
+// name, which it sends to its managers (see CmsNSumRequest). A manager keeps
+// the latest summary for each node and uses it to avoid querying nodes that
+// cannot have a file. A summary misses anything created since it was built,
+// so it only ever prunes the nodes to be asked; it never decides that a file
+// does not exist. A refresh lookup ignores summaries.
+//
+class XrdCmsNSum
+{
+public:
+
+// Add() records that a node has a path, typically from a have (manager).
+//
+void        Add(int nodeID, const char *Path, int Plen);
+
+// Drop() discards the summary for a node (manager).
+//
+void        Drop(int nodeID);
+
+// Match() returns the subset of nodes in qMask that may have the path. Nodes
+// in aMask (e.g. those that can stage the path), nodes without a summary,
+// and nodes whose summary is stale always match. If nothing else matches,
+// all of qMask is returned (manager).
+//
+SMask_t     Match(const char *Path, int Plen, SMask_t qMask, SMask_t aMask=0);
+
+// Resync() causes the current summary to be sent in full (server).
+//
+void        Resync();
+
+// Start() starts the summary builder thread (server).
+//
+int         Start();
+
+void       *Summarize();
+
+// Update() applies a summary segment sent by a node (manager).
+//
+void        Update(int nodeID, const char *nodeName, XrdCmsRRData &Arg);
+
+inline bool isActive() {return Interval != 0;}
+
+// Set the summary parameters (cms.nsummary directive).
+//
+void        setParms(int sBytes, int nHash, int intv)
+                    {Size = sBytes; Hashes = nHash; Interval = intv;}
+
+static const int dfltSize = 1024*1024;  // Summary size in bytes
+static const int dfltHash = 7;          // Number of hash functions
+static const int maxHash  = 16;
+static const int minSize  = 1024;
+static const int maxSize  = 64*1024*1024;
+static const int segSize  = 8192;       // Must fit in a cms request
+
+      XrdCmsNSum();
+     ~XrdCmsNSum() {}  // Never gets deleted
+
+private:
+
+struct Filter
+      {unsigned char *Bits;
+       unsigned int    Size;
+       unsigned int    Mask;   // Size*8-1
+       unsigned int    Hashes;
+       unsigned int    Gen;
+       time_t          Stamp;  // When last installed or confirmed
+
+       void  Add(unsigned int h1, unsigned int h2);
+       bool  Test(unsigned int h1, unsigned int h2);
+
+             Filter(unsigned int sz, unsigned int nh, unsigned int gen);
+            ~Filter();
+      };
+
+static void Hash(const char *Path, int Plen, unsigned int &h1,
+                                             unsigned int &h2);
+       int  Build(Filter &fP);
+       void Send(Filter &fP, Filter *oP);
+
+// Manager side
+//
+XrdSysRWLock  fltLock;          // Protects Active
+XrdSysMutex   pndMutex;         // Protects Pending
+Filter       *Active[STMax];
+Filter       *Pending[STMax];
+
+// Server side
+//
+XrdSysCondVar sumCond;
+Filter       *Current;
+unsigned int  curGen;
+bool          doResync;
+
+int           Size;
+int           Hashes;
+int           Interval;
+};
+
+namespace XrdCms
+{
+extern    XrdCmsNSum NSum;
+}
+#endif
@@ -45,6 +45,9 @@ XrdCmsNash::XrdCmsNash(int psize, int csize)
      nashtable     = (XrdCmsKeyItem **)
                      malloc( (size_t)(csize*sizeof(XrdCmsKeyItem *)) );
      memset((void *)nashtable, 0, (size_t)(csize*sizeof(XrdCmsKeyItem *)));
+     oldtable      = 0;
+     oldtablesize  = 0;
+     oldtablenext  = 0;
 }
 
 /******************************************************************************/
@@ -58,11 +61,12 @@ XrdCmsKeyItem *XrdCmsNash::Add(XrdCmsKey &Key)
 
 // Allocate the entry
 //
-   if (!(hip = XrdCmsKeyItem::Alloc(Key.TOD))) return (XrdCmsKeyItem *)0;
+   if (!(hip = XrdCmsKeyItem::Alloc(Items, Key.TOD))) return (XrdCmsKeyItem *)0;
 
-// Check if we should expand the table
+// Check if we should expand the table, otherwise continue any expansion
 //
    if (++nashnum > Threshold) Expand();
+      else if (oldtable) Migrate(MigStep);
 
 // Fill out the key data
 //
@@ -80,12 +84,22 @@ XrdCmsKeyItem *XrdCmsNash::Add(XrdCmsKey &Key)
 /******************************************************************************/
 /* private                        E x p a n d                                 */
 /******************************************************************************/
-  
+
+// Expansion is incremental. The current table becomes the old table and its
+// buckets are moved a few at a time by subsequent table operations so that
+// no single operation pays for rehashing the whole table while holding the
+// lock. Should we need to expand again before that completes, we finish the
+// pending migration first so that there is never more than one old table.
+//
 void XrdCmsNash::Expand()
 {
-   int newsize, newent, i;
+   int newsize;
    size_t memlen;
-   XrdCmsKeyItem **newtab, *nip, *nextnip;
+   XrdCmsKeyItem **newtab;
+
+// Complete any outstanding migration
+//
+   if (oldtable) Migrate(oldtablesize);
 
 // Compute new size for table using a fibonacci series
 //
@@ -97,22 +111,11 @@ void XrdCmsNash::Expand()
    if (!(newtab = (XrdCmsKeyItem **) malloc(memlen))) return;
    memset((void *)newtab, 0, memlen);
 
-// Redistribute all of the current items
-//
-   for (i = 0; i < nashtablesize; i++)
-       {nip = nashtable[i];
-        while(nip)
-             {nextnip = nip->Next;
-              newent  = nip->Key.Hash % newsize;
-              nip->Next = newtab[newent];
-              newtab[newent] = nip;
-              nip = nextnip;
-             }
-       }
-
-// Free the old table and plug in the new table
+// The current table becomes the one to be drained
 //
-   free((void *)nashtable);
+   oldtable      = nashtable;
+   oldtablesize  = nashtablesize;
+   oldtablenext  = 0;
    nashtable     = newtab;
    prevtablesize = nashtablesize;
    nashtablesize = newsize;
@@ -120,6 +123,10 @@ void XrdCmsNash::Expand()
 // Compute new expansion threshold
 //
    Threshold = static_cast<int>((static_cast<long long>(newsize)*LoadMax)/100);
+
+// Get the migration going
+//
+   Migrate(MigStep);
 }
 
 /******************************************************************************/
@@ -135,6 +142,10 @@ XrdCmsKeyItem *XrdCmsNash::Find(XrdCmsKey &Key)
 //
    if (!Key.Hash) Key.setHash();
 
+// Continue any expansion that is in progress
+//
+   if (oldtable) Migrate(MigStep);
+
 // Compute position of the hash table entry
 //
    kent = Key.Hash%nashtablesize;
@@ -143,9 +154,54 @@ XrdCmsKeyItem *XrdCmsNash::Find(XrdCmsKey &Key)
 //
    nip = nashtable[kent];
    while(nip && nip->Key != Key) nip = nip->Next;
+
+// If not found, the entry may not yet have been moved out of the old table
+//
+   if (!nip && oldtable)
+      {kent = Key.Hash%oldtablesize;
+       if (static_cast<int>(kent) >= oldtablenext)
+          {nip = oldtable[kent];
+           while(nip && nip->Key != Key) nip = nip->Next;
+          }
+      }
    return nip;
 }
 
+/******************************************************************************/
+/* private                       M i g r a t e                                */
+/******************************************************************************/
+  
+void XrdCmsNash::Migrate(int nBuckets)
+{
+   XrdCmsKeyItem *nip, *nextnip;
+   unsigned int hval;
+   int newent;
+
+// Move the requested number of buckets from the old table to the new one.
+// Unloaded items have a zero hash but still sit in the table until they are
+// recycled; those must be placed using the hash that was saved for them.
+//
+   while(nBuckets-- && oldtablenext < oldtablesize)
+        {nip = oldtable[oldtablenext];
+         oldtable[oldtablenext++] = 0;
+         while(nip)
+              {nextnip = nip->Next;
+               hval    = (nip->Key.Hash ? nip->Key.Hash : nip->Loc.HashSave);
+               newent  = hval % nashtablesize;
+               nip->Next = nashtable[newent];
+               nashtable[newent] = nip;
+               nip = nextnip;
+              }
+        }
+
+// If all buckets have been moved, free the old table
+//
+   if (oldtablenext >= oldtablesize)
+      {free((void *)oldtable);
+       oldtable = 0; oldtablesize = 0; oldtablenext = 0;
+      }
+}
+
 /******************************************************************************/
 /* public                        R e c y c l e                                */
 /******************************************************************************/
@@ -155,9 +211,13 @@ XrdCmsKeyItem *XrdCmsNash::Find(XrdCmsKey &Key)
 //
 int XrdCmsNash::Recycle(XrdCmsKeyItem *rip)
 {
-   XrdCmsKeyItem *nip, *pip = 0;
+   XrdCmsKeyItem *nip, *pip = 0, **theTab = nashtable;
    unsigned int kent;
 
+// Continue any expansion that is in progress
+//
+   if (oldtable) Migrate(MigStep);
+
 // Compute position of the hash table entry
 //
    kent = rip->Loc.HashSave%nashtablesize;
@@ -167,12 +227,23 @@ int XrdCmsNash::Recycle(XrdCmsKeyItem *rip)
    nip = nashtable[kent];
    while(nip && nip != rip) {pip = nip; nip = nip->Next;}
 
+// If not found, the entry may still be in the old table
+//
+   if (!nip && oldtable)
+      {kent = rip->Loc.HashSave%oldtablesize;
+       if (static_cast<int>(kent) >= oldtablenext)
+          {theTab = oldtable; pip = 0;
+           nip = oldtable[kent];
+           while(nip && nip != rip) {pip = nip; nip = nip->Next;}
+          }
+      }
+
 // Remove and recycle if found
 //
    if (nip)
       {if (pip) pip->Next = nip->Next;
-          else nashtable[kent] = nip->Next;
-          rip->Recycle();
+          else theTab[kent] = nip->Next;
+          rip->Recycle(Items);
           nashnum--;
       }
    return nip != 0;
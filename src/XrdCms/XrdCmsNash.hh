@@ -41,6 +41,11 @@ XrdCmsKeyItem *Find(XrdCmsKey &Key);
 
 int            Recycle(XrdCmsKeyItem *rip);
 
+// Each table has its own pool of items which must only be manipulated while
+// holding whatever lock serializes access to the table itself.
+//
+XrdCmsKeyItem::Pool Items;
+
 // When allocateing a new nash, specify the required starting size. Make
 // sure that the previous number is the correct Fibonocci antecedent. The
 // series is simply n[j] = n[j-1] + n[j-2].
@@ -51,12 +56,17 @@ int            Recycle(XrdCmsKeyItem *rip);
 private:
 
 static const int LoadMax = 80;
+static const int MigStep = 64;  // Old buckets moved per table operation
 
 void               Expand();
+void               Migrate(int nBuckets);
 
 XrdCmsKeyItem  **nashtable;
+XrdCmsKeyItem  **oldtable;      // Table being drained after an expansion
 int              prevtablesize;
 int              nashtablesize;
+int              oldtablesize;
+int              oldtablenext;  // Next bucket in oldtable to be moved
 int              nashnum;
 int              Threshold;
 };
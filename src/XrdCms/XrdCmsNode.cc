@@ -52,8 +52,10 @@
 #include "XrdCms/XrdCmsPrepare.hh"
 #include "XrdCms/XrdCmsRRData.hh"
 #include "XrdCms/XrdCmsNode.hh"
+#include "XrdCms/XrdCmsNSum.hh"
 #include "XrdCms/XrdCmsSelect.hh"
 #include "XrdCms/XrdCmsState.hh"
+#include "XrdCms/XrdCmsStateQ.hh"
 #include "XrdCms/XrdCmsTrace.hh"
 
 #include "XrdOss/XrdOss.hh"
@@ -99,11 +101,10 @@ XrdCmsNode::XrdCmsNode(XrdLink *lnkp, const char *theIF, const char *nid,
                        int port, int lvl, int id)
 {
     static XrdSysMutex   iMutex;
-    static const SMask_t smask_1(1);
     static int           iNum = 1;
 
     Link     =  lnkp;
-    NodeMask =  (id < 0 ? 0 : smask_1 << id);
+    NodeMask =  (id < 0 ? SMask_t(0) : SMask_t::Bit(id));
     NodeID   = id;
     isOffline=  (lnkp == 0);
     logload  =  Config.LogPerf;
@@ -364,7 +365,7 @@ const char *XrdCmsNode::do_Disc(XrdCmsRRData &Arg)
 const char *XrdCmsNode::do_Gone(XrdCmsRRData &Arg)
 {
    EPNAME("do_Gone")
-   static const SMask_t allNodes(~0);
+   static const SMask_t allNodes(FULLMASK);
    int newgone;
 
 // Do some debugging
@@ -406,48 +407,127 @@ const char *XrdCmsNode::do_Gone(XrdCmsRRData &Arg)
 const char *XrdCmsNode::do_Have(XrdCmsRRData &Arg)
 {
    EPNAME("do_Have")
-   static const SMask_t allNodes(~0);
-   XrdCmsPInfo  pinfo;
-   int isnew, Opts;
 
 // Do some debugging
 //
    TRACER(Files, (Arg.Request.modifier&CmsHaveRequest::Pending ? "P ":"") 
                  <<Arg.Path);
 
+// Update path information and return if we have no managers or we already
+// informed the managers
+//
+   if (!do_HaveFile(Arg.Path, Arg.PathLen-1, Arg.Request.modifier,
+                    Arg.Request.streamid) || !XrdCmsManager::Present())
+      return 0;
+
+// Back-propogate the have to all of our managers
+//
+   XrdCmsManager::Inform(Arg.Request, Arg.Buff, Arg.Dlen);
+
+// All done
+//
+   return 0;
+}
+  
+/******************************************************************************/
+/*                           d o _ H a v e F i l e                            */
+/******************************************************************************/
+
+// Record that this node has a file. Returns true if the location is new.
+  
+int XrdCmsNode::do_HaveFile(char *Path, int Plen, int Mods, unsigned int Hash)
+{
+   static const SMask_t allNodes(FULLMASK);
+   XrdCmsPInfo  pinfo;
+   int isnew, Opts;
+
 // Find if we can handle the file in r/w mode and if staging is present
 //
-   Opts = (Cache.Paths.Find(Arg.Path, pinfo) && (pinfo.rwvec & NodeMask)
+   Opts = (Cache.Paths.Find(Path, pinfo) && (pinfo.rwvec & NodeMask)
         ? XrdCmsSelect::Write : 0);
-   if (Arg.Request.modifier & CmsHaveRequest::Pending)
-      Opts |= XrdCmsSelect::Pending;
+   if (Mods & CmsHaveRequest::Pending) Opts |= XrdCmsSelect::Pending;
 
 // Update path information. If we are exporting a shared-everything file system
 // then we need to also provide the cache the current list of nodes and how
-// they export the path in question for fast redispatch processing.
+// they export the path in question for fast redispatch processing. The node's
+// namespace summary may predate the file so it is updated as well.
 //
    if (!Config.asManager()) isnew = 1;
-      else {XrdCmsSelect Sel(XrdCmsSelect::Advisory|Opts,Arg.Path,Arg.PathLen-1);
-            Sel.Path.Hash = Arg.Request.streamid;
+      else {XrdCmsSelect Sel(XrdCmsSelect::Advisory|Opts, Path, Plen);
+            Sel.Path.Hash = Hash;
             if (baseFS.isDFS())
                {Sel.Vec.hf = pinfo.rovec; Sel.Vec.wf = pinfo.rwvec;
                 isnew       = Cache.AddFile(Sel, allNodes);
                } else isnew = Cache.AddFile(Sel, NodeMask);
+            NSum.Add(NodeID, Path, Plen);
            }
+   return isnew;
+}
+  
+/******************************************************************************/
+/*                              d o _ H a v e V                               */
+/******************************************************************************/
+  
+const char *XrdCmsNode::do_HaveV(XrdCmsRRData &Arg)
+{
+   EPNAME("do_HaveV")
+   const unsigned char *onBits, *pnBits;
+   kXR_unt32 Count;
+   long long bSent;
+   char *bP, *pP;
+   int bLen, bNum, mBytes, Plen, Mods;
+
+// Process: havev <count> <online> <pending>
+// Respond: n/a
+//
+   if (Arg.PathLen < (int)sizeof(Count)) return 0;
+   memcpy(&Count, Arg.Path, sizeof(Count));
+   Count  = ntohl(Count);
+   mBytes = (Count+7)/8;
+   if (Count > CmsStateVRequest::maxPaths
+   ||  Arg.PathLen < (int)sizeof(Count) + 2*mBytes) return 0;
+   onBits = (const unsigned char *)Arg.Path + sizeof(Count);
+   pnBits = onBits + mBytes;
+
+// Get the paths of the batch. If we no longer have them, the response is
+// too late to be of use.
+//
+   if (!(bP = StateQ.Claim(NodeID, Arg.Request.streamid, bLen, bNum, bSent))
+   ||  bNum != (int)Count)
+      {DEBUG(Ident <<" batch " <<Arg.Request.streamid <<" is stale");
+       if (bP) free(bP);
+       return 0;
+      }
 
-// Return if we have no managers or we already informed the managers
+// The time it took the node to look up the batch is its service latency
 //
-   if (!XrdCmsManager::Present() || !isnew) return 0;
+   setLatency(Microsec() - bSent);
 
-// Back-propogate the have to all of our managers
+// Record each file the node has and inform our managers as needed
 //
-   XrdCmsManager::Inform(Arg.Request, Arg.Buff, Arg.Dlen);
+   pP = bP;
+   for (int i = 0; i < bNum; i++)
+       {Plen = strlen(pP);
+        Mods = 0;
+        if (onBits[i>>3] & (1 << (i & 7))) Mods = CmsHaveRequest::Online;
+           else if (pnBits[i>>3] & (1 << (i & 7)))
+                   Mods = CmsHaveRequest::Pending;
+        if (Mods)
+           {TRACER(Files, (Mods & CmsHaveRequest::Pending ? "P " : "") <<pP);
+            if (do_HaveFile(pP, Plen, Mods, 0) && XrdCmsManager::Present())
+               {CmsRRHdr Hdr = {0, kYR_have, (kXR_char)(kYR_raw | Mods), 0};
+                XrdCmsManager::Inform(Hdr, pP, Plen+1);
+               }
+           }
+        pP += Plen+1;
+       }
 
 // All done
 //
+   free(bP);
    return 0;
 }
-  
+
 /******************************************************************************/
 /*                               d o _ L o a d                                */
 /******************************************************************************/
@@ -660,8 +740,12 @@ int XrdCmsNode::do_LocFmt(char *buff, XrdCmsSelected *sP,
    static const int Skip = (XrdCmsSelected::Disable | XrdCmsSelected::Offline);
    static const int Hung = (XrdCmsSelected::Disable | XrdCmsSelected::Offline
                          |  XrdCmsSelected::Suspend);
+// The response length must fit in the 16-bit datalen (less the leading int and
+// trailing null byte); with a large cell not every entry may fit.
+   static const int oMax = 65535 - sizeof(kXR_unt32) - 1
+                         - CmsLocateRequest::RHLen;
    XrdCmsSelected *pP;
-   char *oP = buff;
+   char *oP = buff, *oEnd = buff + oMax;
 
 // If only unique entries are wanted then we need to only let through
 // all non-servers and one server (prefereably a r/w one)
@@ -688,16 +772,18 @@ if (!lsall && lsuniq)
 //
 if (lsall)
    while(sP)
-        {*oP = (sP->Status & XrdCmsSelected::isMangr ? 'M' : 'S');
-         if (sP->Status & Hung) *oP = tolower(*oP);
-         *(oP+1) = (sP->Mask   & wfVec               ? 'w' : 'r');
-         strcpy(oP+2, sP->Ident); oP += sP->IdentLen + 2;
-         if (sP->next) *oP++ = ' ';
+        {if (oP <= oEnd)
+            {*oP = (sP->Status & XrdCmsSelected::isMangr ? 'M' : 'S');
+             if (sP->Status & Hung) *oP = tolower(*oP);
+             *(oP+1) = (sP->Mask   & wfVec               ? 'w' : 'r');
+             strcpy(oP+2, sP->Ident); oP += sP->IdentLen + 2;
+             if (sP->next) *oP++ = ' ';
+            }
          pP = sP; sP = sP->next; delete pP;
         }
    else
    while(sP)
-        {if (!(sP->Status & Skip))
+        {if (!(sP->Status & Skip) && oP <= oEnd)
             {*oP     = (sP->Status & XrdCmsSelected::isMangr ? 'M' : 'S');
              if (sP->Mask & pfVec) *oP = tolower(*oP);
              *(oP+1) = (sP->Mask   & wfVec                   ? 'w' : 'r');
@@ -786,7 +872,7 @@ const char *XrdCmsNode::do_Mkpath(XrdCmsRRData &Arg)
 const char *XrdCmsNode::do_Mv(XrdCmsRRData &Arg)
 {
    EPNAME("do_Mv")
-   static const SMask_t allNodes(~0);
+   static const SMask_t allNodes(FULLMASK);
    int rc;
 
 // Do some debugging
@@ -828,9 +914,26 @@ const char *XrdCmsNode::do_Mv(XrdCmsRRData &Arg)
    if (Config.ProgMV) rc = fsExec(Config.ProgMV, Arg.Path, Arg.Path2);
       else rc = Config.ossFS->Rename(Arg.Path, Arg.Path2);
 
-// Return appropriate result
+// Return appropriate result. The new name is no longer missing.
 //
-   return (rc ? fsFail(Arg.Ident, "mv", Arg.Path, rc) : 0);
+   if (rc) return fsFail(Arg.Ident, "mv", Arg.Path, rc);
+   baseFS.Added(Arg.Path2);
+   return 0;
+}
+
+/******************************************************************************/
+/*                               d o _ N S u m                                */
+/******************************************************************************/
+  
+// Namespace summaries come from data servers and are kept by the manager.
+//
+const char *XrdCmsNode::do_NSum(XrdCmsRRData &Arg)
+{
+// Process: nsum <gen> <base> <size> <offset> <hashes> <data>
+// Reponds: n/a
+
+   NSum.Update(NodeID, Ident, Arg);
+   return 0;
 }
 
 /******************************************************************************/
@@ -862,6 +965,9 @@ const char *XrdCmsNode::do_Pong(XrdCmsRRData &Arg)
 // Process: pong
 // Reponds: n/a
 
+// The round trip time of a ping tells us how responsive the node is
+//
+   if (pingSent) {setLatency(Microsec() - pingSent); pingSent = 0;}
    return 0;
 }
   
@@ -916,7 +1022,7 @@ const char *XrdCmsNode::do_PrepDel(XrdCmsRRData &Arg)
 const char *XrdCmsNode::do_Rm(XrdCmsRRData &Arg)
 {
    EPNAME("do_Rm")
-   static const SMask_t allNodes(~0);
+   static const SMask_t allNodes(FULLMASK);
    int rc;
 
 // Do some debugging
@@ -951,7 +1057,7 @@ const char *XrdCmsNode::do_Rm(XrdCmsRRData &Arg)
 const char *XrdCmsNode::do_Rmdir(XrdCmsRRData &Arg)
 {
    EPNAME("do_Rmdir")
-   static const SMask_t allNodes(~0);
+   static const SMask_t allNodes(FULLMASK);
    int rc;
 
 // Do some debugging
@@ -1348,7 +1454,7 @@ const char *XrdCmsNode::do_State(XrdCmsRRData &Arg)
 void XrdCmsNode::do_StateDFS(XrdCmsBaseFR *rP, int rc)
 {
    EPNAME("StateDFs");
-   static const SMask_t allNodes(~0);
+   static const SMask_t allNodes(FULLMASK);
    CmsRRHdr Request = {rP->Sid, 0, (kXR_char)(rP->Mod | kYR_raw), 0};
    XrdCmsSelect Sel(0, rP->Path, rP->PathLen);
    int isNew;
@@ -1401,7 +1507,7 @@ void XrdCmsNode::do_StateDFS(XrdCmsBaseFR *rP, int rc)
 int XrdCmsNode::do_StateFWD(XrdCmsRRData &Arg)
 {
    EPNAME("do_StateFWD");
-   static const SMask_t allNodes(~0);
+   static const SMask_t allNodes(FULLMASK);
    XrdCmsSelect Sel(0, Arg.Path, Arg.PathLen-1);
    XrdCmsPInfo  pinfo;
    int retc;
@@ -1472,6 +1578,72 @@ int XrdCmsNode::do_StateFWD(XrdCmsRRData &Arg)
                         return 0;
 }
 
+/******************************************************************************/
+/*                             d o _ S t a t e V                              */
+/******************************************************************************/
+  
+const char *XrdCmsNode::do_StateV(XrdCmsRRData &Arg)
+{
+   EPNAME("do_StateV")
+   unsigned char Bits[2*CmsStateVRequest::maxPaths/8];
+   char *Path[CmsStateVRequest::maxPaths];
+   int   Plen[CmsStateVRequest::maxPaths], Rslt[CmsStateVRequest::maxPaths];
+   struct iovec xmsg[3];
+   kXR_unt32 Count;
+   char *pP = Arg.Path, *pEnd = Arg.Path + Arg.PathLen;
+   int i, mBytes, n = 0;
+   bool haveAny = false;
+
+// Process: statev <path> [<path> [...]]
+// Respond: havev <count> <online> <pending>
+//
+   isKnown = 1;
+
+// Batches are only sent to data servers. Check each path just as we would
+// for a single state request, noting online files in the first half of the
+// bit vector and pending ones in the second half. The lookups are done in
+// parallel as the paths are independent of each other.
+//
+   if (isMan || (!Config.DiskOK && !Config.asProxy())) return 0;
+   while(pP < pEnd && n < CmsStateVRequest::maxPaths)
+        {if ((Plen[n] = strnlen(pP, pEnd - pP)) >= pEnd - pP) break;
+         Path[n] = pP; pP += Plen[n]+1; n++;
+        }
+   baseFS.ExistsV(Path, Plen, Rslt, n);
+
+   memset(Bits, 0, sizeof(Bits));
+   for (i = 0; i < n; i++)
+       {if (Rslt[i] <= 0) continue;
+        if (Rslt[i] == CmsHaveRequest::Pending)
+                Bits[sizeof(Bits)/2 + (i>>3)] |= 1 << (i & 7);
+           else Bits[i>>3]                    |= 1 << (i & 7);
+        haveAny = true;
+       }
+   DEBUG(n <<" paths in batch " <<Arg.Request.streamid
+           <<(haveAny ? " responding havev!" : ""));
+
+// Respond only if we have any of the files. The two bit vectors are sent
+// back to back, each just long enough for the number of paths.
+//
+   if (haveAny)
+      {mBytes = (n+7)/8;
+       memmove(Bits+mBytes, Bits+sizeof(Bits)/2, mBytes);
+       Count  = htonl(static_cast<kXR_unt32>(n));
+       xmsg[0].iov_base      = (char *)&Arg.Request;
+       xmsg[0].iov_len       = sizeof(Arg.Request);
+       xmsg[1].iov_base      = (char *)&Count;
+       xmsg[1].iov_len       = sizeof(Count);
+       xmsg[2].iov_base      = (char *)Bits;
+       xmsg[2].iov_len       = 2*mBytes;
+       Arg.Request.rrCode    = kYR_havev;
+       Arg.Request.modifier  = kYR_raw;
+       Arg.Request.datalen   = htons(static_cast<unsigned short>
+                                    (sizeof(Count) + 2*mBytes));
+       Link->Send(xmsg, 3);
+      }
+   return 0;
+}
+  
 /******************************************************************************/
 /*                             d o _ S t a t F S                              */
 /******************************************************************************/
@@ -1743,6 +1915,40 @@ const char *XrdCmsNode::do_Usage(XrdCmsRRData &Arg)
    return 0;
 }
 
+/******************************************************************************/
+/*                              M i c r o s e c                               */
+/******************************************************************************/
+
+// Returns a monotonic time in microseconds used to measure service latency.
+//
+long long XrdCmsNode::Microsec()   // Static!
+{
+   struct timespec tNow;
+
+   clock_gettime(CLOCK_MONOTONIC, &tNow);
+   return static_cast<long long>(tNow.tv_sec)*1000000 + tNow.tv_nsec/1000;
+}
+
+/******************************************************************************/
+/*                             R e d i r e c t s                              */
+/******************************************************************************/
+
+// Returns the number of redirects to this node during the current and previous
+// second, counting a new one if so wanted. The counters are not locked as an
+// approximate value is all that selection needs.
+//
+int XrdCmsNode::Redirects(int tNow, bool isNew)
+{
+   int tSec = rdrSec;
+
+   if (tSec != tNow)
+      {rdrPrv = (tNow - tSec == 1 ? int(rdrNow) : 0);
+       rdrNow = 0; rdrSec = tNow;
+      }
+   if (isNew) rdrNow++;
+   return rdrNow + rdrPrv;
+}
+
 /******************************************************************************/
 /*                          R e p o r t _ U s a g e                           */
 /******************************************************************************/
@@ -1784,6 +1990,21 @@ void XrdCmsNode::Report_Usage(XrdLink *lp)   // Static!
       <<" mem=" <<pmem <<" pag=" <<ppag <<" dsk=" <<pdsk <<' ' <<maxfr);
 }
   
+/******************************************************************************/
+/*                            s e t L a t e n c y                             */
+/******************************************************************************/
+
+// Folds a service time into the node's latency average (weight 1/8).
+//
+void XrdCmsNode::setLatency(long long usec)
+{
+   int oldAvg = latAvg, newVal;
+
+   if (usec < 1) usec = 1;
+   newVal = (usec > 60000000 ? 60000000 : static_cast<int>(usec));
+   latAvg = (oldAvg ? oldAvg + (newVal - oldAvg)/8 : newVal);
+}
+  
 /******************************************************************************/
 /*                             S y n c S p a c e                              */
 /******************************************************************************/
@@ -36,6 +36,7 @@
 #include <sys/uio.h>
   
 #include "Xrd/XrdLink.hh"
+#include "XrdCms/XrdCmsBcast.hh"
 #include "XrdCms/XrdCmsTypes.hh"
 #include "XrdCms/XrdCmsRRQ.hh"
 #include "XrdNet/XrdNetIF.hh"
@@ -56,6 +57,7 @@ class XrdOucProg;
 
 class XrdCmsNode
 {
+friend class XrdCmsBcast;
 friend class XrdCmsCluster;
 public:
        char  *Ident     = 0; // -> role hostname
@@ -96,6 +98,8 @@ const  char  *do_Chmod(XrdCmsRRData &Arg);
 const  char  *do_Disc(XrdCmsRRData &Arg);
 const  char  *do_Gone(XrdCmsRRData &Arg);
 const  char  *do_Have(XrdCmsRRData &Arg);
+       int    do_HaveFile(char *Path, int Plen, int Mods, unsigned int Hash);
+const  char  *do_HaveV(XrdCmsRRData &Arg);
 const  char  *do_Load(XrdCmsRRData &Arg);
 const  char  *do_Locate(XrdCmsRRData &Arg);
 static int    do_LocFmt(char *buff, XrdCmsSelected *sP,
@@ -104,6 +108,7 @@ static int    do_LocFmt(char *buff, XrdCmsSelected *sP,
 const  char  *do_Mkdir(XrdCmsRRData &Arg);
 const  char  *do_Mkpath(XrdCmsRRData &Arg);
 const  char  *do_Mv(XrdCmsRRData &Arg);
+const  char  *do_NSum(XrdCmsRRData &Arg);
 const  char  *do_Ping(XrdCmsRRData &Arg);
 const  char  *do_Pong(XrdCmsRRData &Arg);
 const  char  *do_PrepAdd(XrdCmsRRData &Arg);
@@ -118,6 +123,7 @@ const  char  *do_Space(XrdCmsRRData &Arg);
 const  char  *do_State(XrdCmsRRData &Arg);
 static void   do_StateDFS(XrdCmsBaseFR *rP, int rc);
        int    do_StateFWD(XrdCmsRRData &Arg);
+const  char  *do_StateV(XrdCmsRRData &Arg);
 const  char  *do_StatFS(XrdCmsRRData &Arg);
 const  char  *do_Stats(XrdCmsRRData &Arg);
 const  char  *do_Status(XrdCmsRRData &Arg);
@@ -138,6 +144,8 @@ const  char  *do_Usage(XrdCmsRRData &Arg);
 
 inline int    ID(int &INum) {INum = Instance; return NodeID;}
 
+inline int    Latency() {return latAvg;}
+
 inline int    Inst() {return Instance;}
 
        bool   inDomain() {return netIF.InDomain(&netID);}
@@ -179,6 +187,8 @@ inline void  UnLock() {nodeMutex.UnLock(); refCnt--;}
 inline void    Ref() {refCnt++;} // Must have global or node locked!
 inline void  unRef() {refCnt--;}
 
+       int   Redirects(int tNow, bool isNew=false);
+
 static void  Report_Usage(XrdLink *lp);
 
 inline int   Send(const char *buff, int blen=0)
@@ -188,8 +198,12 @@ inline int   Send(const struct iovec *iov, int iovcnt, int iotot=0)
 
        void  setManager(XrdCmsManager *mP) {Manager = mP;}
 
+       void  setLatency(long long usec);
+
        void  setName(XrdLink *lnkp, const char *theIF, int port);
 
+inline void  setPing() {if (!pingSent) pingSent = Microsec();}
+
        void  setShare(int shrval)
                      {if (shrval > 99) Shrem = Shrip = Share = 0;
                          else {Shrem = Share = shrval; Shrip = 100 - shrval;}
@@ -209,6 +223,8 @@ inline short getSlot() {return RSlot;}
 
 inline void  ShowIF() {netIF.Display("=====> ");}
 
+static long long Microsec();
+
        void  SyncSpace();
 
              XrdCmsNode(XrdLink *lnkp, const char *theIF=0, const char *sid=0,
@@ -263,6 +279,18 @@ RAtomic_char       Shrin{0};     // Share intervals used
 char               Shrip    = 0; // Share of requests to skip (set once)
 char               Rsvd[3];
 
+// The following fields are used by latency-aware selection
+//
+long long          pingSent = 0; // When the last ping was sent (microseconds)
+RAtomic_int        latAvg{0};    // Smoothed service latency in microseconds
+RAtomic_int        rdrNow{0};    // Redirects during the current second
+RAtomic_int        rdrPrv{0};    // Redirects during the previous second
+RAtomic_int        rdrSec{0};    // The second rdrNow applies to
+
+// The following field is used by the broadcast writer (protected by its lock)
+//
+XrdCmsBcast::Queue bcQ;
+
 // The following fields are used to keep the supervisor's free space value
 //
 static XrdSysMutex mlMutex;
@@ -1231,6 +1231,7 @@ bool XrdCmsProtocol::SendPing()
 // Send the ping
 //
    if (Link->Send((char *)&Ping, sizeof(Ping)) < 0) return false;
+   myNode->setPing();
    return true;
 }
   
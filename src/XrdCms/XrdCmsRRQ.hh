@@ -50,10 +50,10 @@ void     *Key;     // Key link, which is the cache line address
 kXR_unt32 ID;      // Response link, which is the request ID
 int       Rinst;   // Redirector instance
 short     Rnum;    // Redirector number (RTable slot number)
+short     minR;    // Minimum number of responses for fast redispatch
+short     actR;    // Actual  number of responses
 char      isRW;    // True if r/w access wanted
 char      isLU;    // True if locate response wanted
-char      minR;    // Minimum number of responses for fast redispatch
-char      actR;    // Actual  number of responses
 char      lsLU;    // Lookup options
 char      ifOP;    // XrdNetIF::ifType to return (cast as char)
 SMask_t   rwVec;   // R/W servers for corresponding path (if isLU is true)
@@ -61,7 +61,7 @@ SMask_t   rwVec;   // R/W servers for corresponding path (if isLU is true)
         XrdCmsRRQInfo() : isLU(0), ifOP(0) {}
         XrdCmsRRQInfo(int rinst, short rnum, kXR_unt32 id, int minQ=0)
                         : Key(0), ID(id), Rinst(rinst), Rnum(rnum),
-                          isRW(0), isLU(0), minR(minQ), actR(0), lsLU(0), ifOP(0),
+                          minR(minQ), actR(0), isRW(0), isLU(0), lsLU(0), ifOP(0),
                           rwVec(0) {}
        ~XrdCmsRRQInfo() {}
 };
@@ -62,11 +62,14 @@ XrdCmsRouter::theRoute initRouter[] =
        {kYR_disc,    "disc",   &XrdCmsNode::do_Disc},
        {kYR_gone,    "gone",   &XrdCmsNode::do_Gone},
        {kYR_have,    "have",   &XrdCmsNode::do_Have},
+       {kYR_havev,   "havev",  &XrdCmsNode::do_HaveV},
        {kYR_load,    "load",   &XrdCmsNode::do_Load},
+       {kYR_nsum,    "nsum",   &XrdCmsNode::do_NSum},
        {kYR_ping,    "ping",   &XrdCmsNode::do_Ping},
        {kYR_pong,    "pong",   &XrdCmsNode::do_Pong},
        {kYR_space,   "space",  &XrdCmsNode::do_Space},
        {kYR_state,   "state",  &XrdCmsNode::do_State},
+       {kYR_statev,  "statev", &XrdCmsNode::do_StateV},
        {kYR_status,  "status", &XrdCmsNode::do_Status},
        {kYR_try,     "try",    &XrdCmsNode::do_Try},
        {kYR_update,  "update", &XrdCmsNode::do_Update},
@@ -156,7 +159,9 @@ XrdCmsRouting::theRouting initRSProuting[] =
       {kYR_disc,    XrdCmsRouting::isSync | XrdCmsRouting::noArgs},
       {kYR_gone,    XrdCmsRouting::isSync},
       {kYR_have,    XrdCmsRouting::AsyncQ0},
+      {kYR_havev,   XrdCmsRouting::AsyncQ0},
       {kYR_load,    XrdCmsRouting::isSync},
+      {kYR_nsum,    XrdCmsRouting::isSync},
       {kYR_pong,    XrdCmsRouting::isSync | XrdCmsRouting::noArgs},
       {kYR_status,  XrdCmsRouting::isSync | XrdCmsRouting::noArgs},
       {0,           0}};
@@ -185,6 +190,7 @@ XrdCmsRouting::theRouting initSRVrouting[] =
       {kYR_rmdir,   XrdCmsRouting::AsyncQ1},
       {kYR_space,   XrdCmsRouting::isSync  | XrdCmsRouting::noArgs},
       {kYR_state,   XrdCmsRouting::AsyncQ0},
+      {kYR_statev,  XrdCmsRouting::AsyncQ0},
       {kYR_stats,   XrdCmsRouting::AsyncQ0 | XrdCmsRouting::noArgs},
       {kYR_trunc,   XrdCmsRouting::AsyncQ1},
       {kYR_try,     XrdCmsRouting::isSync},
@@ -0,0 +1,194 @@
+#ifndef __XRDCMSSMASK__H
+#define __XRDCMSSMASK__H
+/******************************************************************************/
+/*                                                                            */
+/*                        X r d C m s S M a s k . h h                         */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+//-----------------------------------------------------------------------------
+//! XrdCmsSMask is a fixed width bit vector with one bit per node slot. It
+//! replaces the single 64-bit word formerly used so that a cell may have more
+//! than 64 subscribers. All operations are simple loops over a small fixed
+//! number of words so the compiler can unroll and vectorize them. The value
+//! semantics are those of an unsigned integer of Bits bits with the exception
+//! that shifts and arithmetic are not supported; use the member functions.
+//-----------------------------------------------------------------------------
+
+template<int Bits>
+class XrdCmsSMask
+{
+public:
+
+static const int maxBits = Bits;
+
+//-----------------------------------------------------------------------------
+//! Count the number of bits set.
+//-----------------------------------------------------------------------------
+
+inline int  Count() const
+                 {int n = 0;
+                  for (int i = 0; i < Words; i++) n += Pop(mVec[i]);
+                  return n;
+                 }
+
+//-----------------------------------------------------------------------------
+//! Return the index of the first bit set at or after a bit position.
+//!
+//! @param  bit  - The bit position at which to start the search.
+//!
+//! @return >= 0 the index of the bit, -1 if there are no more bits set.
+//-----------------------------------------------------------------------------
+
+inline int  First(int bit=0) const
+                 {int i = bit >> 6;
+                  if (i >= Words) return -1;
+                  unsigned long long w = mVec[i] & (~0ULL << (bit & 63));
+                  while(!w) {if (++i >= Words) return -1; w = mVec[i];}
+                  return (i << 6) + Ctz(w);
+                 }
+
+//-----------------------------------------------------------------------------
+//! Check if more than one bit is set.
+//-----------------------------------------------------------------------------
+
+inline bool Multiple() const
+                 {bool one = false;
+                  for (int i = 0; i < Words; i++)
+                      if (mVec[i])
+                         {if (one || (mVec[i] & (mVec[i]-1))) return true;
+                          one = true;
+                         }
+                  return false;
+                 }
+
+//-----------------------------------------------------------------------------
+//! Set, clear or test an individual bit.
+//-----------------------------------------------------------------------------
+
+inline void Set(int bit)   {mVec[bit >> 6] |=  (1ULL << (bit & 63));}
+
+inline void Clr(int bit)   {mVec[bit >> 6] &= ~(1ULL << (bit & 63));}
+
+inline bool Test(int bit) const
+                 {return (mVec[bit >> 6] & (1ULL << (bit & 63))) != 0;}
+
+//-----------------------------------------------------------------------------
+//! Return a mask with a single bit set.
+//-----------------------------------------------------------------------------
+
+static
+inline XrdCmsSMask Bit(int bit) {XrdCmsSMask m; m.Set(bit); return m;}
+
+//-----------------------------------------------------------------------------
+//! Operators
+//-----------------------------------------------------------------------------
+
+inline XrdCmsSMask &operator&=(const XrdCmsSMask &rhs)
+                   {for (int i = 0; i < Words; i++) mVec[i] &= rhs.mVec[i];
+                    return *this;
+                   }
+
+inline XrdCmsSMask &operator|=(const XrdCmsSMask &rhs)
+                   {for (int i = 0; i < Words; i++) mVec[i] |= rhs.mVec[i];
+                    return *this;
+                   }
+
+inline XrdCmsSMask &operator^=(const XrdCmsSMask &rhs)
+                   {for (int i = 0; i < Words; i++) mVec[i] ^= rhs.mVec[i];
+                    return *this;
+                   }
+
+inline XrdCmsSMask  operator&(const XrdCmsSMask &rhs) const
+                   {XrdCmsSMask m(*this); return m &= rhs;}
+
+inline XrdCmsSMask  operator|(const XrdCmsSMask &rhs) const
+                   {XrdCmsSMask m(*this); return m |= rhs;}
+
+inline XrdCmsSMask  operator^(const XrdCmsSMask &rhs) const
+                   {XrdCmsSMask m(*this); return m ^= rhs;}
+
+inline XrdCmsSMask  operator~() const
+                   {XrdCmsSMask m;
+                    for (int i = 0; i < Words; i++) m.mVec[i] = ~mVec[i];
+                    return m;
+                   }
+
+inline bool         operator==(const XrdCmsSMask &rhs) const
+                   {unsigned long long d = 0;
+                    for (int i = 0; i < Words; i++) d |= mVec[i] ^ rhs.mVec[i];
+                    return d == 0;
+                   }
+
+inline bool         operator!=(const XrdCmsSMask &rhs) const
+                   {return !(*this == rhs);}
+
+inline bool         operator!() const
+                   {unsigned long long d = 0;
+                    for (int i = 0; i < Words; i++) d |= mVec[i];
+                    return d == 0;
+                   }
+
+explicit inline     operator bool() const {return !!*this;}
+
+//-----------------------------------------------------------------------------
+//! Constructor. An integer value initializes the low order 64 bits, which
+//! allows the customary "mask = 0" idiom. Use ~SMask_t(0) for all ones.
+//-----------------------------------------------------------------------------
+
+                    XrdCmsSMask(unsigned long long v=0)
+                               {mVec[0] = v;
+                                for (int i = 1; i < Words; i++) mVec[i] = 0;
+                               }
+
+private:
+
+static const int Words = (Bits + 63) / 64;
+
+static inline int Ctz(unsigned long long w)
+                     {
+#if defined(__GNUC__)
+                      return __builtin_ctzll(w);
+#else
+                      int n = 0;
+                      while(!(w & 1)) {w >>= 1; n++;}
+                      return n;
+#endif
+                     }
+
+static inline int Pop(unsigned long long w)
+                     {
+#if defined(__GNUC__)
+                      return __builtin_popcountll(w);
+#else
+                      int n = 0;
+                      while(w) {w &= (w - 1); n++;}
+                      return n;
+#endif
+                     }
+
+unsigned long long mVec[Words];
+};
+#endif
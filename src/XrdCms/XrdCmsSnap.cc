@@ -0,0 +1,588 @@
+/******************************************************************************/
+/*                                                                            */
+/*                         X r d C m s S n a p . c c                          */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "XrdCms/XrdCmsCache.hh"
+#include "XrdCms/XrdCmsKey.hh"
+#include "XrdCms/XrdCmsSnap.hh"
+#include "XrdCms/XrdCmsTrace.hh"
+#include "XrdSys/XrdSysError.hh"
+#include "XrdSys/XrdSysTimer.hh"
+
+using namespace XrdCms;
+
+/******************************************************************************/
+/*                               G l o b a l s                                */
+/******************************************************************************/
+
+       XrdCmsSnap    XrdCms::Snap;
+
+namespace
+{
+// The snapshot file is laid out as the header followed by the node table,
+// the entries, the open addressed hash table of entry numbers (0 is empty)
+// and the string pool. Offsets are from the start of the file and all
+// values are in host byte order; a file from a different architecture is
+// simply ignored.
+//
+static const char     snapMagic[8] = {'X','r','d','C','m','s','S','n'};
+static const uint32_t snapVersion  = 1;
+static const uint32_t snapEndian   = 0x01020304;
+
+struct SnapHdr
+      {char     Magic[8];
+       uint32_t Version;
+       uint32_t Endian;
+       int64_t  Time;       // When the snapshot was taken
+       uint32_t numNodes;   // Always STMax
+       uint32_t numEnts;
+       uint32_t numSlots;   // Always a power of two
+       uint32_t strSize;
+       uint64_t nodeOff;    // uint32_t[numNodes] system ID offsets (0 = none)
+       uint64_t entOff;
+       uint64_t slotOff;
+       uint64_t strOff;
+       uint64_t fileSize;
+      };
+
+bool WriteAll(int fd, const void *buff, size_t blen)
+{
+   const char *bP = (const char *)buff;
+   ssize_t rc;
+
+   while(blen)
+        {if ((rc = write(fd, bP, blen)) < 0)
+            {if (errno == EINTR) continue;
+             return false;
+            }
+         bP += rc; blen -= rc;
+        }
+   return true;
+}
+}
+
+/******************************************************************************/
+/*            E x t e r n a l   T h r e a d   I n t e r f a c e s             */
+/******************************************************************************/
+
+namespace
+{
+void *SnapRun(void *carg)
+      {XrdCmsSnap *sp = (XrdCmsSnap *)carg;
+       return sp->Keeper();
+      }
+}
+
+/******************************************************************************/
+/*                           C o n s t r u c t o r                            */
+/******************************************************************************/
+
+XrdCmsSnap::XrdCmsSnap() : mapBase(0), mapSize(0), mapEnts(0), mapSlots(0),
+                           mapStrs(0), mapNEnt(0), mapSMask(0), mapStrSz(0),
+                           mapEnd(0), sPath(0), Interval(300), maxAge(900),
+                           Life(0)
+{
+   for (int i = 0; i < STMax; i++)
+       {mapNode[i] = -1; mapNID[i] = 0; curNID[i] = 0;}
+}
+
+/******************************************************************************/
+/*                                   A d d                                    */
+/******************************************************************************/
+
+void XrdCmsSnap::Add(XrdCmsKey &Key, time_t Born, SMask_t hfVec)
+{
+   Append(Key.Hash, Key.Val, strlen(Key.Val), Born, hfVec);
+}
+
+/******************************************************************************/
+/*                                A t t a c h                                 */
+/******************************************************************************/
+
+void XrdCmsSnap::Attach(int slot, const char *nid)
+{
+   if (!sPath || slot < 0 || slot >= STMax) return;
+
+// Record the node and, if it was in the previous snapshot, make its locations
+// usable again under its new slot.
+//
+   mapLock.WriteLock();
+   if (curNID[slot]) free(curNID[slot]);
+   curNID[slot] = strdup(nid);
+   if (mapBase)
+      for (int i = 0; i < STMax; i++)
+          if (mapNID[i] && !strcmp(mapNID[i], nid)) mapNode[i] = slot;
+   mapLock.UnLock();
+}
+
+/******************************************************************************/
+/*                                D e t a c h                                 */
+/******************************************************************************/
+
+void XrdCmsSnap::Detach(int slot)
+{
+   if (!sPath || slot < 0 || slot >= STMax) return;
+
+   mapLock.WriteLock();
+   if (curNID[slot]) {free(curNID[slot]); curNID[slot] = 0;}
+   for (int i = 0; i < STMax; i++) if (mapNode[i] == slot) mapNode[i] = -1;
+   mapLock.UnLock();
+}
+
+/******************************************************************************/
+/*                                  F i n d                                   */
+/******************************************************************************/
+
+bool XrdCmsSnap::Find(XrdCmsKey &Key, SMask_t &hfVec, time_t &Born)
+{
+   Entry *eP;
+   time_t Now = time(0);
+
+// Quick check if there is anything to look at
+//
+   if (!mapBase) return false;
+   hfVec = 0;
+
+// Find the entry and translate its locations to the current slots
+//
+   mapLock.ReadLock();
+   if (mapBase && Now < mapEnd && (eP = Lookup(Key))
+   &&  !(eP->Flags & isDead) && eP->Born + Life > Now)
+      {hfVec = Remap(eP);
+       Born  = static_cast<time_t>(eP->Born);
+      }
+   mapLock.UnLock();
+   return !!hfVec;
+}
+
+/******************************************************************************/
+/*                                K e e p e r                                 */
+/******************************************************************************/
+
+void *XrdCmsSnap::Keeper()
+{
+
+// Take a snapshot every interval and discard the previous one once none of
+// its entries can be used any longer.
+//
+   do {XrdSysTimer::Snooze(Interval);
+       if (mapBase && time(0) >= mapEnd) Unload();
+       Save();
+      } while(1);
+
+// Keep compiler happy
+//
+   return (void *)0;
+}
+
+/******************************************************************************/
+/*                                  K i l l                                   */
+/******************************************************************************/
+
+void XrdCmsSnap::Kill(XrdCmsKey &Key)
+{
+   Entry *eP;
+
+   if (!mapBase) return;
+
+   mapLock.WriteLock();
+   if (mapBase && (eP = Lookup(Key))) eP->Flags |= isDead;
+   mapLock.UnLock();
+}
+
+/******************************************************************************/
+/*                              s e t P a r m s                               */
+/******************************************************************************/
+
+void XrdCmsSnap::setParms(const char *path, int intv, int mAge)
+{
+   if (sPath) free(sPath);
+   sPath    = (path ? strdup(path) : 0);
+   Interval = intv;
+   maxAge   = mAge;
+}
+
+/******************************************************************************/
+/*                                 S t a r t                                  */
+/******************************************************************************/
+
+int XrdCmsSnap::Start(int cLife)
+{
+   pthread_t tid;
+
+// Map the previous snapshot so that it is available as soon as nodes log in
+//
+   Life = cLife;
+   Load();
+
+// Start the thread that periodically takes a snapshot
+//
+   if (XrdSysThread::Run(&tid, SnapRun, (void *)this, 0, "Cache snapshot"))
+      {Say.Emsg("Snap", errno, "start cache snapshot thread");
+       return 0;
+      }
+   return 1;
+}
+
+/******************************************************************************/
+/*                       P r i v a t e   M e t h o d s                        */
+/******************************************************************************/
+/******************************************************************************/
+/*                                A p p e n d                                 */
+/******************************************************************************/
+
+void XrdCmsSnap::Append(uint32_t Hash, const char *Path, size_t Plen,
+                        time_t Born, SMask_t hfVec)
+{
+   Entry ent;
+
+// Offsets are 32 bits; an impossibly large cache is simply truncated
+//
+   if (bldStrs.size() + Plen >= 0xffff0000) return;
+
+// Fill out the entry
+//
+   memset(&ent, 0, sizeof(ent));
+   ent.Hash    = Hash;
+   ent.pathOff = bldStrs.size();
+   ent.pathLen = Plen;
+   ent.Born    = Born;
+   for (int i = hfVec.First(); i >= 0; i = hfVec.First(i+1))
+       ent.hfVec[i >> 6] |= 1ULL << (i & 63);
+
+// Record it
+//
+   bldStrs.append(Path, Plen+1);
+   bldEnts.push_back(ent);
+}
+
+/******************************************************************************/
+/*                                 C a r r y                                  */
+/******************************************************************************/
+
+// Entries of the previous snapshot that have not been looked up since the
+// restart are not in the cache. Carry them forward, as long as they are still
+// usable, so that a second restart in quick succession loses nothing.
+
+void XrdCmsSnap::Carry()
+{
+   std::vector<uint32_t> Idx(bldEnts.size());
+   std::vector<uint32_t>::iterator iP;
+   SMask_t hVec;
+   Entry *eP;
+   const char *Path;
+   time_t Now = time(0);
+   uint32_t nBld = bldEnts.size();
+   bool isDup;
+
+// Order what we already have by hash so duplicates can be quickly found
+//
+   for (uint32_t i = 0; i < nBld; i++) Idx[i] = i;
+   std::sort(Idx.begin(), Idx.end(), [this](uint32_t a, uint32_t b)
+                                 {return bldEnts[a].Hash < bldEnts[b].Hash;});
+
+// Add each usable entry not already present
+//
+   mapLock.ReadLock();
+   if (mapBase && Now < mapEnd)
+      for (uint32_t n = 0; n < mapNEnt; n++)
+          {eP = &mapEnts[n];
+           if ((eP->Flags & isDead) || eP->Born + Life <= Now
+           ||  eP->pathOff >= mapStrSz
+           ||  eP->pathLen >= mapStrSz - eP->pathOff
+           ||  mapStrs[eP->pathOff + eP->pathLen]
+           ||  !(hVec = Remap(eP))) continue;
+           Path = mapStrs + eP->pathOff;
+           iP = std::lower_bound(Idx.begin(), Idx.end(), eP->Hash,
+                                 [this](uint32_t a, uint32_t h)
+                                       {return bldEnts[a].Hash < h;});
+           for (isDup = false; iP != Idx.end()
+                            && bldEnts[*iP].Hash == eP->Hash; ++iP)
+               if (!strcmp(bldStrs.data() + bldEnts[*iP].pathOff, Path))
+                  {isDup = true; break;}
+           if (!isDup) Append(eP->Hash, Path, eP->pathLen,
+                              static_cast<time_t>(eP->Born), hVec);
+          }
+   mapLock.UnLock();
+}
+
+/******************************************************************************/
+/*                                  L o a d                                   */
+/******************************************************************************/
+
+void XrdCmsSnap::Load()
+{
+   SnapHdr *hP;
+   struct stat Stat;
+   const char *eTxt = 0;
+   char *mP, buff[80];
+   uint32_t *nidOff;
+   time_t Now = time(0);
+   int fd;
+
+// Open and map the previous snapshot. It is mapped private and writable so
+// that entries can be invalidated in memory (see Kill()).
+//
+   if ((fd = open(sPath, O_RDONLY)) < 0)
+      {if (errno != ENOENT) Say.Emsg("Snap", errno, "open snapshot", sPath);
+       return;
+      }
+   if (fstat(fd, &Stat) || Stat.st_size < (off_t)sizeof(SnapHdr))
+      {Say.Emsg("Snap", "Ignoring invalid snapshot", sPath);
+       close(fd);
+       return;
+      }
+   mP = (char *)mmap(0, Stat.st_size, PROT_READ|PROT_WRITE, MAP_PRIVATE, fd, 0);
+   close(fd);
+   if (mP == MAP_FAILED)
+      {Say.Emsg("Snap", errno, "map snapshot", sPath); return;}
+
+// Validate the header so that a damaged file can never be used
+//
+   hP = (SnapHdr *)mP;
+        if (memcmp(hP->Magic, snapMagic, sizeof(snapMagic))
+        ||  hP->Version != snapVersion || hP->Endian != snapEndian
+        ||  hP->numNodes != STMax)
+           eTxt = "Ignoring incompatible snapshot";
+   else if (hP->fileSize != (uint64_t)Stat.st_size
+        ||  hP->nodeOff + STMax*sizeof(uint32_t)           > hP->fileSize
+        ||  hP->entOff  + hP->numEnts*sizeof(Entry)        > hP->fileSize
+        ||  hP->slotOff + hP->numSlots*sizeof(uint32_t)    > hP->fileSize
+        ||  hP->strOff  + hP->strSize                      > hP->fileSize
+        ||  (hP->nodeOff & 3) || (hP->entOff & 7) || (hP->slotOff & 3)
+        ||  !hP->strSize || hP->numSlots <= hP->numEnts
+        ||  (hP->numSlots & (hP->numSlots-1))
+        ||  mP[hP->strOff + hP->strSize - 1])
+           eTxt = "Ignoring invalid snapshot";
+   else if (Now - hP->Time > maxAge || hP->Time + Life <= Now)
+           eTxt = "Ignoring stale snapshot";
+   if (eTxt)
+      {Say.Emsg("Snap", eTxt, sPath);
+       munmap(mP, Stat.st_size);
+       return;
+      }
+
+// Establish the snapshot
+//
+   mapLock.WriteLock();
+   mapBase  = mP;
+   mapSize  = Stat.st_size;
+   mapEnts  = (Entry    *)(mP + hP->entOff);
+   mapSlots = (uint32_t *)(mP + hP->slotOff);
+   mapStrs  = mP + hP->strOff;
+   mapNEnt  = hP->numEnts;
+   mapSMask = hP->numSlots - 1;
+   mapStrSz = hP->strSize;
+   mapEnd   = static_cast<time_t>(hP->Time) + Life;
+   nidOff   = (uint32_t *)(mP + hP->nodeOff);
+   for (int i = 0; i < STMax; i++)
+       if (nidOff[i] && nidOff[i] < mapStrSz)
+          mapNID[i] = strdup(mapStrs + nidOff[i]);
+   mapLock.UnLock();
+
+// Document what we have
+//
+   snprintf(buff, sizeof(buff), "%u locations taken %d seconds ago from",
+            mapNEnt, static_cast<int>(Now - hP->Time));
+   Say.Emsg("Snap", "Using", buff, sPath);
+}
+
+/******************************************************************************/
+/*                                L o o k u p                                 */
+/******************************************************************************/
+
+// Caller must hold mapLock and have verified that a snapshot is mapped.
+
+XrdCmsSnap::Entry *XrdCmsSnap::Lookup(XrdCmsKey &Key)
+{
+   Entry *eP;
+   uint32_t n, i;
+
+   if (!Key.Hash) Key.setHash();
+   i = Key.Hash & mapSMask;
+
+// Probe the table. The probe count is bounded in case the table is damaged.
+//
+   for (uint32_t k = 0; k <= mapSMask && (n = mapSlots[i]); k++)
+       {if (n <= mapNEnt)
+           {eP = &mapEnts[n-1];
+            if (eP->Hash == Key.Hash && eP->pathOff < mapStrSz
+            &&  eP->pathLen < mapStrSz - eP->pathOff
+            &&  !mapStrs[eP->pathOff + eP->pathLen]
+            &&  !strcmp(mapStrs + eP->pathOff, Key.Val)) return eP;
+           }
+        i = (i+1) & mapSMask;
+       }
+   return 0;
+}
+
+/******************************************************************************/
+/*                                 R e m a p                                  */
+/******************************************************************************/
+
+// Caller must hold mapLock. Locations on nodes that have not yet logged in
+// since the restart are omitted.
+
+SMask_t XrdCmsSnap::Remap(Entry *eP)
+{
+   SMask_t hVec(0);
+   uint64_t w;
+   int j;
+
+   for (int i = 0; i < STMax; i += 64)
+       if ((w = eP->hfVec[i >> 6]))
+          for (int k = 0; k < 64; k++)
+              if ((w & (1ULL << k)) && (j = mapNode[i+k]) >= 0) hVec.Set(j);
+   return hVec;
+}
+
+/******************************************************************************/
+/*                                  S a v e                                   */
+/******************************************************************************/
+
+void XrdCmsSnap::Save()
+{
+   EPNAME("Save");
+   char tmpPath[1040];
+
+// Collect the current cache contents. The string pool starts with a null byte
+// so that an offset of zero can mean "none".
+//
+   bldStrs.assign(1, '\0');
+   Cache.Snapshot(*this);
+   if (mapBase) Carry();
+
+// Write the snapshot to a temporary file and rename it so that a restart
+// never sees a partially written file.
+//
+   if (snprintf(tmpPath, sizeof(tmpPath), "%s.tmp", sPath)
+       >= (int)sizeof(tmpPath))
+      Say.Emsg("Snap", ENAMETOOLONG, "write snapshot", sPath);
+      else if (Write(tmpPath))
+              {if (rename(tmpPath, sPath))
+                  Say.Emsg("Snap", errno, "rename snapshot to", sPath);
+                  else DEBUG(bldEnts.size() <<" locations saved in " <<sPath);
+              }
+
+// Release the memory as snapshots are infrequent
+//
+   std::vector<Entry>().swap(bldEnts);
+   std::string().swap(bldStrs);
+}
+
+/******************************************************************************/
+/*                                U n l o a d                                 */
+/******************************************************************************/
+
+void XrdCmsSnap::Unload()
+{
+   mapLock.WriteLock();
+   munmap(mapBase, mapSize);
+   mapBase = 0;
+   for (int i = 0; i < STMax; i++)
+       {if (mapNID[i]) {free(mapNID[i]); mapNID[i] = 0;}
+        mapNode[i] = -1;
+       }
+   mapLock.UnLock();
+   Say.Emsg("Snap", "Previous snapshot", sPath, "has expired.");
+}
+
+/******************************************************************************/
+/*                                 W r i t e                                  */
+/******************************************************************************/
+
+bool XrdCmsSnap::Write(const char *fn)
+{
+   SnapHdr hdr;
+   std::vector<uint32_t> Slots;
+   uint32_t nidOff[STMax], numSlots = 16, j, smask;
+   int fd;
+   bool aOK;
+
+// Add the system ID of each logged in node to the string pool
+//
+   mapLock.ReadLock();
+   for (int i = 0; i < STMax; i++)
+       if (!curNID[i]) nidOff[i] = 0;
+          else {nidOff[i] = bldStrs.size();
+                bldStrs.append(curNID[i], strlen(curNID[i])+1);
+               }
+   mapLock.UnLock();
+
+// Build the hash table keeping it at most half full
+//
+   while(numSlots <= bldEnts.size()*2) numSlots <<= 1;
+   Slots.assign(numSlots, 0);
+   smask = numSlots - 1;
+   for (uint32_t i = 0; i < bldEnts.size(); i++)
+       {j = bldEnts[i].Hash & smask;
+        while(Slots[j]) j = (j+1) & smask;
+        Slots[j] = i+1;
+       }
+
+// Fill out the header
+//
+   memset(&hdr, 0, sizeof(hdr));
+   memcpy(hdr.Magic, snapMagic, sizeof(snapMagic));
+   hdr.Version  = snapVersion;
+   hdr.Endian   = snapEndian;
+   hdr.Time     = time(0);
+   hdr.numNodes = STMax;
+   hdr.numEnts  = bldEnts.size();
+   hdr.numSlots = numSlots;
+   hdr.strSize  = bldStrs.size();
+   hdr.nodeOff  = sizeof(hdr);
+   hdr.entOff   = hdr.nodeOff + sizeof(nidOff);
+   hdr.slotOff  = hdr.entOff  + bldEnts.size()*sizeof(Entry);
+   hdr.strOff   = hdr.slotOff + numSlots*sizeof(uint32_t);
+   hdr.fileSize = hdr.strOff  + bldStrs.size();
+
+// Write out the file
+//
+   if ((fd = open(fn, O_WRONLY|O_CREAT|O_TRUNC, 0644)) < 0)
+      {Say.Emsg("Snap", errno, "create snapshot", fn); return false;}
+   aOK = WriteAll(fd, &hdr, sizeof(hdr))
+      && WriteAll(fd, nidOff, sizeof(nidOff))
+      && WriteAll(fd, bldEnts.data(), bldEnts.size()*sizeof(Entry))
+      && WriteAll(fd, Slots.data(), numSlots*sizeof(uint32_t))
+      && WriteAll(fd, bldStrs.data(), bldStrs.size())
+      && !fsync(fd);
+   if (!aOK) Say.Emsg("Snap", errno, "write snapshot", fn);
+   close(fd);
+   if (!aOK) unlink(fn);
+   return aOK;
+}
@@ -0,0 +1,152 @@
+#ifndef __XRDCMSSNAP__H
+#define __XRDCMSSNAP__H
+/******************************************************************************/
+/*                                                                            */
+/*                         X r d C m s S n a p . h h                          */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <cstdint>
+#include <ctime>
+#include <string>
+#include <vector>
+
+#include "XrdCms/XrdCmsTypes.hh"
+#include "XrdSys/XrdSysPthread.hh"
+
+class XrdCmsKey;
+
+/******************************************************************************/
+/*                      C l a s s   X r d C m s S n a p                       */
+/******************************************************************************/
+
+// XrdCmsSnap periodically writes the known file locations held in the cache
+// to a file and, when a manager restarts, maps the previous file so that the
+// cache can be seeded from it on a miss instead of querying every node. Slot
+// numbers are not stable across restarts so the file names each node by its
+// system ID and a location is only used once that node has logged in again.
+// An entry is only used for as long as it would have remained in the cache.
+//
+class XrdCmsSnap
+{
+public:
+
+// Add() records a cache entry while a snapshot is being taken. It must only
+//       be called from XrdCmsCache::Snapshot() on the snapshot thread.
+//
+void        Add(XrdCmsKey &Key, time_t Born, SMask_t hfVec);
+
+// Attach() and Detach() track the node occupying each slot.
+//
+void        Attach(int slot, const char *nid);
+
+void        Detach(int slot);
+
+// Find() looks up a path in the previous snapshot. It returns true with the
+//        mask of the logged in nodes that had the file and the time the
+//        location was learned; or false if there is no usable entry.
+//
+bool        Find(XrdCmsKey &Key, SMask_t &hfVec, time_t &Born);
+
+// Kill() makes sure the previous snapshot no longer supplies a path.
+//
+void        Kill(XrdCmsKey &Key);
+
+// Start() maps the previous snapshot, if any, and starts the snapshot thread.
+//         The argument is the cache lifetime of a location.
+//
+int         Start(int cLife);
+
+void       *Keeper();
+
+inline bool isActive() {return sPath != 0;}
+
+inline bool isLoaded() {return mapBase != 0;}
+
+// Set the snapshot parameters (cms.snapshot directive).
+//
+void        setParms(const char *path, int intv, int mAge);
+
+      XrdCmsSnap();
+     ~XrdCmsSnap() {}  // Never gets deleted
+
+private:
+
+struct Entry
+      {uint32_t Hash;
+       uint32_t pathOff;
+       uint32_t pathLen;
+       uint32_t Flags;
+       int64_t  Born;
+       uint64_t hfVec[STMax/64];
+      };
+
+static const uint32_t isDead = 0x00000001;
+
+void        Append(uint32_t Hash, const char *Path, size_t Plen,
+                   time_t Born, SMask_t hfVec);
+void        Carry();
+void        Load();
+Entry      *Lookup(XrdCmsKey &Key);
+SMask_t     Remap(Entry *eP);
+void        Save();
+void        Unload();
+bool        Write(const char *fn);
+
+// The previous snapshot (protected by mapLock)
+//
+XrdSysRWLock  mapLock;
+char         *mapBase;
+size_t        mapSize;
+Entry        *mapEnts;
+uint32_t     *mapSlots;
+const char   *mapStrs;
+uint32_t      mapNEnt;
+uint32_t      mapSMask;
+uint32_t      mapStrSz;
+time_t        mapEnd;
+int           mapNode[STMax];  // Snapshot node index -> current slot
+char         *mapNID[STMax];   // Snapshot node index -> system ID
+
+// Nodes currently logged in (also protected by mapLock)
+//
+char         *curNID[STMax];
+
+// Snapshot being built (snapshot thread only)
+//
+std::vector<Entry> bldEnts;
+std::string        bldStrs;
+
+char         *sPath;
+int           Interval;
+int           maxAge;
+int           Life;
+};
+
+namespace XrdCms
+{
+extern    XrdCmsSnap Snap;
+}
+#endif
@@ -0,0 +1,261 @@
+/******************************************************************************/
+/*                                                                            */
+/*                       X r d C m s S t a t e Q . c c                        */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+#include "XProtocol/YProtocol.hh"
+
+#include "XrdCms/XrdCmsCluster.hh"
+#include "XrdCms/XrdCmsConfig.hh"
+#include "XrdCms/XrdCmsNode.hh"
+#include "XrdCms/XrdCmsStateQ.hh"
+#include "XrdCms/XrdCmsTrace.hh"
+#include "XrdSys/XrdSysError.hh"
+#include "XrdSys/XrdSysTimer.hh"
+
+using namespace XrdCms;
+
+/******************************************************************************/
+/*                               G l o b a l s                                */
+/******************************************************************************/
+
+       XrdCmsStateQ  XrdCms::StateQ;
+
+/******************************************************************************/
+/*            E x t e r n a l   T h r e a d   I n t e r f a c e s             */
+/******************************************************************************/
+
+namespace
+{
+void *StateQRun(void *carg)
+      {XrdCmsStateQ *sp = (XrdCmsStateQ *)carg;
+       return sp->Flusher();
+      }
+}
+
+/******************************************************************************/
+/*                                   A d d                                    */
+/******************************************************************************/
+
+void XrdCmsStateQ::Add(SMask_t nMask, const char *Path, int Plen)
+{
+   std::vector<Ready> rdyVec;
+
+// Append the path to each node's pending batch. A batch that cannot take the
+// path is sent right away.
+//
+   qMutex.Lock();
+   for (int i = nMask.First(); i >= 0; i = nMask.First(i+1))
+       {Batch &bP = Nodes[i].Pend;
+        if (bP.Bnum >= CmsStateVRequest::maxPaths
+        ||  bP.Blen + Plen + 1 > maxBytes) Post(i, rdyVec);
+        if (!bP.Buff && !(bP.Buff = (char *)malloc(maxBytes))) continue;
+        memcpy(bP.Buff + bP.Blen, Path, Plen);
+        bP.Buff[bP.Blen + Plen] = '\0';
+        bP.Blen += Plen + 1;
+        bP.Bnum++;
+       }
+   qMutex.UnLock();
+
+// Send off any full batches
+//
+   if (!rdyVec.empty()) Ship(rdyVec);
+}
+
+/******************************************************************************/
+/*                                 C l a i m                                  */
+/******************************************************************************/
+
+char *XrdCmsStateQ::Claim(int nodeID, unsigned int bID, int &bLen, int &bNum,
+                          long long &bSent)
+{
+   char *bP = 0;
+
+   if (nodeID < 0 || nodeID >= STMax) return 0;
+
+// Find the batch, if we still have it, and hand it over to the caller
+//
+   qMutex.Lock();
+   std::deque<Batch> &Outs = Nodes[nodeID].Outs;
+   for (std::deque<Batch>::iterator it = Outs.begin(); it != Outs.end(); ++it)
+       {if (it->bID == bID)
+           {bP = it->Buff; bLen = it->Blen; bNum = it->Bnum; bSent = it->Sent;
+            Outs.erase(it);
+            break;
+           }
+       }
+   qMutex.UnLock();
+   return bP;
+}
+
+/******************************************************************************/
+/*                                  D r o p                                   */
+/******************************************************************************/
+
+void XrdCmsStateQ::Drop(int nodeID)
+{
+   if (nodeID < 0 || nodeID >= STMax) return;
+
+   qMutex.Lock();
+   Nodes[nodeID].Pend.Reset();
+   Expire(Nodes[nodeID], -1);
+   qMutex.UnLock();
+}
+
+/******************************************************************************/
+/*                               F l u s h e r                                */
+/******************************************************************************/
+
+void *XrdCmsStateQ::Flusher()
+{
+   std::vector<Ready> rdyVec;
+   int Window;
+
+// Send every pending batch once per window. The window may be changed or
+// batching turned off at any time; we then simply flush whatever is left.
+// Outstanding batches that expired are discarded along the way.
+//
+   do {Window = Config.QBatch;
+       XrdSysTimer::Wait(Window > 0 ? Window : 1000);
+       long long Now = XrdCmsNode::Microsec();
+       qMutex.Lock();
+       for (int i = 0; i < STMax; i++)
+           {if (Nodes[i].Pend.Bnum) Post(i, rdyVec);
+               else if (!Nodes[i].Outs.empty()) Expire(Nodes[i], Now);
+           }
+       qMutex.UnLock();
+       if (!rdyVec.empty()) {Ship(rdyVec); rdyVec.clear();}
+      } while(1);
+
+// Keep compiler happy
+//
+   return (void *)0;
+}
+
+/******************************************************************************/
+/*                                 S t a r t                                  */
+/******************************************************************************/
+
+int XrdCmsStateQ::Start()
+{
+   pthread_t tid;
+
+   if (XrdSysThread::Run(&tid, StateQRun, (void *)this, 0, "State batcher"))
+      {Say.Emsg("StateQ", errno, "start state query batcher");
+       return 0;
+      }
+   return 1;
+}
+
+/******************************************************************************/
+/*                       P r i v a t e   M e t h o d s                        */
+/******************************************************************************/
+/******************************************************************************/
+/*                                E x p i r e                                 */
+/******************************************************************************/
+
+// Caller must hold qMutex. Outstanding batches sent before the expiry time
+// are discarded; a negative Now discards all of them.
+
+void XrdCmsStateQ::Expire(XrdCmsStateQ::NodeQ &nQ, long long Now)
+{
+   long long Life = (Config.LUPDelay > 0 ? Config.LUPDelay : 1) * 2000000LL;
+
+   while(!nQ.Outs.empty() && (Now < 0 || Now - nQ.Outs.front().Sent >= Life))
+        {nQ.Outs.front().Reset();
+         nQ.Outs.pop_front();
+        }
+}
+
+/******************************************************************************/
+/*                                  P o s t                                   */
+/******************************************************************************/
+
+// Caller must hold qMutex. The pending batch becomes an outstanding one and a
+// copy of it is readied for sending.
+
+void XrdCmsStateQ::Post(int nodeID, std::vector<Ready> &rdyVec)
+{
+   NodeQ &nQ = Nodes[nodeID];
+   long long Now = XrdCmsNode::Microsec();
+
+// Discard expired batches. Should the node still have too many outstanding,
+// the oldest is dropped and its response will be ignored as stale.
+//
+   Expire(nQ, Now);
+   if ((int)nQ.Outs.size() >= maxOuts)
+      {if (!(numDrop++ & 0xff))
+          {char buff[64];
+           snprintf(buff, sizeof(buff), "(events=%u)", numDrop);
+           Say.Emsg("StateQ", "Too many outstanding state queries; oldest "
+                    "batch dropped", buff);
+          }
+       nQ.Outs.front().Reset();
+       nQ.Outs.pop_front();
+      }
+
+// Prepare the batch for sending
+//
+   if (!(++nextID)) nextID = 1;
+   rdyVec.push_back(Ready());
+   rdyVec.back().nodeID = nodeID;
+   rdyVec.back().bID    = nextID;
+   rdyVec.back().Data.assign(nQ.Pend.Buff, nQ.Pend.Blen);
+
+// Keep it so that we can interpret the response
+//
+   nQ.Outs.push_back(nQ.Pend);
+   nQ.Outs.back().bID  = nextID;
+   nQ.Outs.back().Sent = Now;
+   nQ.Pend.Buff = 0; nQ.Pend.Blen = nQ.Pend.Bnum = 0;
+}
+
+/******************************************************************************/
+/*                                  S h i p                                   */
+/******************************************************************************/
+
+void XrdCmsStateQ::Ship(std::vector<Ready> &rdyVec)
+{
+   EPNAME("Ship");
+
+// Send each batch to its node. A node that cannot be reached simply does not
+// respond, as would a node that has none of the files.
+//
+   for (unsigned int i = 0; i < rdyVec.size(); i++)
+       {Ready &rP = rdyVec[i];
+        CmsStateVRequest QReq = {{rP.bID, kYR_statev, kYR_raw, 0}};
+        if (Cluster.Broadcast(SMask_t::Bit(rP.nodeID), QReq.Hdr,
+                              (void *)rP.Data.data(), rP.Data.size()))
+           {DEBUG("unable to send batch " <<rP.bID <<" to node " <<rP.nodeID);}
+           else {TRACE(Files, "sent " <<rP.Data.size() <<" bytes as batch "
+                               <<rP.bID <<" to node " <<rP.nodeID);
+                }
+       }
+}
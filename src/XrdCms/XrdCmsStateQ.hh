@@ -0,0 +1,123 @@
+#ifndef __XRDCMSSTATEQ__H
+#define __XRDCMSSTATEQ__H
+/******************************************************************************/
+/*                                                                            */
+/*                       X r d C m s S t a t e Q . h h                        */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <cstdlib>
+#include <deque>
+#include <string>
+#include <vector>
+
+#include "XrdCms/XrdCmsTypes.hh"
+#include "XrdSys/XrdSysPthread.hh"
+
+/******************************************************************************/
+/*                    C l a s s   X r d C m s S t a t e Q                     */
+/******************************************************************************/
+
+// XrdCmsStateQ collects the state queries a manager sends to its data servers
+// over a short window (cms.delay qbatch) and sends each server a single statev
+// request naming all of the paths. A server answers with a havev bitmap of the
+// paths it has. The paths of each batch are kept until the response arrives
+// or until the batch expires, as a server does not respond when it has none of
+// the files. A batch expires twice the look-up delay after it was sent, as its
+// response is of no use to any waiting client by then.
+//
+class XrdCmsStateQ
+{
+public:
+
+// Add() queues a state query for a path to each node in the mask.
+//
+void        Add(SMask_t nMask, const char *Path, int Plen);
+
+// Claim() returns the paths of the batch a node responded to along with
+//         their length, count, and when the batch was sent (microseconds).
+//         The caller must free the buffer.
+//
+char       *Claim(int nodeID, unsigned int bID, int &bLen, int &bNum,
+                  long long &bSent);
+
+// Drop() discards all pending and outstanding batches for a node.
+//
+void        Drop(int nodeID);
+
+void       *Flusher();
+
+int         Start();
+
+static const int maxBytes = 16000;  // Batch size (must fit a cms request)
+static const int maxOuts  = 1024;   // Outstanding batches kept per node
+
+      XrdCmsStateQ() : nextID(0), numDrop(0) {}
+     ~XrdCmsStateQ() {}  // Never gets deleted
+
+private:
+
+struct Batch
+      {char        *Buff;
+       int          Blen;
+       int          Bnum;
+       unsigned int bID;
+       long long    Sent;
+
+       void  Reset() {if (Buff) free(Buff); Buff = 0; Blen = Bnum = 0;}
+
+             Batch() : Buff(0), Blen(0), Bnum(0), bID(0), Sent(0) {}
+            ~Batch() {}
+      };
+
+struct NodeQ
+      {Batch             Pend;
+       std::deque<Batch> Outs;  // Outstanding batches, oldest first
+
+             NodeQ() {}
+            ~NodeQ() {}
+      };
+
+struct Ready
+      {int          nodeID;
+       unsigned int bID;
+       std::string  Data;
+      };
+
+void        Expire(NodeQ &nQ, long long Now);
+void        Post(int nodeID, std::vector<Ready> &rdyVec);
+void        Ship(std::vector<Ready> &rdyVec);
+
+XrdSysMutex  qMutex;
+NodeQ        Nodes[STMax];
+unsigned int nextID;
+unsigned int numDrop;
+};
+
+namespace XrdCms
+{
+extern    XrdCmsStateQ StateQ;
+}
+#endif
@@ -30,13 +30,16 @@
 /* specific prior written permission of the institution or contributor.       */
 /******************************************************************************/
   
-typedef unsigned long long SMask_t;
+#include "XrdCms/XrdCmsSMask.hh"
 
-#define FULLMASK 0xFFFFFFFFFFFFFFFFULL
-
-// The following defines our cell size (maximum subscribers)
+// The following defines our cell size (maximum subscribers). Each subscriber
+// occupies one bit in a server mask (SMask_t), so this is also the mask width.
 //
-#define STMax 64
+#define STMax 256
+
+typedef XrdCmsSMask<STMax> SMask_t;
+
+#define FULLMASK (~SMask_t(0))
 
 // The following defines the maximum number of redirectors. It is one greater
 // than the actual maximum as the zeroth is never used.
@@ -31,6 +31,7 @@ add_executable(
   Xrd/XrdMain.cc
   XrdCms/XrdCmsAdmin.cc           XrdCms/XrdCmsAdmin.hh
   XrdCms/XrdCmsBaseFS.cc          XrdCms/XrdCmsBaseFS.hh
+  XrdCms/XrdCmsBcast.cc           XrdCms/XrdCmsBcast.hh
   XrdCms/XrdCmsCache.cc           XrdCms/XrdCmsCache.hh
   XrdCms/XrdCmsCluster.cc         XrdCms/XrdCmsCluster.hh
   XrdCms/XrdCmsClustID.cc         XrdCms/XrdCmsClustID.hh
@@ -43,6 +44,7 @@ add_executable(
   XrdCms/XrdCmsMeter.cc           XrdCms/XrdCmsMeter.hh
   XrdCms/XrdCmsNash.cc            XrdCms/XrdCmsNash.hh
   XrdCms/XrdCmsNode.cc            XrdCms/XrdCmsNode.hh
+  XrdCms/XrdCmsNSum.cc            XrdCms/XrdCmsNSum.hh
   XrdCms/XrdCmsPList.cc           XrdCms/XrdCmsPList.hh
   XrdCms/XrdCmsPrepare.cc         XrdCms/XrdCmsPrepare.hh
   XrdCms/XrdCmsPrepArgs.cc        XrdCms/XrdCmsPrepArgs.hh
@@ -50,7 +52,9 @@ add_executable(
   XrdCms/XrdCmsRouting.cc         XrdCms/XrdCmsRouting.hh
   XrdCms/XrdCmsRRQ.cc             XrdCms/XrdCmsRRQ.hh
                                   XrdCms/XrdCmsSelect.hh
+  XrdCms/XrdCmsSnap.cc            XrdCms/XrdCmsSnap.hh
   XrdCms/XrdCmsState.cc           XrdCms/XrdCmsState.hh
+  XrdCms/XrdCmsStateQ.cc          XrdCms/XrdCmsStateQ.hh
   XrdCms/XrdCmsSupervisor.cc      XrdCms/XrdCmsSupervisor.hh
                                   XrdCms/XrdCmsTrace.hh )
 target_link_libraries(
@@ -156,6 +156,8 @@ XrdFrmConfig::XrdFrmConfig(SubSys ss, const char *vopts, const char *uinfo)
    IdleHold = 10*60;
    WaitMigr = 60*60;
    WaitPurge= 600;
+   scanThrd = 4;
+   purgKeep = 250000;
    WaitQChk = 300;
    MSSCmd   = 0;
    memset(&xfrCmd, 0, sizeof(xfrCmd));
@@ -1053,6 +1055,7 @@ int XrdFrmConfig::ConfigXeq(char *var, int mbok)
        if (!strncmp(var, "migr.", 5))   // xfr.migr
       {char *vas = var+5;
        if (!strcmp(vas, "idlehold"      )) return xitm("idle time", IdleHold);
+       if (!strcmp(vas, "scan"          )) return xscan();
        if (!strcmp(vas, "waittime"      )) return xitm("migr wait", WaitMigr);
       }
       }
@@ -1067,6 +1070,7 @@ int XrdFrmConfig::ConfigXeq(char *var, int mbok)
        if (!strcmp(var, "ofs.xattrlib"  )) PARSEPI(theAtrLib);
        if (!strcmp(var, "policy"        )) return xpol();
        if (!strcmp(var, "polprog"       )) return xpolprog();
+       if (!strcmp(var, "scan"          )) return xscan();
        if (!strcmp(var, "oss.space"     )) return xspace(1);
        if (!strcmp(var, "waittime"      )) return xitm("purge wait",WaitPurge);
        if (!strcmp(var, "frm.all.monitor"))return xmon();
@@ -1957,6 +1961,60 @@ int XrdFrmConfig::xqchk()
    return 0;
 }
 
+/******************************************************************************/
+/* Private:                        x s c a n                                  */
+/******************************************************************************/
+
+/* Function: xscan
+
+   Purpose:  To parse the directive: scan [keep <num>] [threads <num>]
+
+             keep      The maximum number of purge candidates kept for each
+                       space during a name space scan. Should these not free
+                       enough space, the name space is scanned again. This
+                       option only applies to purging. Default: 250000
+             threads   The number of threads reading directories during a
+                       name space scan. A value of 1 reads them one at a time.
+                       Default: 4
+
+   Output: 0 upon success or !0 upon failure.
+*/
+int XrdFrmConfig::xscan()
+{   char *val;
+    int  num;
+
+// Make sure we have at least one option
+//
+   if (!(val = cFile->GetWord()))
+      {Say.Emsg("Config", "scan options not specified"); return 1;}
+
+// Process the options
+//
+   while(val)
+        {     if (!strcmp(val, "keep") && ssID == ssPurg)
+                 {if (!(val = cFile->GetWord()))
+                     {Say.Emsg("Config", "scan keep value not specified");
+                      return 1;
+                     }
+                  if (XrdOuca2x::a2i(Say, "scan keep value", val, &num, 1))
+                     return 1;
+                  purgKeep = num;
+                 }
+         else if (!strcmp(val, "threads"))
+                 {if (!(val = cFile->GetWord()))
+                     {Say.Emsg("Config", "scan threads value not specified");
+                      return 1;
+                     }
+                  if (XrdOuca2x::a2i(Say,"scan threads value",val,&num,1,64))
+                     return 1;
+                  scanThrd = num;
+                 }
+         else {Say.Emsg("Config", "invalid scan option -", val); return 1;}
+         val = cFile->GetWord();
+        }
+   return 0;
+}
+
 /******************************************************************************/
 /*                                  x s i t                                   */
 /******************************************************************************/
@@ -104,6 +104,8 @@ int                 IdleHold;
 int                 WaitQChk;
 int                 WaitPurge;
 int                 WaitMigr;
+int                 scanThrd;  // Threads reading directories during a scan
+int                 purgKeep;  // Purge candidates kept per space in a scan
 int                 haveCMS;
 int                 isOTO;
 int                 Fix;
@@ -208,6 +210,7 @@ int          xmon();
 int          xpol();
 int          xpolprog();
 int          xqchk();
+int          xscan();
 int          xsit();
 int          xspace(int isPrg=0, int isXA=1);
 void         xspaceBuild(char *grp, char *fn, int isxa);
@@ -302,7 +302,8 @@ void XrdFrmFileset::Remfix(const char *fType, const char *fPath)
 /******************************************************************************/
   
 XrdFrmFiles::XrdFrmFiles(const char *dname, int opts,
-                        XrdOucTList *XList, XrdOucNSWalk::CallBack *cbP)
+                        XrdOucTList *XList, XrdOucNSWalk::CallBack *cbP,
+                        int nThr)
             : nsObj(&Say, dname, 0,
                     XrdOucNSWalk::retFile | XrdOucNSWalk::retLink
                    |XrdOucNSWalk::retStat | XrdOucNSWalk::skpErrs
@@ -313,9 +314,10 @@ XrdFrmFiles::XrdFrmFiles(const char *dname, int opts,
               shareD(opts & CompressD), getCPT(opts & GetCpyTim)
 {
 
-// Set Call Back method
+// Set Call Back method and the number of threads to use
 //
    nsObj.setCallBack(cbP);
+   nsObj.setThreads(nThr);
 }
 
 /******************************************************************************/
@@ -88,7 +88,6 @@ int                         setCpyTime(int Refresh=0);
 // The following are public to ease management of this object
 //
 XrdFrmFileset *Next;
-int            Age;
 
 private:
 int         chkLock(const char *Path);
@@ -123,8 +122,12 @@ static const int CompressD = 0x0002;   // Use shared directory object (not MT)
 static const int NoAutoDel = 0x0004;   // Do not automatically delete objects
 static const int GetCpyTim = 0x0008;   // Initialize cpyInfo attribute on Get()
 
+// When nThr is greater than one, directories are read using that many
+// threads (see XrdOucNSWalk::setThreads()).
+//
             XrdFrmFiles(const char *dname, int opts=Recursive,
-                        XrdOucTList *XList=0, XrdOucNSWalk::CallBack *cbP=0);
+                        XrdOucTList *XList=0, XrdOucNSWalk::CallBack *cbP=0,
+                        int nThr=0);
 
            ~XrdFrmFiles();
 
@@ -283,7 +283,7 @@ void XrdFrmMigrate::Scan()
 
 // Process each directory
 //
-   do {fP = new XrdFrmFiles(vP->Name, Opts, vP->Dir);
+   do {fP = new XrdFrmFiles(vP->Name, Opts, vP->Dir, 0, Config.scanThrd);
        while((sP = fP->Get(ec,1)))
             {aFiles++;
              if (sP->Screen()) Add(sP);
@@ -204,6 +204,10 @@ void XrdFrmPurge::Add(XrdFrmFileset *sP)
    if (!(psP->Enabled)) {delete sP; return;}
    psP->numFiles++;
 
+// There is no need to keep candidates for a space that does not need purging
+//
+   if (psP->Stop) {delete sP; return;}
+
 // Check to see if the file is really eligible for purging
 //
    if ((Why = psP->Eligible(sP, xTime)))
@@ -237,7 +241,7 @@ XrdFrmFileset *XrdFrmPurge::Advance()
 // Try to re-add everything in this queue
 //
    while((xP = fP))
-        {fP = fP->Next;
+        {fP = fP->Next; numDefer--;
          if (xP->Refresh(0,0)) Add(xP);
             else delete xP;
         }
@@ -251,7 +255,7 @@ XrdFrmFileset *XrdFrmPurge::Advance()
 /* Private:                        C l e a r                                  */
 /******************************************************************************/
   
-void XrdFrmPurge::Clear()
+void XrdFrmPurge::Clear(int keepPrg)
 {
    XrdFrmFileset *fP;
    int n;
@@ -261,14 +265,17 @@ void XrdFrmPurge::Clear()
    for (n = 0; n < DeferQsz; n++)
        while ((fP = DeferQ[n])) {DeferQ[n] = fP->Next; delete fP;}
    memset(DeferT, 0, sizeof(DeferT));
+   numDefer = numDrop = 0;
 
 // Purge the eligible file table
 //
    FSTab.Purge();
 
-// Clear counters
+// Clear counters. When rescanning, we keep the counts of what was purged.
 //
-   numFiles = 0; prgFiles = 0; purgBytes = 0;
+   numFiles = 0; reScan = 0;
+   if (!keepPrg) {prgFiles = 0; purgBytes = 0;}
+   lastPrg = prgFiles;
 }
   
 /******************************************************************************/
@@ -280,6 +287,12 @@ void XrdFrmPurge::Defer(XrdFrmFileset *sP, time_t xTime)
    time_t aTime = sP->baseFile()->Stat.st_atime;
    int n = xTime/DeferQsz;
 
+// The defer queue is bounded just like the purge table. Files that do not fit
+// are found again by the next scan.
+//
+   if (numDefer >= Config.purgKeep) {numDrop++; delete sP; return;}
+   numDefer++;
+
 // Slot the entry into the defer queue vector
 //
    if (n >= DeferQsz) n = DeferQsz-1;
@@ -319,6 +332,11 @@ void XrdFrmPurge::Display()
       else sprintf(buff, "%d", Config.dirHold);
    Say.Say("=====> ", "Directory hold: ", buff);
 
+// Display scan parameters
+//
+   sprintf(buff, "Scan threads: %d keep: %d", Config.scanThrd, Config.purgKeep);
+   Say.Say("=====> ", buff);
+
 // Run through all of the policies, displaying each one
 //
    spP = First;
@@ -439,7 +457,8 @@ int XrdFrmPurge::Init(XrdOucTList *sP, long long minV, int hVal)
 //
    spP = First;
    while(spP)
-        {setIt = 1;
+        {spP->FSTab.setLimit(Config.purgKeep);
+         setIt = 1;
          if ((tP = sP))
             {while(tP && strcmp(tP->text, spP->SName)) tP = tP->next;
              if (!tP) setIt = 0;
@@ -606,7 +625,7 @@ do{psP = First;
         {if (!(psP->Stop) && (psP->Stop = psP->PurgeFile())) Left2Do--;
          psP = psP->Next;
         }
-  } while(Left2Do);
+  } while(Left2Do || Rescan());
 
 // Report data at the end of the purge cycle
 //
@@ -631,6 +650,8 @@ int XrdFrmPurge::PurgeFile()
 do{if (!(fP = FSTab.Oldest()) && !(fP = Advance()))
       {time_t nextScan = time(0)+Hold;
        if (!nextReset || nextScan < nextReset) nextReset = nextScan;
+       reScan = (FSTab.Dropped() || numDrop) && prgFiles > lastPrg
+              && !Config.Test;
        return 1;
       }
    Why = "file in use";
@@ -697,6 +718,36 @@ int XrdFrmPurge::PurgeFile(XrdFrmFileset *fP, const char *pFN)
    return 0;
 }
 
+/******************************************************************************/
+/* Private:                       R e s c a n                                 */
+/******************************************************************************/
+
+// A scan only keeps the best purge candidates of each space. Should a space use
+// them all up and still need space, it is scanned for again. We only do that
+// when candidates from the last scan were actually purged; otherwise, another
+// scan would simply find the same candidates that could not be purged. Nor do
+// we in test mode as nothing is really purged.
+  
+int XrdFrmPurge::Rescan()
+{
+   XrdFrmPurge *psP = First;
+
+// Restart each space that needs more candidates, all others stay stopped
+//
+   while(psP)
+        {if (psP->reScan && psP->freeSpace < psP->maxFSpace)
+            {psP->Clear(1); psP->Stop = 0; Left2Do++;}
+         psP = psP->Next;
+        }
+
+// Scan if need be
+//
+   if (!Left2Do) return 0;
+   Say.Emsg("Purge", "Rescanning name space for more purge candidates.");
+   Scan();
+   return 1;
+}
+
 /******************************************************************************/
 /* Private:                         S c a n                                   */
 /******************************************************************************/
@@ -735,7 +786,7 @@ void XrdFrmPurge::Scan()
 
 // Process each directory
 //
-   do {fP = new XrdFrmFiles(vP->Name, Opts, vP->Dir, cbP);
+   do {fP = new XrdFrmFiles(vP->Name, Opts, vP->Dir, cbP, Config.scanThrd);
        needLF = vP->Val;
        while((sP = fP->Get(ec,1)))
             {aFiles++;
@@ -64,13 +64,14 @@ private:
 //
 static void          Add(XrdFrmFileset *fsp);
        XrdFrmFileset*Advance();
-       void          Clear();
+       void          Clear(int keepPrg=0);
        void          Defer(XrdFrmFileset *sP, time_t xTime);
 const  char         *Eligible(XrdFrmFileset *sP, time_t &xTime, int hTime=0);
 static XrdFrmPurge  *Find(const char *snp);
 static int           LowOnSpace();
        int           PurgeFile();
        int           PurgeFile(XrdFrmFileset *fP, const char *pFN);
+static int           Rescan();
 static void          Scan();
 static void          Stats(int Final);
        void          Track(XrdFrmFileset *sP);
@@ -108,6 +109,10 @@ int                  Hold2x;         // Hold x2 (what we actually use)
 int                  Ext;            // External policy applies
 int                  numFiles;       // Total number of files
 int                  prgFiles;       // Total number of purged
+int                  lastPrg;        // prgFiles when the last scan started
+int                  numDefer;       // Number of files in the defer queue
+int                  numDrop;        // Number of files not deferred (too many)
+int                  reScan;         // Ran out of candidates; scan again
 int                  Enabled;
 int                  Stop;
 int                  SNlen;
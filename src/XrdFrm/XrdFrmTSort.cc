@@ -28,9 +28,10 @@
 /* specific prior written permission of the institution or contributor.       */
 /******************************************************************************/
 
+#include <algorithm>
+
 #include "XrdFrm/XrdFrmFiles.hh"
 #include "XrdFrm/XrdFrmTSort.hh"
-//#include "iostream.h"
 
 /******************************************************************************/
 /*                                   A d d                                    */
@@ -38,102 +39,52 @@
   
 int XrdFrmTSort::Add(XrdFrmFileset *fsp)
 {
-   XrdOucNSWalk::NSEnt *nsp = fsp->baseFile();
-   int n;
-
-// Make sure we can actuall add this entry
-//
-   if (baseT < nsp->Stat.st_atime) return 0;
+   Better isBetter(sortSZ);
 
-// Get the relative time
+// If there is room, simply add the entry to the heap
 //
-   fsp->Age = static_cast<int>(baseT - nsp->Stat.st_atime);
-
-// Insert into the table
+   if (!maxEnt || static_cast<int>(Heap.size()) < maxEnt)
+      {Heap.push_back(fsp);
+       std::push_heap(Heap.begin(), Heap.end(), isBetter);
+       isSorted = false;
+       return 1;
+      }
+
+// We are full. The entry replaces the worst one we have if it is better.
 //
-   n = fsp->Age/dVal;
-   if (n > 63) n = 63;
-   fsp->Next = FSTab[0][n];
-   FSTab[0][n] = fsp;
-   if (n > DYent) DYent = n;
-//cerr <<"Add " <<std::hex <<fsp->Age <<' ' <<std::dec <<0 <<',' <<n <<' ' <<fsp->basePath() <<endl;
-   numEnt++;
+   numDrop++;
+   if (!isBetter(fsp, Heap.front())) {delete fsp; return 0;}
+   std::pop_heap(Heap.begin(), Heap.end(), isBetter);
+   delete Heap.back();
+   Heap.back() = fsp;
+   std::push_heap(Heap.begin(), Heap.end(), isBetter);
+   isSorted = false;
    return 1;
 }
 
-/******************************************************************************/
-/* Private:                          B i n                                    */
-/******************************************************************************/
-
-int XrdFrmTSort::Bin(XrdFrmFileset *fsp, int j, int Shift)
-{
-   XrdFrmFileset *fsq;
-   int k, n = 0;
-
-   while((fsq = fsp))
-        {fsp = fsp->Next;
-         k = (fsq->Age >> Shift) & tMask;
-         if (k > n) n = k;
-         if (Shift || !sortSZ) fsq->Next = FSTab[j][k];
-            else fsq = Insert(fsq, FSTab[j][k]);
-         FSTab[j][k] = fsq;
-//cerr <<"Bin " <<std::hex <<fsq->Age <<' ' <<std::dec <<j <<',' <<k <<' ' <<fsq->basePath() <<endl;
-        }
-   return n;
-}
-
-/******************************************************************************/
-/* Private:                       I n s e r t                                 */
-/******************************************************************************/
-  
-XrdFrmFileset *XrdFrmTSort::Insert(XrdFrmFileset *newP, XrdFrmFileset *oldP)
-{
-   XrdFrmFileset *prvP = 0, *nowP = oldP;
-   off_t newSize = newP->baseFile()->Stat.st_size;
-
-// Find insertion point of new element (decreasing size order)
-//
-   while(nowP && newSize < nowP->baseFile()->Stat.st_size)
-        {prvP = nowP; nowP = nowP->Next;}
-
-// Perform insertion
-//
-   if (prvP) {prvP->Next = newP; newP->Next = nowP;}
-      else    newP->Next = nowP;
-
-// Return correct head of list
-//
-   return (prvP ? oldP : newP);
-}
-
 /******************************************************************************/
 /*                                O l d e s t                                 */
 /******************************************************************************/
 
 XrdFrmFileset *XrdFrmTSort::Oldest()
 {
-   XrdFrmFileset *fsp = 0;
+   XrdFrmFileset *fsp;
+
+// Order the heap from the worst to the best candidate if we have not done so.
+// A vector in that order is still a valid heap so more entries may be added.
+//
+   if (!isSorted)
+      {std::sort_heap(Heap.begin(), Heap.end(), Better(sortSZ));
+       std::reverse(Heap.begin(), Heap.end());
+       isSorted = true;
+      }
 
-// Work backwards on the list, resorting as needed
+// Return the best candidate
 //
-   do {while(SCent >= 0)
-            {if ((fsp = FSTab[3][SCent]))
-                {if (!( FSTab[3][SCent] = fsp->Next)) SCent--;
-                 numEnt--;
-//cerr <<"Oldest " <<fsp->Age <<' ' <<fsp->basePath() <<endl;
-                 return fsp;
-                } else SCent--;
-            }
-//cerr <<"SC=" <<SCent <<" MN=" <<MNent <<" HR=" <<HRent <<" DY=" <<DYent <<endl;
-       fsp = 0;
-       while(MNent >= 0 && !fsp) fsp = FSTab[2][MNent--];
-       if (fsp) {FSTab[2][MNent+1]=0; SCent = Bin(fsp, 3, SCshift); continue;}
-       while(HRent >= 0 && !fsp) fsp = FSTab[1][HRent--];
-       if (fsp) {FSTab[1][HRent+1]=0; MNent = Bin(fsp, 2, MNshift); continue;}
-       while(DYent >= 0 && !fsp) fsp = FSTab[0][DYent--];
-       if (fsp) {FSTab[0][DYent+1]=0; HRent = Bin(fsp, 1, HRshift); continue;}
-      } while(numEnt);
-   return 0;
+   if (Heap.empty()) return 0;
+   fsp = Heap.back();
+   Heap.pop_back();
+   return fsp;
 }
 
 /******************************************************************************/
@@ -142,29 +93,25 @@ XrdFrmFileset *XrdFrmTSort::Oldest()
   
 void XrdFrmTSort::Purge()
 {
-   XrdFrmFileset *fsp, *csp;
-   int i, j, aBeg[4] = {DYent, HRent, MNent, SCent};
-
-   for (i = 0; i < 4; i++)
-       for (j = aBeg[i]; j >= 0; j--)
-           {if ((fsp = FSTab[i][j]))
-               while((csp = fsp)) {fsp = fsp->Next; delete csp;}
-           }
-   Reset();
+   for (unsigned int i = 0; i < Heap.size(); i++) delete Heap[i];
+   Heap.clear();
+   numDrop  = 0;
+   isSorted = true;
 }
 
 /******************************************************************************/
-/* Private:                        R e s e t                                  */
-/*                                                                            */
+/*                  X r d F r m T S o r t : : B e t t e r                     */
 /******************************************************************************/
 
-void XrdFrmTSort::Reset()
+bool XrdFrmTSort::Better::operator()(XrdFrmFileset *fsp1,
+                                     XrdFrmFileset *fsp2) const
 {
+   XrdOucNSWalk::NSEnt *nsp1 = fsp1->baseFile(), *nsp2 = fsp2->baseFile();
 
-// Clear the base table and set base time
+// The file accessed longest ago is the better candidate. For equal access
+// times, the larger file is the better candidate if so wanted.
 //
-   memset(FSTab, 0, sizeof(FSTab));
-   DYent = HRent = MNent = SCent = -1;
-   baseT = time(0);
-   numEnt = 0;
+   if (nsp1->Stat.st_atime != nsp2->Stat.st_atime)
+      return nsp1->Stat.st_atime < nsp2->Stat.st_atime;
+   return sortSZ && nsp1->Stat.st_size > nsp2->Stat.st_size;
 }
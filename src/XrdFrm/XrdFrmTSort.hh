@@ -30,42 +30,54 @@
 /* specific prior written permission of the institution or contributor.       */
 /******************************************************************************/
 
+#include <vector>
+
 class XrdFrmFileset;
 
+// XrdFrmTSort holds the filesets that are candidates for purging and returns
+// them least recently accessed first; if szSort is true, larger files are
+// returned first among those accessed at the same time. When maxEnt is set,
+// only the maxEnt best candidates are kept. They are held in a heap whose top
+// is the worst candidate kept so that a better one can replace it in log time.
+//
 class XrdFrmTSort
 {
 public:
 
+// Add() takes ownership of the fileset. It returns 0 if the fileset was not
+//       kept, in which case it has been deleted.
+//
 int               Add(XrdFrmFileset *fsp);
 
-int               Count() {return numEnt;}
+int               Count() {return static_cast<int>(Heap.size());}
+
+// Dropped() returns the number of candidates discarded since the last Purge().
+//
+int               Dropped() {return numDrop;}
 
 XrdFrmFileset    *Oldest();
 
 void              Purge();
 
-                  XrdFrmTSort(int szSort=0) : sortSZ(szSort) {Reset();}
+void              setLimit(int maxE) {maxEnt = maxE;}
+
+                  XrdFrmTSort(int szSort=0, int maxE=0)
+                             : sortSZ(szSort), maxEnt(maxE), numDrop(0),
+                               isSorted(true) {}
                  ~XrdFrmTSort() {Purge();}
 
 private:
-int               Bin(XrdFrmFileset *fsp, int j, int Shift);
-XrdFrmFileset    *Insert(XrdFrmFileset *newP, XrdFrmFileset *oldP);
-void              Reset();
 
-static const int  SCshift =  0;
-static const int  MNshift =  6;
-static const int  HRshift = 12;
-static const int  tMask = 0x3f;
-static const int  dVal  = 24*60*60;
+struct Better
+      {bool operator()(XrdFrmFileset *fsp1, XrdFrmFileset *fsp2) const;
+       int  sortSZ;
+             Better(int szSort) : sortSZ(szSort) {}
+      };
 
-XrdFrmFileset    *FSTab[4][64];
-time_t            baseT;
+std::vector<XrdFrmFileset *> Heap;
 int               sortSZ;
-int               numEnt;
-
-int               DYent;   // [0,DYent]
-int               HRent;   // [1,HRent]
-int               MNent;   // [2,MNent]
-int               SCent;   // [3,SCent]
+int               maxEnt;
+int               numDrop;
+bool              isSorted;  // Heap is ordered worst to best candidate
 };
 #endif
@@ -569,15 +569,26 @@ int XrdHttpProtocol::Process(XrdLink *lp) // We ignore the argument here
         return -1;
       }
 
+      // A socket event supersedes any pending pipelined request check
+      PipeRedrive = false;
+
       // If we need more bytes, let's wait for another invokation
       if (BuffUsed() < ResumeBytes) return 1;
 
 
+    } else if (PipeRedrive) {
+      // We asked to be re-invoked only to look for a pipelined request. If
+      // the previous one is still in progress behave as if we never were.
+      PipeRedrive = false;
+      if (CurrentReq.request != XrdHttpReq::rtUnset) return 1;
     } else
-      CurrentReq.reqstate++;
+      // A re-invocation after the previous request completed (i.e. it was
+      // reset) starts a pipelined request, so it must begin in state 0
+      if (CurrentReq.request != XrdHttpReq::rtUnset) CurrentReq.reqstate++;
   }
   DoingLogin = false;
 
+nextRequest:
 
   // Read the next request header, that is, read until a double CRLF is found
 
@@ -867,6 +878,22 @@ int XrdHttpProtocol::Process(XrdLink *lp) // We ignore the argument here
   if (rc < 0)
      CurrentReq.reset();
 
+  // If the request was completed and the client already pipelined the next
+  // one into our buffer, process it now. Otherwise, we would wait for a
+  // socket event that may never come as the data has already been read.
+  else if (CurrentReq.request == XrdHttpReq::rtUnset && BuffUsed() > 0) {
+    TRACEI(REQ, "Processing pipelined request; buffered bytes: " << BuffUsed());
+    goto nextRequest;
+  }
+
+  // The request will complete asynchronously but there is more data in the
+  // buffer. Ask the bridge to re-invoke us afterwards so that the pipelined
+  // request gets processed; the bridge ignores this if nothing is pending.
+  else if (rc > 0 && Bridge && BuffUsed() > 0) {
+    PipeRedrive = true;
+    rc = 0;
+  }
+
 
 
   TRACEI(REQ, "Process is exiting rc:" << rc);
@@ -1492,6 +1519,33 @@ int XrdHttpProtocol::SendData(const char *body, int bodylen) {
   return 0;
 }
 
+/******************************************************************************/
+
+int XrdHttpProtocol::SendData(const struct iovec *iov, int iovcnt, int bodylen) {
+
+  int r;
+
+  if (iovcnt > 0 && bodylen) {
+    TRACE(REQ, "Sending " << bodylen << " bytes in " << iovcnt << " segments");
+    if (ishttps) {
+      for (int i = 0; i < iovcnt; i++) {
+        if (!iov[i].iov_len) continue;
+        r = SSL_write(ssl, iov[i].iov_base, iov[i].iov_len);
+        if (r <= 0) {
+          ERR_print_errors(sslbio_err);
+          return -1;
+        }
+      }
+
+    } else {
+      r = Link->Send(iov, iovcnt, bodylen);
+      if (r <= 0) return -1;
+    }
+  }
+
+  return 0;
+}
+
 /******************************************************************************/
 /*                       S t a r t S i m p l e R e s p                        */
 /******************************************************************************/
@@ -1512,6 +1566,7 @@ int XrdHttpProtocol::StartSimpleResp(int code, const char *desc, const char *hea
     else if (code == 403) ss << "Forbidden";
     else if (code == 404) ss << "Not Found";
     else if (code == 405) ss << "Method Not Allowed";
+    else if (code == 416) ss << "Range Not Satisfiable";
     else if (code == 500) ss << "Internal Server Error";
     else ss << "Unknown";
   }
@@ -1789,6 +1844,7 @@ void XrdHttpProtocol::Reset() {
   myBuffStart = myBuffEnd = 0;
 
   DoingLogin = false;
+  PipeRedrive = false;
 
   ResumeBytes = 0;
   Resume = 0;
@@ -146,6 +146,9 @@ private:
   /// Send some generic data to the client
   int SendData(const char *body, int bodylen);
 
+  /// Send a gather list of data to the client without copying it
+  int SendData(const struct iovec *iov, int iovcnt, int bodylen);
+
   /// Deallocate resources, in order to reutilize an object of this class
   void Cleanup();
 
@@ -282,6 +285,9 @@ private:
   
   /// Tells that we are just logging in
   bool DoingLogin;
+
+  /// Tells that we asked the bridge to re-invoke us for a pipelined request
+  bool PipeRedrive;
   
   /// Tells that we are just waiting to have N bytes in the buffer
   long ResumeBytes;
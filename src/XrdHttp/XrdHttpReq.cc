@@ -63,12 +63,100 @@
 #define MAX_TK_LEN      256
 #define MAX_RESOURCE_LEN 16384
 
+// The multipart/byteranges boundary and the largest part header it yields
+static const char mpBoundary[] = "123456";
+static const int  mpHdrMax     = 192;
+
 // This is to fix the trace macros
 #define TRACELINK prot->Link
 
 namespace
 {
 const char *TraceID = "Req";
+
+// Request methods and headers that we act upon are recognized via a perfect
+// hash over the token length and its first and last characters. The hash
+// tables are built, and checked for collisions, at compile time so that a
+// lookup is a single probe followed by one string comparison.
+//
+enum HdrID {hdrOther = 0, hdrConnection, hdrContentLength, hdrDepth,
+            hdrDestination, hdrExpect, hdrHost, hdrRange, hdrXferEncoding,
+            hdrWantDigest};
+
+struct TokenName {const char *name; int nlen; int tid;};
+
+struct TokenTable {TokenName slot[32];};
+
+constexpr TokenName hdrNames[] =
+   {{"Connection",        10, hdrConnection},
+    {"Content-Length",    14, hdrContentLength},
+    {"Depth",              5, hdrDepth},
+    {"Destination",       11, hdrDestination},
+    {"Expect",             6, hdrExpect},
+    {"Host",               4, hdrHost},
+    {"Range",              5, hdrRange},
+    {"Transfer-Encoding", 17, hdrXferEncoding},
+    {"Want-Digest",       11, hdrWantDigest}
+   };
+
+constexpr TokenName verbNames[] =
+   {{"DELETE",   6, XrdHttpReq::rtDELETE},
+    {"GET",      3, XrdHttpReq::rtGET},
+    {"HEAD",     4, XrdHttpReq::rtHEAD},
+    {"MKCOL",    5, XrdHttpReq::rtMKCOL},
+    {"MOVE",     4, XrdHttpReq::rtMOVE},
+    {"OPTIONS",  7, XrdHttpReq::rtOPTIONS},
+    {"PATCH",    5, XrdHttpReq::rtPATCH},
+    {"POST",     4, XrdHttpReq::rtPOST},
+    {"PROPFIND", 8, XrdHttpReq::rtPROPFIND},
+    {"PUT",      3, XrdHttpReq::rtPUT}
+   };
+
+constexpr int tokLower(char c) {return (c >= 'A' && c <= 'Z' ? c+('a'-'A') : c);}
+
+constexpr int tokHash(const char *tok, int tlen)
+   {return (tlen + 2*tokLower(tok[0]) + 4*tokLower(tok[tlen-1])) & 31;}
+
+template<int N>
+constexpr TokenTable tokTable(const TokenName (&names)[N])
+{
+   TokenTable tab = {};
+   for (int i = 0; i < N; i++)
+       tab.slot[tokHash(names[i].name, names[i].nlen)] = names[i];
+   return tab;
+}
+
+template<int N>
+constexpr bool tokPerfect(const TokenName (&names)[N])
+{
+   for (int i = 0; i < N; i++)
+   for (int j = i+1; j < N; j++)
+       if (tokHash(names[i].name, names[i].nlen)
+       ==  tokHash(names[j].name, names[j].nlen)) return false;
+   return true;
+}
+
+static_assert(tokPerfect(hdrNames),  "header name hash is not perfect");
+static_assert(tokPerfect(verbNames), "request verb hash is not perfect");
+
+constexpr TokenTable hdrTable  = tokTable(hdrNames);
+constexpr TokenTable verbTable = tokTable(verbNames);
+
+// Header names are case insensitive (RFC 7230 3.2) while methods are not.
+//
+int hdrLookup(const char *key, int klen)
+{
+   const TokenName &tn = hdrTable.slot[tokHash(key, klen)];
+   return (tn.nlen == klen && !strncasecmp(key, tn.name, klen)
+        ? tn.tid : hdrOther);
+}
+
+int verbLookup(const char *verb, int vlen)
+{
+   const TokenName &tn = verbTable.slot[tokHash(verb, vlen)];
+   return (tn.nlen == vlen && !memcmp(verb, tn.name, vlen)
+        ? tn.tid : XrdHttpReq::rtUnknown);
+}
 }
 
 static std::string convert_digest_rfc_name(const std::string &rfc_name_multiple)
@@ -217,7 +305,8 @@ int XrdHttpReq::parseLine(char *line, int len) {
   if (!line) return -1;
 
 
-  char *p = strchr((char *) line, (int) ':');
+  // A single scan for the separator (memchr() is vectorized in most libc's)
+  char *p = (char *) memchr(line, ':', len);
   if (!p) {
 
     request = rtMalformed;
@@ -250,38 +339,62 @@ int XrdHttpReq::parseLine(char *line, int len) {
     // The value is val
     
     // Screen out the needed header lines
-    if (!strcmp(key, "Connection")) {
+    bool handled = true;
+    switch (hdrLookup(key, pos)) {
+
+      case hdrConnection:
+        if (!strcasecmp(val, "Keep-Alive\r\n")) {
+          keepalive = true;
+        } else if (!strcasecmp(val, "close\r\n")) {
+          keepalive = false;
+        }
+        break;
 
-      if (!strcasecmp(val, "Keep-Alive\r\n")) {
-        keepalive = true;
-      } else if (!strcasecmp(val, "close\r\n")) {
-        keepalive = false;
-      }
+      case hdrHost:
+        parseHost(val);
+        break;
 
-    } else if (!strcmp(key, "Host")) {
-      parseHost(val);
-    } else if (!strcmp(key, "Range")) {
-      parseContentRange(val);
-    } else if (!strcmp(key, "Content-Length")) {
-      length = atoll(val);
-
-    } else if (!strcmp(key, "Destination")) {
-      destination.assign(val, line+len-val);
-      trim(destination);
-    } else if (!strcmp(key, "Want-Digest")) {
-      m_req_digest.assign(val, line + len - val);
-      trim(m_req_digest);
-    } else if (!strcmp(key, "Depth")) {
-      depth = -1;
-      if (strcmp(val, "infinity"))
-        depth = atoll(val);
-
-    } else if (!strcmp(key, "Expect") && strstr(val, "100-continue")) {
-      sendcontinue = true;
-    } else if (!strcasecmp(key, "Transfer-Encoding") && strstr(val, "chunked")) {
-      m_transfer_encoding_chunked = true;
-    } else {
-      // Some headers need to be translated into "local" cgi info.
+      case hdrRange:
+        parseContentRange(val);
+        break;
+
+      case hdrContentLength:
+        length = atoll(val);
+        break;
+
+      case hdrDestination:
+        destination.assign(val, line+len-val);
+        trim(destination);
+        break;
+
+      case hdrWantDigest:
+        m_req_digest.assign(val, line + len - val);
+        trim(m_req_digest);
+        break;
+
+      case hdrDepth:
+        depth = -1;
+        if (strcmp(val, "infinity"))
+          depth = atoll(val);
+        break;
+
+      case hdrExpect:
+        if (strstr(val, "100-continue")) sendcontinue = true;
+          else handled = false;
+        break;
+
+      case hdrXferEncoding:
+        if (strstr(val, "chunked")) m_transfer_encoding_chunked = true;
+          else handled = false;
+        break;
+
+      default:
+        handled = false;
+        break;
+    }
+
+    // Some headers need to be translated into "local" cgi info.
+    if (!handled && !prot->hdr2cgimap.empty()) {
       std::map< std:: string, std:: string > ::iterator it = prot->hdr2cgimap.find(key);
       if (it != prot->hdr2cgimap.end() && (opaque ? (0 == opaque->Get(it->second.c_str())) : true)) {
         std:: string s;
@@ -403,7 +516,7 @@ int XrdHttpReq::parseFirstLine(char *line, int len) {
   if (!line) return -1;
 
   // Look for the first space-delimited token
-  char *p = strchr((char *) line, (int) ' ');
+  char *p = (char *) memchr(line, ' ', len);
   if (!p) {
     request = rtMalformed;
     return -1;
@@ -439,32 +552,8 @@ int XrdHttpReq::parseFirstLine(char *line, int len) {
 
     *p = ' ';
 
-    // Xlate the known header lines
-    if (!strcmp(key, "GET")) {
-      request = rtGET;
-    } else if (!strcmp(key, "HEAD")) {
-      request = rtHEAD;
-    } else if (!strcmp(key, "PUT")) {
-      request = rtPUT;
-    } else if (!strcmp(key, "POST")) {
-      request = rtPOST;
-    } else if (!strcmp(key, "PATCH")) {
-      request = rtPATCH;
-    } else if (!strcmp(key, "OPTIONS")) {
-      request = rtOPTIONS;
-    } else if (!strcmp(key, "DELETE")) {
-      request = rtDELETE;
-    } else if (!strcmp(key, "PROPFIND")) {
-      request = rtPROPFIND;
-
-    } else if (!strcmp(key, "MKCOL")) {
-      request = rtMKCOL;
-
-    } else if (!strcmp(key, "MOVE")) {
-      request = rtMOVE;
-    } else {
-      request = rtUnknown;
-    }
+    // Xlate the known request methods
+    request = (ReqType) verbLookup(key, pos);
     
     requestverb = key;
 
@@ -560,22 +649,56 @@ int XrdHttpReq::ReqReadV() {
   return (j * sizeof (struct readahead_list));
 }
 
-std::string XrdHttpReq::buildPartialHdr(long long bytestart, long long byteend, long long fsz, char *token) {
-  ostringstream s;
-
-  s << "\r\n--" << token << "\r\n";
-  s << "Content-type: text/plain; charset=UTF-8\r\n";
-  s << "Content-range: bytes " << bytestart << "-" << byteend << "/" << fsz << "\r\n\r\n";
+int XrdHttpReq::buildPartialHdr(char *buff, int blen, long long bytestart, long long byteend, long long fsz, const char *token) {
+  int n = snprintf(buff, blen, "\r\n--%s\r\n"
+                   "Content-type: text/plain; charset=UTF-8\r\n"
+                   "Content-range: bytes %lld-%lld/%lld\r\n\r\n",
+                   token, bytestart, byteend, fsz);
 
-  return s.str();
+  return (n < blen ? n : blen - 1);
 }
 
-std::string XrdHttpReq::buildPartialHdrEnd(char *token) {
-  ostringstream s;
+int XrdHttpReq::buildPartialHdrEnd(char *buff, int blen, const char *token) {
+  int n = snprintf(buff, blen, "\r\n--%s--\r\n", token);
+
+  return (n < blen ? n : blen - 1);
+}
 
-  s << "\r\n--" << token << "--\r\n";
+void XrdHttpReq::coalesceRanges() {
+  // Ranges are only merged when they are all well formed, otherwise we keep
+  // them as the client sent them
+  for (size_t i = 0; i < rwOps.size(); i++)
+    if (rwOps[i].bytestart < 0 || rwOps[i].byteend < rwOps[i].bytestart) return;
+
+  // Merge each range with its predecessor when they overlap or are adjacent,
+  // preserving the order given by the client (RFC 7233 4.1)
+  size_t j = 0;
+  for (size_t i = 0; i < rwOps.size(); i++) {
+    if (rwOps[i].bytestart > filesize - 1) continue;
+    if (rwOps[i].byteend > filesize - 1) rwOps[i].byteend = filesize - 1;
+
+    if (j > 0 && rwOps[i].bytestart <= rwOps[j-1].byteend + 1
+              && rwOps[i].byteend + 1 >= rwOps[j-1].bytestart) {
+      rwOps[j-1].bytestart = min(rwOps[j-1].bytestart, rwOps[i].bytestart);
+      rwOps[j-1].byteend   = max(rwOps[j-1].byteend,   rwOps[i].byteend);
+    } else rwOps[j++] = rwOps[i];
+  }
+  rwOps.resize(j);
 
-  return s.str();
+  // Rebuild the readv chunk list from the surviving ranges
+  rwOps_split.clear();
+  length = 0;
+  for (size_t i = 0; i < rwOps.size(); i++) {
+    long long pos = rwOps[i].bytestart;
+    while (pos <= rwOps[i].byteend) {
+      ReadWriteOp nfo;
+      nfo.bytestart = pos;
+      nfo.byteend = min(rwOps[i].byteend, pos + READV_MAXCHUNKSIZE - 1);
+      pos = nfo.byteend + 1;
+      length += nfo.byteend - nfo.bytestart + 1;
+      rwOps_split.push_back(nfo);
+    }
+  }
 }
 
 bool XrdHttpReq::Data(XrdXrootd::Bridge::Context &info, //!< the result context
@@ -2153,11 +2276,12 @@ int XrdHttpReq::PostProcessHTTPReq(bool final_) {
                          << " stat=" << (char *) iovP[0].iov_base);
                 
                 long dummyl;
-                sscanf((const char *) iovP[0].iov_base, "%ld %lld %ld %ld",
-                       &dummyl,
-                       &filesize,
-                       &fileflags,
-                       &filemodtime);
+                filesizeok = sscanf((const char *) iovP[0].iov_base,
+                                    "%ld %lld %ld %ld",
+                                    &dummyl,
+                                    &filesize,
+                                    &fileflags,
+                                    &filemodtime) >= 2;
 
                 // We will default the response size specified by the headers; if that
                 // wasn't given, use the file size.
@@ -2207,11 +2331,12 @@ int XrdHttpReq::PostProcessHTTPReq(bool final_) {
                            << " stat=" << (char *) iovP[1].iov_base);
               
                   long dummyl;
-                  sscanf((const char *) iovP[1].iov_base, "%ld %lld %ld %ld",
-                        &dummyl,
-                        &filesize,
-                        &fileflags,
-                        &filemodtime);
+                  filesizeok = sscanf((const char *) iovP[1].iov_base,
+                                      "%ld %lld %ld %ld",
+                                      &dummyl,
+                                      &filesize,
+                                      &fileflags,
+                                      &filemodtime) >= 2;
 
                   // As above: if the client specified a response size, we use that.
                   // Otherwise, utilize the filesize
@@ -2223,6 +2348,25 @@ int XrdHttpReq::PostProcessHTTPReq(bool final_) {
                   TRACEI(ALL, "GET returned no STAT information. Internal error?");
               }
               
+              // Merge overlapping and adjacent ranges now that we know the
+              // filesize. If none of the requested ranges is within the file
+              // the request can't be satisfied (RFC 7233 4.4). Without a
+              // filesize we can neither clip the ranges nor describe them.
+              if (rwOps.size() > 0) {
+                if (!filesizeok) {
+                  prot->SendSimpleResp(500, NULL, NULL, (char *) "Unable to determine the file size for the requested ranges.", 0, false);
+                  return -1;
+                }
+                coalesceRanges();
+                if (rwOps.size() == 0) {
+                  char buf[64];
+                  snprintf(buf, sizeof(buf), "Content-Range: bytes */%lld",
+                           filesize);
+                  prot->SendSimpleResp(416, NULL, buf, NULL, 0, keepalive);
+                  return 0;
+                }
+              }
+
               if (rwOps.size() == 0) {
                 // Full file.
                 
@@ -2247,6 +2391,7 @@ int XrdHttpReq::PostProcessHTTPReq(bool final_) {
               } else
                 if (rwOps.size() > 1) {
                 // Multiple reads to perform, compose and send the header
+                char hbuf[mpHdrMax];
                 int cnt = 0;
                 for (size_t i = 0; i < rwOps.size(); i++) {
 
@@ -2256,13 +2401,15 @@ int XrdHttpReq::PostProcessHTTPReq(bool final_) {
 
                   cnt += (rwOps[i].byteend - rwOps[i].bytestart + 1);
 
-                  cnt += buildPartialHdr(rwOps[i].bytestart,
+                  cnt += buildPartialHdr(hbuf, sizeof(hbuf),
+                          rwOps[i].bytestart,
                           rwOps[i].byteend,
                           filesize,
-                          (char *) "123456").size();
+                          mpBoundary);
                 }
-                cnt += buildPartialHdrEnd((char *) "123456").size();
-                std::string header = "Content-Type: multipart/byteranges; boundary=123456";
+                cnt += buildPartialHdrEnd(hbuf, sizeof(hbuf), mpBoundary);
+                std::string header = "Content-Type: multipart/byteranges; boundary=";
+                header += mpBoundary;
                 if (!m_digest_header.empty()) {
                   header += "\n";
                   header += m_digest_header;
@@ -2313,10 +2460,26 @@ int XrdHttpReq::PostProcessHTTPReq(bool final_) {
 
             TRACEI(REQ, "Got data vectors to send:" << iovN);
             if (ntohs(xrdreq.header.requestid) == kXR_readv) {
-              // Readv case, we must take out each individual header and format it according to the http rules
+              // Readv case, we must take out each individual header and format it according to the http rules.
+              // The data is sent directly from the readv buffers, interleaved with the part headers,
+              // using a single gathered write.
               readahead_list *l;
-              char *p;
-              int len;
+              char *p, *hp;
+              int len, nChunks = 0, bytes = 0;
+
+              // Count the chunks so that we can size the gather list and the header space
+              for (int i = 0; i < iovN; i++) {
+                for (p = (char *) iovP[i].iov_base; p < (char *) iovP[i].iov_base + iovP[i].iov_len;) {
+                  l = (readahead_list *) p;
+                  p += sizeof (readahead_list) + ntohl(l->rlen);
+                  nChunks++;
+                }
+              }
+              mpIov.resize(nChunks*2 + 1);
+              if (mpHdrs.size() < (size_t)(nChunks+1)*mpHdrMax) mpHdrs.resize((nChunks+1)*mpHdrMax);
+              struct iovec *iov = mpIov.data();
+              int iovcnt = 0;
+              hp = mpHdrs.data();
 
               // Cycle on all the data that is coming from the server
               for (int i = 0; i < iovN; i++) {
@@ -2328,17 +2491,23 @@ int XrdHttpReq::PostProcessHTTPReq(bool final_) {
                   // Now we have a chunk coming from the server. This may be a partial chunk
 
                   if (rwOpPartialDone == 0) {
-                    string s = buildPartialHdr(rwOps[rwOpDone].bytestart,
+                    int hlen = buildPartialHdr(hp, mpHdrMax,
+                            rwOps[rwOpDone].bytestart,
                             rwOps[rwOpDone].byteend,
                             filesize,
-                            (char *) "123456");
+                            mpBoundary);
 
                     TRACEI(REQ, "Sending multipart: " << rwOps[rwOpDone].bytestart << "-" << rwOps[rwOpDone].byteend);
-                    if (prot->SendData((char *) s.c_str(), s.size())) return -1;
+                    iov[iovcnt].iov_base = hp;
+                    iov[iovcnt++].iov_len = hlen;
+                    bytes += hlen;
+                    hp += hlen;
                   }
 
                   // Send all the data we have
-                  if (prot->SendData(p + sizeof (readahead_list), len)) return -1;
+                  iov[iovcnt].iov_base = p + sizeof (readahead_list);
+                  iov[iovcnt++].iov_len = len;
+                  bytes += len;
 
                   // If we sent all the data relative to the current original chunk request
                   // then pass to the next chunk, otherwise wait for more data
@@ -2355,10 +2524,14 @@ int XrdHttpReq::PostProcessHTTPReq(bool final_) {
               }
 
               if (rwOpDone == rwOps.size()) {
-                string s = buildPartialHdrEnd((char *) "123456");
-                if (prot->SendData((char *) s.c_str(), s.size())) return -1;
+                int hlen = buildPartialHdrEnd(hp, mpHdrMax, mpBoundary);
+                iov[iovcnt].iov_base = hp;
+                iov[iovcnt++].iov_len = hlen;
+                bytes += hlen;
               }
 
+              if (prot->SendData(iov, iovcnt, bytes)) return -1;
+
             } else
               for (int i = 0; i < iovN; i++) {
                 if (prot->SendData((char *) iovP[i].iov_base, iovP[i].iov_len)) return -1;
@@ -2822,6 +2995,7 @@ void XrdHttpReq::reset() {
   keepalive = true;
   length = 0;
   filesize = 0;
+  filesizeok = false;
   depth = 0;
   sendcontinue = false;
 
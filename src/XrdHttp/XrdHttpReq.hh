@@ -128,6 +128,7 @@ public:
     opaque = 0;
     writtenbytes = 0;
     fopened = false;
+    filesizeok = false;
     headerok = false;
   };
 
@@ -148,11 +149,15 @@ public:
   int ReqReadV();
   readahead_list *ralist;
 
-  /// Build a partial header for a multipart response
-  std::string buildPartialHdr(long long bytestart, long long byteend, long long filesize, char *token);
+  /// Build a partial header for a multipart response into buff, returning its length
+  int buildPartialHdr(char *buff, int blen, long long bytestart, long long byteend, long long filesize, const char *token);
 
-  /// Build the closing part for a multipart response
-  std::string buildPartialHdrEnd(char *token);
+  /// Build the closing part for a multipart response into buff, returning its length
+  int buildPartialHdrEnd(char *buff, int blen, const char *token);
+
+  /// Merge overlapping or adjacent ranges of a multi-range request and
+  /// drop the ones beyond the end of the file. Requires the filesize.
+  void coalesceRanges();
 
   // Appends the opaque info that we have
   // NOTE: this function assumes that the strings are unquoted, and will quote them
@@ -239,6 +244,11 @@ public:
   /// To coordinate multipart responses across multiple calls
   unsigned int rwOpDone, rwOpPartialDone;
 
+  /// Gather list and part header storage used to send multipart responses
+  /// directly from the readv buffers
+  std::vector<struct iovec> mpIov;
+  std::vector<char> mpHdrs;
+
   /// The last issued xrd request, often pending
   ClientRequest xrdreq;
 
@@ -256,6 +266,7 @@ public:
 
   // The latest stat info got from the xrd layer
   long long filesize;
+  bool filesizeok; //!< true -> filesize came from a stat
   long fileflags;
   long filemodtime;
   char fhandle[4];
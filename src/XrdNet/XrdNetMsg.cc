@@ -30,6 +30,7 @@
 
 #include <cerrno>
 #include <sys/poll.h>
+#include <sys/uio.h>
 
 #include "XrdNet/XrdNet.hh"
 #include "XrdNet/XrdNetMsg.hh"
@@ -37,6 +38,13 @@
 #include "XrdSys/XrdSysError.hh"
 #include "XrdSys/XrdSysPlatform.hh"
 
+/******************************************************************************/
+/*                        S t a t i c   M e m b e r s                         */
+/******************************************************************************/
+
+RAtomic_llong XrdNetMsg::batchCalls = {0};
+RAtomic_llong XrdNetMsg::batchPkts  = {0};
+
 /******************************************************************************/
 /*                           C o n s t r u c t o r                            */
 /******************************************************************************/
@@ -134,6 +142,66 @@ int XrdNetMsg::Send(const struct iovec iov[], int iovcnt,
    return Send(buff, (int)(bp-buff), dest, -1);
 }
   
+/******************************************************************************/
+/*                             S e n d B a t c h                              */
+/******************************************************************************/
+
+int XrdNetMsg::SendBatch(const struct iovec msgv[], int msgc,
+                         const char  *dest,         int tmo)
+{
+   XrdNetAddr *theDest;
+   int retc;
+
+   if (msgc <= 0) return 0;
+
+   if (!dest)
+       {if (!destOK)
+           {eDest->Emsg("Msg", "Destination not specified."); return -1;}
+        theDest = &dfltDest;
+       }
+      else if (specDest.Set(dest))
+              {eDest->Emsg("Msg", dest, "is unreachable");    return -1;}
+              else theDest = &specDest;
+
+   if (tmo >= 0 && !OK2Send(tmo, dest)) return 1;
+
+#ifdef __linux__
+// Send the messages using as few sendmmsg() calls as possible. Each message
+// references the caller's buffer directly so that no copying is needed.
+//
+   static const int maxMsgs = 64;
+   struct mmsghdr mmh[maxMsgs];
+   int i, n;
+
+   while(msgc > 0)
+        {n = (msgc > maxMsgs ? maxMsgs : msgc);
+         memset(mmh, 0, sizeof(struct mmsghdr)*n);
+         for (i = 0; i < n; i++)
+             {mmh[i].msg_hdr.msg_name    = (void *)theDest->SockAddr();
+              mmh[i].msg_hdr.msg_namelen = theDest->SockSize();
+              mmh[i].msg_hdr.msg_iov     = (struct iovec *)&msgv[i];
+              mmh[i].msg_hdr.msg_iovlen  = 1;
+             }
+         do {retc = sendmmsg(FD, mmh, n, 0);}
+             while (retc < 0 && errno == EINTR);
+         if (retc < 0) return retErr(errno, theDest);
+         batchCalls++; batchPkts += retc;
+         msgv += retc; msgc -= retc;
+        }
+#else
+// There is no batched send on this platform, so send one message at a time.
+//
+   for (int i = 0; i < msgc; i++)
+       {do {retc = sendto(FD, (Sokdata_t)msgv[i].iov_base, msgv[i].iov_len, 0,
+                          theDest->SockAddr(), theDest->SockSize());}
+           while (retc < 0 && errno == EINTR);
+        if (retc < 0) return retErr(errno, theDest);
+        batchCalls++; batchPkts++;
+       }
+#endif
+   return 0;
+}
+
 /******************************************************************************/
 /*                       P r i v a t e   M e t h o d s                        */
 /******************************************************************************/
@@ -42,6 +42,7 @@
 #endif
 
 #include "XrdNet/XrdNetAddr.hh"
+#include "XrdSys/XrdSysRAtomic.hh"
 
 union XrdNetSockAddr;
 class XrdSysError;
@@ -109,6 +110,39 @@ int           Send(const struct  iovec iov[], // Remaining parms as above
                          int     iovcnt,      // Number of elements in iovec
                    const char   *dest=0,      // Hostname to send UDP datagram
                          int     tmo=-1);     // Timeout in ms (-1 = none)
+
+//------------------------------------------------------------------------------
+//! Send a batch of UDP messages to an endpoint using as few system calls as
+//! possible (i.e. sendmmsg() where available, otherwise sendto() per message).
+//!
+//! @param  msgv     The vector of messages. Each element is a complete datagram.
+//! @param  msgc     The number of elements in the vector.
+//! @param  dest     The endpint name which can be host:port or a named socket.
+//!                  If dest is zero, uses dest specified in the constructor.
+//! @param  timeout  maximum seconds to wait for a idle socket. When negative,
+//!                  the default, no time limit applies.
+//! @return <0       One or more messages not sent due to error.
+//! @return =0       All messages sent (well as defined by UDP)
+//! @return >0       One or more messages not sent, timeout occurred.
+//------------------------------------------------------------------------------
+
+int           SendBatch(const struct iovec msgv[], // One datagram per element
+                              int    msgc,    // Number of elements in msgv
+                        const char  *dest=0,  // Hostname to send UDP datagram
+                              int    tmo=-1); // Timeout in ms (-1 = none)
+
+//------------------------------------------------------------------------------
+//! Obtain batch send statistics. These are totals for all XrdNetMsg objects.
+//!
+//! @param  calls    Set to the number of send system calls issued by
+//!                  SendBatch().
+//! @param  pkts     Set to the number of packets sent by those calls. The
+//!                  ratio pkts/calls gives the average packets per call.
+//------------------------------------------------------------------------------
+
+static void   Stats(long long &calls, long long &pkts)
+                   {calls = batchCalls; pkts = batchPkts;}
+
 //------------------------------------------------------------------------------
 //! Constructor
 //!
@@ -139,5 +173,7 @@ XrdNetAddr         dfltDest;
 XrdNetAddr         specDest;
 int                destOK;
 int                FD;
+static RAtomic_llong batchCalls;
+static RAtomic_llong batchPkts;
 };
 #endif
@@ -55,6 +55,7 @@
 
 #include "XrdOfs/XrdOfs.hh"
 #include "XrdOfs/XrdOfsChkPnt.hh"
+#include "XrdOfs/XrdOfsCksWrite.hh"
 #include "XrdOfs/XrdOfsConfigCP.hh"
 #include "XrdOfs/XrdOfsEvs.hh"
 #include "XrdOfs/XrdOfsHandle.hh"
@@ -195,6 +196,7 @@ XrdOfs::XrdOfs() : tpcRdrHost{}, tpcRdrPort{}
    poscHold= 10*60;
    poscAuto= 0;
    poscSync= 1;
+   poscGrpc= false;
 
 // Set the configuration file name and dummy handle
 //
@@ -742,6 +744,12 @@ int XrdOfsFile::open(const char          *path,      // In
       {oP.hP->isCompressed = 1;
        dorawio = (open_mode & SFS_O_RAWIO ? 1 : 0);
       }
+
+// If the file starts out empty we may be able to compute its checksums as
+// it is being written, sparing a full read of the file when they are needed.
+//
+   if ((open_mode & crMask) && !XrdOfsFS->OssIsProxy && !oP.hP->isCompressed)
+      oP.hP->cksW = XrdOfsCksWrite::Alloc();
    oP.hP->Activate(oP.fP);
    oP.hP->UnLock();
 
@@ -787,7 +795,8 @@ int XrdOfsFile::close()  // In
          {public: void Retired(XrdOfsHandle *hP) {XrdOfsFS->Unpersist(hP);}};
    static XrdOfsHanCB *hCB = static_cast<XrdOfsHanCB *>(new CloseFH);
 
-   XrdOfsHandle *hP;
+   XrdOfsHandle   *hP;
+   XrdOfsCksWrite *cksW = 0;
    int   poscNum, retc, cRetc = 0;
    short theMode;
 
@@ -850,6 +859,13 @@ int XrdOfsFile::close()  // In
        myCKP = 0;
       }
 
+// If this is the last reference to a file whose checksums were computed as
+// it was written, take over the checksums so they can be stored after the
+// file is closed (i.e. once its modification time can no longer change).
+// Only writers have such checksums so the file size is always returned.
+//
+   if (hP->cksW && hP->Usage() == 1) {cksW = hP->cksW; hP->cksW = 0;}
+
 // We need to handle the cunudrum that an event may have to be sent upon
 // the final close. However, that would cause the path name to be destroyed.
 // So, we have two modes of logic where we copy out the pathname if a final
@@ -865,10 +881,18 @@ int XrdOfsFile::close()  // In
        if (hP->isRW) {theEvent = XrdOfsEvs::Closew; retsz = &FSize;}
           else {      theEvent = XrdOfsEvs::Closer; retsz = 0; FSize=0;}
        if (!(hP->Retire(cRetc, retsz, pathbuff, sizeof(pathbuff))))
-          {XrdOfsEvsInfo evInfo(tident, pathbuff, "" , 0, 0, FSize);
+          {if (cksW && !cRetc) {CksStore(cksW, pathbuff, FSize); cksW = 0;}
+           XrdOfsEvsInfo evInfo(tident, pathbuff, "" , 0, 0, FSize);
            XrdOfsFS->evsObject->Notify(theEvent, evInfo);
           }
-      } else hP->Retire(cRetc);
+       if (cksW) {cksW->Recycle(); cksW = 0;}
+      } else if (!cksW) hP->Retire(cRetc);
+                else {long long FSize;
+                      char pathbuff[MAXPATHLEN+8];
+                      if (hP->Retire(cRetc, &FSize, pathbuff, sizeof(pathbuff))
+                      ||  cRetc) {cksW->Recycle(); cksW = 0;}
+                         else CksStore(cksW, pathbuff, FSize);
+                     }
 
 // All done
 //
@@ -1000,6 +1024,10 @@ int            XrdOfsFile::CreateCKP()
        myCKP = (XrdOucChkPnt *)resp;
       } else myCKP = new XrdOfsChkPnt(oh->Select(), oh->Name());
 
+// A checkpoint restore rewrites the file so its checksums are now unknown
+//
+   if (oh->cksW) oh->cksW->Fail();
+
 // All done
 //
    return 0;
@@ -1201,7 +1229,10 @@ XrdSfsXferSize XrdOfsFile::pgWrite(XrdSfsFileOffset   offset,
    nbytes = (XrdSfsXferSize)(oh->Select().pgWrite((void *)buffer,
                             (off_t)offset, (size_t)wrlen, csvec, pgOpts));
    if (nbytes < 0)
-      return XrdOfsFS->Emsg(epname, error, (int)nbytes, "pgwrite", oh);
+      {if (oh->cksW) oh->cksW->Fail();
+       return XrdOfsFS->Emsg(epname, error, (int)nbytes, "pgwrite", oh);
+      }
+   if (oh->cksW) oh->cksW->Update(offset, buffer, nbytes);
 
 // Return number of bytes written
 //
@@ -1213,6 +1244,7 @@ XrdSfsXferSize XrdOfsFile::pgWrite(XrdSfsFileOffset   offset,
 XrdSfsXferSize XrdOfsFile::pgWrite(XrdSfsAio *aioparm, uint64_t opts)
 {
    EPNAME("aiopgWrite");
+   XrdOfsCksWAio *cksAio = 0;
    uint64_t pgOpts;
    int rc;
 
@@ -1260,11 +1292,14 @@ XrdSfsXferSize XrdOfsFile::pgWrite(XrdSfsAio *aioparm, uint64_t opts)
    if (opts & XrdSfsFile::Verify) pgOpts = XrdOssDF::Verify;
       else pgOpts = 0;
 
-// Write the requested bytes
+// Write the requested bytes (see aio write() as to how checksums are handled)
 //
    oh->isPending = 1;
+   if (oh->cksW) aioparm = cksAio = new XrdOfsCksWAio(aioparm, oh->cksW);
    if ((rc = oh->Select().pgWrite(aioparm, pgOpts)) < 0)
+      {if (cksAio) {cksAio->Recycle(); oh->cksW->Fail();}
        return XrdOfsFS->Emsg(epname, error, rc, "pgwrite", oh->Name());
+      }
 
 // All done
 //
@@ -1483,7 +1518,10 @@ XrdSfsXferSize XrdOfsFile::write(XrdSfsFileOffset  offset,    // In
    nbytes = (XrdSfsXferSize)(oh->Select().Write((const void *)buff,
                             (off_t)offset, (size_t)blen));
    if (nbytes < 0)
-      return XrdOfsFS->Emsg(epname, error, (int)nbytes, "write", oh);
+      {if (oh->cksW) oh->cksW->Fail();
+       return XrdOfsFS->Emsg(epname, error, (int)nbytes, "write", oh);
+      }
+   if (oh->cksW) oh->cksW->Update(offset, buff, nbytes);
 
 // Return number of bytes written
 //
@@ -1499,6 +1537,7 @@ XrdSfsXferSize XrdOfsFile::write(XrdSfsFileOffset  offset,    // In
 int XrdOfsFile::write(XrdSfsAio *aiop)
 {
    EPNAME("aiowrite");
+   XrdOfsCksWAio *cksAio = 0;
    int rc;
 
 // Perform any required tracing
@@ -1528,11 +1567,16 @@ int XrdOfsFile::write(XrdSfsAio *aiop)
    if (XrdOfsFS->evsObject && !(oh->isChanged)
    &&  XrdOfsFS->evsObject->Enabled(XrdOfsEvs::Fwrite)) GenFWEvent();
 
-// Write the requested bytes
+// Write the requested bytes. Should checksums be computed on write, the
+// request is wrapped so that the bytes are fed to the checksums only once the
+// write has succeeded.
 //
    oh->isPending = 1;
+   if (oh->cksW) aiop = cksAio = new XrdOfsCksWAio(aiop, oh->cksW);
    if ((rc = oh->Select().Write(aiop)) < 0)
+      {if (cksAio) {cksAio->Recycle(); oh->cksW->Fail();}
        return XrdOfsFS->Emsg(epname, error, rc, "write", oh->Name());
+      }
 
 // All done
 //
@@ -1690,6 +1734,7 @@ int XrdOfsFile::truncate(XrdSfsFileOffset  flen)  // In
    oh->isPending = 1;
    if ((retc = oh->Select().Ftruncate(flen)))
       return XrdOfsFS->Emsg(epname, error, retc, "truncate", oh);
+   if (oh->cksW) oh->cksW->Trunc(flen);
 
 // Indicate Success
 //
@@ -1722,6 +1767,30 @@ int XrdOfsFile::getCXinfo(char cxtype[4], int &cxrsz)
 /******************************************************************************/
 /*                  P r i v a t e   F i l e   M e t h o d s                   */
 /******************************************************************************/
+/******************************************************************************/
+/* private                      C k s S t o r e                               */
+/******************************************************************************/
+
+void XrdOfsFile::CksStore(XrdOfsCksWrite *cksW, const char *path,
+                          long long fSize)
+{
+   EPNAME("close");
+   char pfnbuff[MAXPATHLEN+8];
+   const char *Xfn = path;
+   int n, retc;
+
+// The checksum manager may need the physical file name
+//
+   if (XrdOfsFS->CksPfn
+   && !(Xfn = XrdOfsOss->Lfn2Pfn(path, pfnbuff, MAXPATHLEN, retc)))
+      {cksW->Recycle(); return;}
+
+// Store whatever checksums we were able to compute
+//
+   n = cksW->Done(Xfn, fSize);
+   ZTRACE(close, n <<" checksum(s) computed on write set for " <<path);
+}
+
 /******************************************************************************/
 /* protected                  G e n F W E v e n t                             */
 /******************************************************************************/
@@ -40,6 +40,7 @@
 #include "XrdCms/XrdCmsClient.hh"
 
 class XrdNetIF;
+class XrdOfsCksWrite;
 class XrdOfsEvs;
 class XrdOfsPocq;
 class XrdOfsPrepare;
@@ -203,6 +204,8 @@ bool           ckpBad;
 
 private:
 
+void           CksStore(XrdOfsCksWrite *cksW, const char *path,
+                        long long fSize);
 void           GenFWEvent();
 int            CreateCKP();
 };
@@ -451,6 +454,7 @@ XrdOfsPoscq      *poscQ;          //    -> poscQ if  persist on close enabled
 char             *poscLog;        //    -> Directory for posc recovery log
 int               poscHold;       //       Seconds to hold a forced close
 short             poscSync;       //       Number of requests before sync
+bool              poscGrpc;       //       Group commit the posc queue
 signed char       poscAuto;       //  1 -> Automatic persist on close
 
 char              ossRW;          // The oss r/w capability
@@ -509,6 +513,7 @@ int           FSctl(XrdOfsFile &file, int cmd, int alen, const char *args,
                     const XrdSecEntity *client);
 int           Reformat(XrdOucErrInfo &);
 const char   *theRole(int opts);
+int           xckw(XrdOucStream &, XrdSysError &);
 int           xcrds(XrdOucStream &, XrdSysError &);
 int           xdirl(XrdOucStream &, XrdSysError &);
 int           xexp(XrdOucStream &, XrdSysError &, bool);
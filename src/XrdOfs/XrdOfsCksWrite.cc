@@ -0,0 +1,269 @@
+/******************************************************************************/
+/*                                                                            */
+/*                     X r d O f s C k s W r i t e . c c                      */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+
+#include "XrdCks/XrdCks.hh"
+#include "XrdCks/XrdCksCalc.hh"
+#include "XrdCks/XrdCksData.hh"
+#include "XrdOfs/XrdOfsCksWrite.hh"
+#include "XrdSys/XrdSysError.hh"
+
+/******************************************************************************/
+/*                        G l o b a l   O b j e c t s                         */
+/******************************************************************************/
+
+extern XrdSysError OfsEroute;
+
+/******************************************************************************/
+/*                        S t a t i c   M e m b e r s                         */
+/******************************************************************************/
+
+XrdCks  *XrdOfsCksWrite::cksMan = 0;
+char    *XrdOfsCksWrite::csList = 0;
+char    *XrdOfsCksWrite::csName[XrdOfsCksWrite::maxCks] = {0};
+int      XrdOfsCksWrite::csNum  = 0;
+
+/******************************************************************************/
+/*                            D e s t r u c t o r                             */
+/******************************************************************************/
+
+XrdOfsCksWrite::~XrdOfsCksWrite()
+{
+   for (int i = 0; i < csNum; i++) if (csObj[i]) csObj[i]->Recycle();
+}
+
+/******************************************************************************/
+/*                                 A l l o c                                  */
+/******************************************************************************/
+
+XrdOfsCksWrite *XrdOfsCksWrite::Alloc()
+{
+   XrdOfsCksWrite *cwP;
+   int i;
+
+// Checksums may not be computed on write
+//
+   if (!csNum) return 0;
+
+// Get a calculator for each checksum. If any is missing, give up.
+//
+   cwP = new XrdOfsCksWrite;
+   for (i = 0; i < csNum; i++) cwP->csObj[i] = cksMan->Object(csName[i]);
+   for (i = 0; i < csNum; i++) if (!(cwP->csObj[i])) break;
+   if (i < csNum) {delete cwP; return 0;}
+
+// Initialize the calculators
+//
+   for (i = 0; i < csNum; i++) cwP->csObj[i]->Init();
+   return cwP;
+}
+
+/******************************************************************************/
+/*                                C o n f i g                                 */
+/******************************************************************************/
+
+bool XrdOfsCksWrite::Config(XrdCks *cksP, XrdSysError &eDest)
+{
+   XrdCksCalc *csP;
+   const char *csN;
+   char *tokP, *next;
+   bool doAll, aOK = true;
+
+// Check if we need to do anything here
+//
+   if (!csList) return true;
+   if (!cksP)
+      {eDest.Say("Config warning: ckswrite ignored; checksums not enabled.");
+       return true;
+      }
+   cksMan = cksP;
+
+// Run through the list of names. The name "all" selects every checksum the
+// checksum manager supports. Each one must be able to compute on the fly.
+//
+   doAll = !strcmp(csList, "all");
+   next  = csList;
+   for (int i = 0; aOK; i++)
+       {if (doAll) {if (!(csN = cksP->Name(i))) break;}
+           else {while(*next == ',') next++;
+                 if (!*next) break;
+                 tokP = next;
+                 if ((next = index(tokP, ','))) *next++ = 0;
+                    else next = tokP + strlen(tokP);
+                 csN = tokP;
+                }
+        if (csNum >= maxCks)
+           {eDest.Say("Config warning: ckswrite ignoring checksum ", csN,
+                      "; too many specified.");
+            continue;
+           }
+        if (!cksP->Size(csN) || !(csP = cksP->Object(csN)))
+           {if (doAll)
+               eDest.Say("Config warning: ckswrite ignoring checksum ", csN,
+                         "; not computable on write.");
+               else {eDest.Emsg("Config", "ckswrite checksum", csN,
+                               "is not computable on write.");
+                     aOK = false;
+                    }
+            continue;
+           }
+        csP->Recycle();
+        csName[csNum++] = strdup(csN);
+       }
+
+// Warn if we ended up with nothing to do
+//
+   if (aOK && !csNum)
+      eDest.Say("Config warning: ckswrite ignored; no usable checksums.");
+   return aOK;
+}
+
+/******************************************************************************/
+/*                                  D o n e                                   */
+/******************************************************************************/
+
+int XrdOfsCksWrite::Done(const char *Xfn, long long fSize)
+{
+   XrdCksData cksData;
+   const char *csVal;
+   int csLen, rc, numSet = 0;
+
+// We can only store the checksums if we saw every byte in the file. Note that
+// there is no need to lock the object as we are the last reference to it.
+//
+   if (!isBad && fSize == nextOffs)
+      {for (int i = 0; i < csNum; i++)
+           {csObj[i]->Type(csLen);
+            csVal = csObj[i]->Final();
+            cksData.Reset();
+            if (!cksData.Set(csName[i])
+            ||  !cksData.Set(static_cast<const void *>(csVal), csLen)) continue;
+            if (!(rc = cksMan->Set(Xfn, cksData))) numSet++;
+               else if (rc != -ENOTSUP)
+                       OfsEroute.Emsg("CksWrite", rc, "set checksum for", Xfn);
+           }
+      }
+
+// All done
+//
+   delete this;
+   return numSet;
+}
+
+/******************************************************************************/
+/*                              S e t P a r m s                               */
+/******************************************************************************/
+
+void XrdOfsCksWrite::SetParms(const char *names)
+{
+   if (csList) free(csList);
+   csList = (names ? strdup(names) : 0);
+}
+
+/******************************************************************************/
+/*                                 T r u n c                                  */
+/******************************************************************************/
+
+void XrdOfsCksWrite::Trunc(long long fSize)
+{
+
+// Truncating to the current length changes nothing. Anything else means we
+// will not see every byte in the file.
+//
+   csMutex.Lock();
+   if (fSize != nextOffs) isBad = true;
+   csMutex.UnLock();
+}
+
+/******************************************************************************/
+/*                                U p d a t e                                 */
+/******************************************************************************/
+
+void XrdOfsCksWrite::Update(long long offs, const char *buff, int blen)
+{
+
+// Only bytes that follow the ones we have already seen can be used. Anything
+// else must be computed the standard way when the checksum is requested.
+//
+   csMutex.Lock();
+   if (!isBad)
+      {if (offs != nextOffs) isBad = true;
+          else {for (int i = 0; i < csNum; i++)
+                    csObj[i]->Update(buff, blen);
+                nextOffs += blen;
+               }
+      }
+   csMutex.UnLock();
+}
+
+/******************************************************************************/
+/*                 X r d O f s C k s W A i o   M e t h o d s                  */
+/******************************************************************************/
+/******************************************************************************/
+/*                           C o n s t r u c t o r                            */
+/******************************************************************************/
+
+XrdOfsCksWAio::XrdOfsCksWAio(XrdSfsAio *aiop, XrdOfsCksWrite *cksp)
+                            : origAio(aiop), cksW(cksp)
+{
+
+// Copy the request. The signal value must remain ours as it is used to find
+// this object when the write completes.
+//
+   sfsAio.aio_buf     = aiop->sfsAio.aio_buf;
+   sfsAio.aio_nbytes  = aiop->sfsAio.aio_nbytes;
+   sfsAio.aio_offset  = aiop->sfsAio.aio_offset;
+   sfsAio.aio_reqprio = aiop->sfsAio.aio_reqprio;
+   cksVec = aiop->cksVec;
+   TIdent = aiop->TIdent;
+   Result = 0;
+}
+
+/******************************************************************************/
+/*                             d o n e W r i t e                              */
+/******************************************************************************/
+
+void XrdOfsCksWAio::doneWrite()
+{
+
+// The buffer is still valid as the original request has not been told that
+// the write completed. Only a complete write can be used for the checksums.
+//
+   if (Result == (ssize_t)sfsAio.aio_nbytes)
+      cksW->Update(sfsAio.aio_offset, (const char *)sfsAio.aio_buf, Result);
+      else cksW->Fail();
+
+// Pass the completion on to the original request
+//
+   origAio->Result = Result;
+   origAio->doneWrite();
+   delete this;
+}
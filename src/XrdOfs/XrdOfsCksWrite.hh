@@ -0,0 +1,135 @@
+#ifndef __XRDOFSCKSWRITE_HH__
+#define __XRDOFSCKSWRITE_HH__
+/******************************************************************************/
+/*                                                                            */
+/*                     X r d O f s C k s W r i t e . h h                      */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include "XrdSfs/XrdSfsAio.hh"
+#include "XrdSys/XrdSysPthread.hh"
+
+class XrdCks;
+class XrdCksCalc;
+class XrdSysError;
+
+/******************************************************************************/
+/*                  C l a s s   X r d O f s C k s W r i t e                   */
+/******************************************************************************/
+
+// XrdOfsCksWrite computes the configured checksums of a newly created or
+// truncated file as it is being written so that the checksums can be stored
+// when the file is closed without having to read the file again. This is only
+// possible as long as the file is written sequentially. Any out of order write
+// or truncate disables the object and the checksum is then computed as usual
+// when it is requested. The object is anchored in the file's handle.
+//
+class XrdOfsCksWrite
+{
+public:
+
+// Alloc() returns a new object or nil if checksums are not computed on write.
+//
+static XrdOfsCksWrite *Alloc();
+
+// Config() resolves the checksum names against the checksum manager. It
+//          returns false if none of the names can be computed on write.
+//
+static bool            Config(XrdCks *cksP, XrdSysError &eDest);
+
+// Done() stores the checksums if all of the file's bytes were seen. The Xfn
+//        is the file name passed to the checksum manager. The number of
+//        checksums stored is returned. The object is deleted.
+//
+       int             Done(const char *Xfn, long long fSize);
+
+// Fail() indicates that the checksums can no longer be computed on write.
+//
+       void            Fail() {csMutex.Lock(); isBad = true; csMutex.UnLock();}
+
+// Recycle() deletes the object without storing any checksums.
+//
+       void            Recycle() {delete this;}
+
+// SetParms() records the names of the checksums to compute on write. The
+//            name "all" selects all of the configured checksums.
+//
+static void            SetParms(const char *names);
+
+// Trunc() handles a truncate of the file.
+//
+       void            Trunc(long long fSize);
+
+// Update() feeds written bytes to the checksums.
+//
+       void            Update(long long offs, const char *buff, int blen);
+
+private:
+       XrdOfsCksWrite() : nextOffs(0), isBad(false) {}
+      ~XrdOfsCksWrite();
+
+static const int  maxCks = 4;
+
+static XrdCks    *cksMan;
+static char      *csList;
+static char      *csName[maxCks];
+static int        csNum;
+
+XrdSysMutex       csMutex;
+XrdCksCalc       *csObj[maxCks];
+long long         nextOffs;
+bool              isBad;
+};
+
+/******************************************************************************/
+/*                   C l a s s   X r d O f s C k s W A i o                    */
+/******************************************************************************/
+
+// XrdOfsCksWAio stands in for an asynchronous write to a file whose checksums
+// are computed on write. The written bytes are only fed to the checksums once
+// the write has completed, as only then is it known whether it succeeded. The
+// completion is then passed on to the original request and the object deletes
+// itself. Should the write not be started, the caller must Recycle() it.
+//
+class XrdOfsCksWAio : public XrdSfsAio
+{
+public:
+
+void doneRead() {}
+
+void doneWrite();
+
+void Recycle() {delete this;}
+
+     XrdOfsCksWAio(XrdSfsAio *aiop, XrdOfsCksWrite *cksp);
+
+    ~XrdOfsCksWAio() {}
+
+private:
+
+XrdSfsAio        *origAio;
+XrdOfsCksWrite   *cksW;
+};
+#endif
@@ -50,6 +50,7 @@
 #include "XrdSfs/XrdSfsFlags.hh"
 
 #include "XrdOfs/XrdOfs.hh"
+#include "XrdOfs/XrdOfsCksWrite.hh"
 #include "XrdOfs/XrdOfsConfigCP.hh"
 #include "XrdOfs/XrdOfsConfigPI.hh"
 #include "XrdOfs/XrdOfsEvs.hh"
@@ -275,6 +276,8 @@ int XrdOfs::Configure(XrdSysError &Eroute, XrdOucEnv *EnvInfo) {
             ofsConfig->Plugin(Cks);
             CksPfn = !ofsConfig->OssCks();
             CksRdr = !ofsConfig->LclCks();
+            if (!(Options & isManager)
+            &&  !XrdOfsCksWrite::Config(Cks, Eroute)) NoGo = 1;
             if (ofsConfig->Plugin(prepHandler))
                {prepAuth = ofsConfig->PrepAuth();
                 FeatureSet |= XrdSfs::hasPRP2;
@@ -398,13 +401,14 @@ void XrdOfs::Config_Display(XrdSysError &Eroute)
                                   "       all.role %s\n"
                                   "%s"
                                   "       ofs.maxdelay   %d\n"
-                                  "       ofs.persist    %s hold %d%s%s\n"
+                                  "       ofs.persist    %s hold %d%s%s%s\n"
                                   "       ofs.trace      %x",
               cloc, myRole,
               (Options & Authorize ? "       ofs.authorize\n" : ""),
                MaxDelay,
                pval, poscHold, (poscLog ? " logdir " : ""),
-               (poscLog ? poscLog    : ""), OfsTrace.What);
+               (poscLog ? poscLog    : ""), (poscGrpc ? " sync group" : ""),
+               OfsTrace.What);
 
      Eroute.Say(buff);
      ofsConfig->Display();
@@ -527,7 +531,8 @@ int XrdOfs::ConfigPosc(XrdSysError &Eroute)
 
 // Create object then initialize it
 //
-   poscQ = new XrdOfsPoscq(&Eroute, XrdOfsOss, poscLog, int(poscSync));
+   poscQ = new XrdOfsPoscq(&Eroute, XrdOfsOss, poscLog, int(poscSync),
+                           poscGrpc);
    rP = poscQ->Init(rc);
    if (!rc) return 1;
 
@@ -779,6 +784,7 @@ int XrdOfs::ConfigXeq(char *var, XrdOucStream &Config,
     TS_XPI("authlib",       theAutLib);
     TS_XPI("ckslib",        theCksLib);
     TS_Xeq("cksrdsz",       xcrds);
+    TS_Xeq("ckswrite",      xckw);
     TS_XPI("cmslib",        theCmsLib);
     TS_XPI("ctllib",        theCtlLib);
     TS_Xeq("dirlist",       xdirl);
@@ -816,18 +822,61 @@ int XrdOfs::ConfigXeq(char *var, XrdOucStream &Config,
     return 0;
 }
 
+/******************************************************************************/
+/*                                  x c k w                                   */
+/******************************************************************************/
+
+/* Function: xckw
+
+   Purpose:  To parse the directive: ckswrite {all | off | <name>[,<name>]}
+
+             all     computes all of the configured checksums as files are
+                     written.
+             off     does not compute checksums as files are written. This is
+                     the default.
+             <name>  the name of a configured checksum to compute as files
+                     are written. Up to four comma separated names may be
+                     specified.
+
+             Checksums are only computed for files that are created or
+             truncated and then written sequentially. The checksums are set
+             in the file's extended attributes when the file is closed.
+
+  Output: 0 upon success or !0 upon failure.
+*/
+
+int XrdOfs::xckw(XrdOucStream &Config, XrdSysError &Eroute)
+{
+   char *val;
+
+// Get the checksum names
+//
+   if (!(val = Config.GetWord()) || !val[0])
+      {Eroute.Emsg("Config", "ckswrite argument not specified"); return 1;}
+
+// Record the names
+//
+   XrdOfsCksWrite::SetParms(strcmp(val, "off") ? val : 0);
+   return 0;
+}
+
 /******************************************************************************/
 /*                                 x c r d s                                  */
 /******************************************************************************/
   
 /* Function: xcrds
 
-   Purpose:  To parse the directive: cksrdsz <size>
+   Purpose:  To parse the directive: cksrdsz <size> [threads <n>]
 
              <size>  number of bytes to segment reads when calclulating a
                      checksum. Can be suffixed by k,m,g. Maximum is 1g and
                      is automatically set to be atleast 64k and to be a
                      multiple of 64k.
+             <n>     the maximum number of threads used to calculate the
+                     checksum of a file that is at least twice <size>. The
+                     file is split into segments whose checksums are combined.
+                     This only applies to adler32, crc32, and crc32c. The
+                     default is 1 (i.e. sequential); the maximum is 64.
 
   Output: 0 upon success or !0 upon failure.
 */
@@ -837,6 +886,7 @@ int XrdOfs::xcrds(XrdOucStream &Config, XrdSysError &Eroute)
    static const long long maxRds = 1024*1024*1024;
    char *val;
    long long rdsz;
+   int rdthr = 0;
 
 // Get the size
 //
@@ -846,7 +896,19 @@ int XrdOfs::xcrds(XrdOucStream &Config, XrdSysError &Eroute)
 // Now convert it
 //
    if (XrdOuca2x::a2sz(Eroute, "cksrdsz size", val, &rdsz, 1, maxRds)) return 1;
-   ofsConfig->SetCksRdSz(static_cast<int>(rdsz));
+
+// Get the optional number of threads
+//
+   if ((val = Config.GetWord()) && *val)
+      {if (strcmp(val, "threads"))
+          {Eroute.Emsg("Config", "invalid cksrdsz option -", val); return 1;}
+       if (!(val = Config.GetWord()) || !*val)
+          {Eroute.Emsg("Config", "cksrdsz threads not specified"); return 1;}
+       if (XrdOuca2x::a2i(Eroute, "cksrdsz threads", val, &rdthr, 1, 64))
+          return 1;
+      }
+
+   ofsConfig->SetCksRdSz(static_cast<int>(rdsz), rdthr);
    return 0;
 }
   
@@ -1256,7 +1318,7 @@ int XrdOfs::xnot(XrdOucStream &Config, XrdSysError &Eroute)
 
    Purpose:  To parse the directive: persist [auto | manual | off]
                                              [hold <sec>] [logdir <dirp>]
-                                             [sync <snum>]
+                                             [sync {<snum> | group}]
 
              auto      POSC processing always on for creation requests
              manual    POSC processing must be requested (default)
@@ -1264,6 +1326,8 @@ int XrdOfs::xnot(XrdOucStream &Config, XrdSysError &Eroute)
              <sec>     Seconds inclomplete files held (default 10m)
              <dirp>    Directory to hold POSC recovery log (default adminpath)
              <snum>    Number of outstanding equests before syncing to disk.
+             group     Sync after every request but have a single thread write
+                       and sync all concurrent requests together.
 
    Output: 0 upon success or !0 upon failure.
 */
@@ -1271,7 +1335,7 @@ int XrdOfs::xnot(XrdOucStream &Config, XrdSysError &Eroute)
 int XrdOfs::xpers(XrdOucStream &Config, XrdSysError &Eroute)
 {
    char *val;
-   int snum = -1, htime = -1, popt = -2;
+   int snum = -1, htime = -1, popt = -2, grpc = -1;
 
    if (!(val = Config.GetWord()))
       {Eroute.Emsg("Config","persist option not specified");return 1;}
@@ -1310,8 +1374,11 @@ int XrdOfs::xpers(XrdOucStream &Config, XrdSysError &Eroute)
                      {Eroute.Emsg("Config","sync value not specified");
                       return 1;
                      }
-                  if (XrdOuca2x::a2i(Eroute,"sync value",val,&snum,0,32767))
-                      return 1;
+                  if (!strcmp(val, "group")) grpc = 1;
+                     else {if (XrdOuca2x::a2i(Eroute,"sync value",val,&snum,
+                                              0,32767)) return 1;
+                           grpc = 0;
+                          }
                  }
          else Eroute.Say("Config warning: ignoring invalid persist option '",val,"'.");
          val = Config.GetWord();
@@ -1322,6 +1389,7 @@ int XrdOfs::xpers(XrdOucStream &Config, XrdSysError &Eroute)
    if (htime >= 0) poscHold = htime;
    if (popt  > -2) poscAuto = popt;
    if (snum  > -1) poscSync = snum;
+   if (grpc  > -1) poscGrpc = grpc;
    return 0;
 }
 
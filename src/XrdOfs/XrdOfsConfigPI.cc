@@ -93,7 +93,8 @@ XrdOfsConfigPI::XrdOfsConfigPI(const char  *cfn,  XrdOucStream     *cfgP,
                  : autPI(0), cksPI(0), cmsPI(0), ctlPI(0), prpPI(0), ossPI(0),
                    sfsPI(sfsP), urVer(verP),
                    Config(cfgP),  Eroute(errP), CksConfig(0), ConfigFN(cfn),
-                   CksAlg(0), CksRdsz(0), ossXAttr(false), ossCksio(0),
+                   CksAlg(0), CksRdsz(0), CksRdthr(0),
+                   ossXAttr(false), ossCksio(0),
                    prpAuth(true), Loaded(false), LoadOK(false), cksLcl(false)
 {
    int rc;
@@ -437,7 +438,8 @@ bool XrdOfsConfigPI::Load(int loadLib, XrdOucEnv *envP)
            return false;
           }
        cksPI = CksConfig->Configure(CksAlg, CksRdsz,
-                                    (ossCksio > 0 ? ossPI : 0), envP);
+                                    (ossCksio > 0 ? ossPI : 0), envP,
+                                    CksRdthr);
        if (!cksPI) return false;
       }
 
@@ -782,7 +784,8 @@ bool XrdOfsConfigPI::RepLib(XrdOfsConfigPI::TheLib what,
 /*                            S e t C k s R d S z                             */
 /******************************************************************************/
 
-void   XrdOfsConfigPI::SetCksRdSz(int rdsz) {CksRdsz = rdsz;}
+void   XrdOfsConfigPI::SetCksRdSz(int rdsz, int rdthr)
+                           {CksRdsz = rdsz; CksRdthr = rdthr;}
   
 /******************************************************************************/
 /* Private:                    S e t u p A t t r                              */
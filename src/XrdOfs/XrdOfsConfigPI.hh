@@ -224,9 +224,10 @@ bool   Push(TheLib what, const char *plugP, const char *parmP=0);
 //! Set the checksum read size
 //!
 //! @param   rdsz    The chesum read size buffer.
+//! @param   rdthr   The number of threads used to checksum a large file.
 //-----------------------------------------------------------------------------
 
-void   SetCksRdSz(int rdsz);
+void   SetCksRdSz(int rdsz, int rdthr=0);
 
 //-----------------------------------------------------------------------------
 //! Destructor
@@ -310,6 +311,7 @@ std::vector<ctlLP> ctlVec;
 
 char         *CksAlg;
 int           CksRdsz;
+int           CksRdthr;
 bool          pushOK[maxXXXLib];
 bool          defLib[maxXXXLib];
 bool          ossXAttr;
@@ -33,9 +33,11 @@
 #include <sys/errno.h>
 #include <sys/types.h>
 
+#include "XrdOfs/XrdOfsCksWrite.hh"
 #include "XrdOfs/XrdOfsHandle.hh"
 #include "XrdOfs/XrdOfsStats.hh"
 #include "XrdOss/XrdOss.hh"
+#include "XrdSys/XrdSysAtomics.hh"
 #include "XrdSys/XrdSysError.hh"
 #include "XrdSys/XrdSysPlatform.hh"
 #include "XrdSys/XrdSysTimer.hh"
@@ -226,6 +228,30 @@ static XrdOfsHanPsc  *Free;
 XrdSysMutex    XrdOfsHanPsc::pscMutex;
 XrdOfsHanPsc  *XrdOfsHanPsc::Free = 0;
 
+/******************************************************************************/
+/*                        X r d O f s H a n S h a r d                         */
+/******************************************************************************/
+
+// Handles are spread over several shards by path hash so that opens and
+// closes of unrelated files do not contend for a single lock. The shard lock
+// protects the tables, the free list and the link counts of its handles. A
+// lookup of an open file only needs the read lock, the link count is then
+// incremented atomically; anything that decrements or tests the count or
+// changes the tables needs the write lock.
+
+class XrdOfsHanShard
+{
+public:
+
+XrdSysRWLock   hLock;
+XrdOfsHanTab   roTable;    // File handles open r/o
+XrdOfsHanTab   rwTable;    // File Handles open r/w
+XrdOfsHandle  *Free;       // List of free handles
+
+               XrdOfsHanShard() : roTable(89, 144), rwTable(89, 144), Free(0) {}
+              ~XrdOfsHanShard() {} // Never gets deleted
+};
+
 /******************************************************************************/
 /*                     E x t e r n a l   L i n k a g e s                      */
 /******************************************************************************/
@@ -244,11 +270,7 @@ extern XrdOfsStats OfsStats;
 /*                        S t a t i c   O b j e c t s                         */
 /******************************************************************************/
   
-XrdSysMutex   XrdOfsHandle::myMutex;
-XrdOfsHanTab  XrdOfsHandle::roTable;
-XrdOfsHanTab  XrdOfsHandle::rwTable;
 XrdOssDF     *XrdOfsHandle::ossDF = (XrdOssDF *)new XrdOfsHanOss;
-XrdOfsHandle *XrdOfsHandle::Free = 0;
 
 /******************************************************************************/
 /*                    c l a s s   X r d O f s H a n d l e                     */
@@ -260,33 +282,43 @@ XrdOfsHandle *XrdOfsHandle::Free = 0;
 int XrdOfsHandle::Alloc(const char *thePath, int Opts, XrdOfsHandle **Handle)
 {
    XrdOfsHandle *hP;
-   XrdOfsHanTab *theTable = (Opts & opRW ? &rwTable : &roTable);
    XrdOfsHanKey theKey(thePath, (int)strlen(thePath));
+   XrdOfsHanShard &myShard = Shard(theKey.Hash);
+   XrdOfsHanTab *theTable = (Opts & opRW ? &myShard.rwTable
+                                          : &myShard.roTable);
    int          retc;
 
-// Lock the search table and try to find the key. If found, increment the
-// the link count (can only be done with the global lock) then release the
+// Read lock the shard and try to find the key. If found, increment the link
+// count (atomically, as other readers may be doing the same) then release the
 // lock and try to lock the handle. It can't escape between lock calls because
 // the link count is positive. If we can't lock the handle then it must be the
 // that a long running operation is occuring. Return the handle to its former
 // state and return a delay. Otherwise, return the handle.
 //
-   myMutex.Lock();
+   myShard.hLock.ReadLock();
    if ((hP = theTable->Find(theKey)))
-      {hP->Path.Links++; myMutex.UnLock();
+      {AtomicInc(hP->Path.Links); myShard.hLock.UnLock();
        if (hP->WaitLock()) {*Handle = hP; return 0;}
-       myMutex.Lock(); hP->Path.Links--; myMutex.UnLock();
+       myShard.hLock.WriteLock(); hP->Path.Links--; myShard.hLock.UnLock();
        return nolokDelay;
       }
+   myShard.hLock.UnLock();
 
-// Get a new handle
+// Get a new handle. As the lock was dropped, someone may have beaten us to it.
 //
-   if (!(retc = Alloc(theKey, Opts, Handle))) theTable->Add(*Handle);
+   myShard.hLock.WriteLock();
+   if ((hP = theTable->Find(theKey)))
+      {hP->Path.Links++; myShard.hLock.UnLock();
+       if (hP->WaitLock()) {*Handle = hP; return 0;}
+       myShard.hLock.WriteLock(); hP->Path.Links--; myShard.hLock.UnLock();
+       return nolokDelay;
+      }
+   if (!(retc = Alloc(myShard, theKey, Opts, Handle))) theTable->Add(*Handle);
    OfsStats.Add(OfsStats.Data.numHandles);
 
 // All done
 //
-   myMutex.UnLock();
+   myShard.hLock.UnLock();
    return retc;
 }
 
@@ -297,12 +329,13 @@ int XrdOfsHandle::Alloc(const char *thePath, int Opts, XrdOfsHandle **Handle)
 int XrdOfsHandle::Alloc(XrdOfsHandle **Handle)
 {
     XrdOfsHanKey myKey("dummy", 5);
+    XrdOfsHanShard &myShard = Shard(myKey.Hash);
     int retc;
 
-    myMutex.Lock();
-    if (!(retc = Alloc(myKey, 0, Handle))) 
+    myShard.hLock.WriteLock();
+    if (!(retc = Alloc(myShard, myKey, 0, Handle)))
        {(*Handle)->Path.Links = 0; (*Handle)->UnLock();}
-    myMutex.UnLock();
+    myShard.hLock.UnLock();
     return retc;
 }
 
@@ -310,10 +343,13 @@ int XrdOfsHandle::Alloc(XrdOfsHandle **Handle)
 /* private                      A l l o c   # 3                               */
 /******************************************************************************/
   
-int XrdOfsHandle::Alloc(XrdOfsHanKey theKey, int Opts, XrdOfsHandle **Handle)
+// The shard must be write locked upon entry.
+
+int XrdOfsHandle::Alloc(XrdOfsHanShard &myShard, XrdOfsHanKey theKey, int Opts,
+                        XrdOfsHandle **Handle)
 {
    static const int minAlloc = 4096/sizeof(XrdOfsHandle);
-   XrdOfsHandle *hP;
+   XrdOfsHandle *hP, *&Free = myShard.Free;
 
 // No handle currently in the table. Get a new one off the free list
 //
@@ -332,6 +368,7 @@ int XrdOfsHandle::Alloc(XrdOfsHanKey theKey, int Opts, XrdOfsHandle **Handle)
        hP->isRW         = (Opts & opPC);           // File mode
        hP->ssi          = ossDF;                   // No storage system yet
        hP->Posc         = 0;                       // No creator
+       hP->cksW         = 0;                       // No write checksums
        hP->Lock();                                 // Wait is not possible
        *Handle = hP;
        return 0;
@@ -347,14 +384,15 @@ void XrdOfsHandle::Hide(const char *thePath)
 {
    XrdOfsHandle *hP;
    XrdOfsHanKey theKey(thePath, (int)strlen(thePath));
+   XrdOfsHanShard &myShard = Shard(theKey.Hash);
 
 // Lock the search table and try to find the key in each table. If found,
 // clear the length field to effectively hide the item.
 //
-   myMutex.Lock();
-   if ((hP = roTable.Find(theKey))) hP->Path.Len = 0;
-   if ((hP = rwTable.Find(theKey))) hP->Path.Len = 0;
-   myMutex.UnLock();
+   myShard.hLock.WriteLock();
+   if ((hP = myShard.roTable.Find(theKey))) hP->Path.Len = 0;
+   if ((hP = myShard.rwTable.Find(theKey))) hP->Path.Len = 0;
+   myShard.hLock.UnLock();
 }
 
 /******************************************************************************/
@@ -373,7 +411,10 @@ int XrdOfsHandle::PoscGet(short &Mode, int Done)
        Mode = Posc->Mode;
        if (Done)
           {pP = Posc; Posc = 0;
-           if (pP->xprP) {myMutex.Lock(); Path.Links--; myMutex.UnLock();}
+           if (pP->xprP)
+              {XrdOfsHanShard &myShard = Shard(Path.Hash);
+               myShard.hLock.WriteLock(); Path.Links--; myShard.hLock.UnLock();
+              }
            pP->Recycle();
           }
        return pnum;
@@ -457,30 +498,34 @@ const char *XrdOfsHandle::PoscUsr()
 
 int XrdOfsHandle::Retire(int &retc, long long *retsz, char *buff, int blen)
 {
+   XrdOfsHanShard &myShard = Shard(Path.Hash);
    XrdOssDF *mySSI;
    int numLeft;
 
-// Get the global lock as the links field can only be manipulated with it.
+// Get the shard lock as the links field can only be decremented with it.
 // Decrement the links count and if zero, remove it from the table and
 // place it on the free list. Otherwise, it is still in use.
 //
    retc = 0;
-   myMutex.Lock();
+   myShard.hLock.WriteLock();
    if (Path.Links == 1)
       {if (buff) strlcpy(buff, Path.Val, blen);
        numLeft = 0; OfsStats.Dec(OfsStats.Data.numHandles);
-       if ( (isRW ? rwTable.Remove(this) : roTable.Remove(this)) )
+       if ( (isRW ? myShard.rwTable.Remove(this)
+                  : myShard.roTable.Remove(this)) )
          {if (Posc) {Posc->Recycle(); Posc = 0;}
+          if (cksW) {cksW->Recycle(); cksW = 0;}
           if (Path.Val) {free((void *)Path.Val); Path.Val = (char *)"";}
           Path.Len = 0; mySSI = ssi; ssi = ossDF;
-          Next = Free; Free = this; UnLock(); myMutex.UnLock();
+          Next = myShard.Free; myShard.Free = this;
+          UnLock(); myShard.hLock.UnLock();
           if (mySSI && mySSI != ossDF)
              {retc = mySSI->Close(retsz); delete mySSI;}
          } else {
-          UnLock(); myMutex.UnLock();
+          UnLock(); myShard.hLock.UnLock();
           OfsEroute.Emsg("Retire", "Lost handle to", buff);
         }
-      } else {numLeft = --Path.Links; UnLock(); myMutex.UnLock();}
+      } else {numLeft = --Path.Links; UnLock(); myShard.hLock.UnLock();}
    return numLeft;
 }
 
@@ -489,20 +534,21 @@ int XrdOfsHandle::Retire(int &retc, long long *retsz, char *buff, int blen)
 int XrdOfsHandle::Retire(XrdOfsHanCB *cbP, int hTime)
 {
    static int allOK = StartXpr(1);
+   XrdOfsHanShard &myShard = Shard(Path.Hash);
    XrdOfsHanXpr *xP;
    int retc;
 
 // The handle can only be held by one reference and only if it's a POSC and
 // deferred handling was properly set up.
 //
-   myMutex.Lock();
+   myShard.hLock.WriteLock();
    if (!Posc || !allOK)
       {OfsEroute.Emsg("Retire", "ignoring deferred retire of", Path.Val);
-       if (Path.Links != 1 || !Posc || !cbP) myMutex.UnLock();
-          else {myMutex.UnLock(); cbP->Retired(this);}
+       if (Path.Links != 1 || !Posc || !cbP) myShard.hLock.UnLock();
+          else {myShard.hLock.UnLock(); cbP->Retired(this);}
        return Retire(retc);
       }
-   myMutex.UnLock();
+   myShard.hLock.UnLock();
 
 // If this object already has an xpr object (happens for bouncing connections)
 // then reuse that object. Otherwise create a new one and put it on the queue.
@@ -554,16 +600,18 @@ do{xP = XrdOfsHanXpr::Get(); hP = xP->Handle;
             hP->UnLock(); delete xP; continue;
            }
 
-// As the handle is locked we can get the global handle lock to prevent
-// additions and removals of handles as we need a stable reference count to
-// effect the callout, if any. Do so only if the reference count is one (for us)
-// and the handle is active. In all cases, drop the global lock.
+// As the handle is locked we can get its shard lock to prevent additions and
+// removals of handles as we need a stable reference count to effect the
+// callout, if any. Do so only if the reference count is one (for us) and the
+// handle is active. In all cases, drop the shard lock.
 //
-   myMutex.Lock();
-   if (hP->Path.Links != 1 || !xP->Call) myMutex.UnLock();
-      else {myMutex.UnLock();
+  {XrdOfsHanShard &myShard = Shard(hP->Path.Hash);
+   myShard.hLock.WriteLock();
+   if (hP->Path.Links != 1 || !xP->Call) myShard.hLock.UnLock();
+      else {myShard.hLock.UnLock();
             xP->Call->Retired(hP);
            }
+  }
 
 // We can now officially retire the handle and delete the xpr object
 //
@@ -576,6 +624,20 @@ do{xP = XrdOfsHanXpr::Get(); hP = xP->Handle;
    return 0;
 }
 
+/******************************************************************************/
+/* private                          S h a r d                                 */
+/******************************************************************************/
+
+// The shards are created on first use as handles may be allocated while
+// static objects are still being constructed.
+
+XrdOfsHanShard &XrdOfsHandle::Shard(unsigned int hash)
+{
+   static XrdOfsHanShard *hanShard = new XrdOfsHanShard[hanShards];
+
+   return hanShard[hash % hanShards];
+}
+
 /******************************************************************************/
 /* public:                      S u p p r e s s                               */
 /******************************************************************************/
@@ -119,8 +119,10 @@ int              Threshold;
 /******************************************************************************/
   
 class XrdOssDF;
+class XrdOfsCksWrite;
 class XrdOfsHanCB;
 class XrdOfsHanPsc;
+class XrdOfsHanShard;
 
 class XrdOfsHandle
 {
@@ -132,6 +134,7 @@ char                isPending;    // 1-> File  is pending sync()
 char                isChanged;    // 1-> File was modified
 char                isCompressed; // 1-> File  is compressed
 char                isRW;         // T-> File  is open in r/w mode
+XrdOfsCksWrite     *cksW;         // -> Checksums computed on write
 
 void                Activate(XrdOssDF *ssP) {ssi = ssP;}
 
@@ -174,7 +177,9 @@ inline       void   UnLock() {hMutex.UnLock();}
          ~XrdOfsHandle() {int retc; Retire(retc);}
 
 private:
-static int           Alloc(XrdOfsHanKey, int Opts, XrdOfsHandle **Handle);
+static int           Alloc(XrdOfsHanShard &, XrdOfsHanKey, int Opts,
+                           XrdOfsHandle **Handle);
+static XrdOfsHanShard &Shard(unsigned int hash);
        int           WaitLock(void);
 
 static const int     LockTries =   3; // Times to try for a lock
@@ -182,11 +187,8 @@ static const int     LockWait  = 333; // Mills to wait between tries
 static const int     nolokDelay=   3; // Secs to delay client when lock failed
 static const int     nomemDelay=  15; // Secs to delay client when ENOMEM
 
-static XrdSysMutex   myMutex;
-static XrdOfsHanTab  roTable;    // File handles open r/o
-static XrdOfsHanTab  rwTable;    // File Handles open r/w
+static const int     hanShards = 64; // Handle tables are sharded by path hash
 static XrdOssDF     *ossDF;      // Dummy storage sysem
-static XrdOfsHandle *Free;       // List of free handles
 
        XrdSysMutex   hMutex;
        XrdOssDF     *ssi;        // Storage System Interface
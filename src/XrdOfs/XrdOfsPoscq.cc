@@ -40,17 +40,34 @@
 #include <sys/stat.h>
 
 #include "XrdOfs/XrdOfsPoscq.hh"
+#include "XrdOfs/XrdOfsStats.hh"
 #include "XrdOss/XrdOss.hh"
 #include "XrdSfs/XrdSfsFlags.hh"
 #include "XrdSys/XrdSysError.hh"
 #include "XrdSys/XrdSysFD.hh"
 #include "XrdSys/XrdSysPlatform.hh"
+#include "XrdSys/XrdSysTimer.hh"
+
+/******************************************************************************/
+/*                     E x t e r n a l   L i n k a g e s                      */
+/******************************************************************************/
+
+extern XrdOfsStats OfsStats;
+
+void *XrdOfsPoscqSyncer(void *pp)
+{
+   XrdOfsPoscq *pqP = (XrdOfsPoscq *)pp;
+
+   pqP->Syncer();
+   return (void *)0;
+}
 
 /******************************************************************************/
 /*                           C o n s t r u c t o r                            */
 /******************************************************************************/
 
-XrdOfsPoscq::XrdOfsPoscq(XrdSysError *erp, XrdOss *oss, const char *fn, int sv)
+XrdOfsPoscq::XrdOfsPoscq(XrdSysError *erp, XrdOss *oss, const char *fn, int sv,
+                         bool gc) : gcCV(0), gcSem(0)
 {
    eDest = erp;
    ossFS = oss;
@@ -59,6 +76,9 @@ XrdOfsPoscq::XrdOfsPoscq(XrdSysError *erp, XrdOss *oss, const char *fn, int sv)
    pocSZ = 0;
    pocIQ = 0;
    SlotList = SlotLust = 0;
+   gcFirst  = gcLast   = 0;
+   pocGC    = gc;
+   gcRun    = false;
 
    if (sv > 32767) sv = 32767;
       else if (sv < 0) sv = 0;
@@ -73,6 +93,7 @@ int XrdOfsPoscq::Add(const char *Tident, const char *Lfn, bool isNew)
 {
    XrdSysMutexHelper myHelp(myMutex);
    std::map<std::string,int>::iterator it = pqMap.end();
+   int oldP = -1;
    XrdOfsPoscq::Request tmpReq;
    struct stat Stat;
    FileSlot *freeSlot;
@@ -107,19 +128,30 @@ int XrdOfsPoscq::Add(const char *Tident, const char *Lfn, bool isNew)
       } else {fP = pocSZ; pocSZ += ReqSize;}
    pocIQ++;
 
-// Write out the record
+// Update the map or simply add it to the map. This is done before the record
+// is written as with group commits we drop the lock while writing.
+//
+   if (it != pqMap.end()) {oldP = it->second; it->second = fP;}
+      else pqMap[std::string(Lfn)] = fP;
+
+// Write out the record. With group commits the lock is dropped so that
+// concurrent adds can share a sync. Otherwise, it serializes the sync count.
 //
+   if (gcRun) myHelp.UnLock();
    if (!reqWrite((void *)&tmpReq, sizeof(tmpReq), fP))
       {eDest->Emsg("Add", Lfn, "not added to the persist queue.");
-       myMutex.Lock(); pocIQ--; myMutex.UnLock();
+       if (gcRun) myHelp.Lock(&myMutex);
+       pocIQ--;
+       if ((freeSlot = SlotLust)) SlotLust = freeSlot->Next;
+          else freeSlot = new FileSlot;
+       freeSlot->Offset = fP;
+       freeSlot->Next   = SlotList;
+       SlotList         = freeSlot;
+       if (oldP >= 0) pqMap[std::string(Lfn)] = oldP;
+          else pqMap.erase(std::string(Lfn));
        return -EIO;
       }
 
-// Check if we update the map or simply add it to the map
-//
-   if (it != pqMap.end()) it->second = fP;
-      else pqMap[std::string(Lfn)] = fP;
-
 // Return the record offset
 //
    return fP;
@@ -233,7 +265,7 @@ XrdOfsPoscq::recEnt *XrdOfsPoscq::Init(int &Ok)
    if (buf.st_size < ReqSize)
       {pocSZ = ReqOffs;
        if (ftruncate(pocFD, ReqOffs)) FailIni("trunc");
-          else Ok = 1;
+          else Ok = StartSyncer();
        return 0;
       }
 
@@ -249,11 +281,11 @@ XrdOfsPoscq::recEnt *XrdOfsPoscq::Init(int &Ok)
         First = new recEnt(tmpReq, Stat.st_mode & S_IAMB, First); numreq++;
        }
 
-// Now write out the file and return
+// Now write out the file, start group commits if so wanted, and return
 //
    sprintf(Buff, " %d pending create%s", numreq, (numreq != 1 ? "s" : ""));
    eDest->Say("Init", Buff, " recovered from ", pocFN);
-   if (ReWrite(First)) Ok = 1;
+   if (ReWrite(First) && StartSyncer()) Ok = 1;
    return First;
 }
   
@@ -310,14 +342,40 @@ void XrdOfsPoscq::FailIni(const char *txt)
    eDest->Emsg("Init", errno, txt, pocFN);
 }
 
+/******************************************************************************/
+/*                              g r p W r i t e                               */
+/******************************************************************************/
+
+// Queue the write for the syncer thread and wait until it has been written
+// and synced together with whatever else was queued at the time.
+
+bool XrdOfsPoscq::grpWrite(void *Buff, int Bsz, int Offs)
+{
+   WriteReq myReq = {0, Buff, Bsz, Offs, false, false};
+
+   gcCV.Lock();
+   if (gcLast) gcLast->Next = &myReq;
+      else     gcFirst       = &myReq;
+   gcLast = &myReq;
+   gcSem.Post();
+   do {gcCV.Wait();} while(!myReq.Done);
+   gcCV.UnLock();
+   return myReq.aOK;
+}
+
 /******************************************************************************/
 /*                              r e q W r i t e                               */
 /******************************************************************************/
   
+// Unless group commits are being done, the caller must hold myMutex when
+// writing a full record as the periodic sync count is updated here.
+//
 bool XrdOfsPoscq::reqWrite(void *Buff, int Bsz, int Offs)
 {
    int rc = 0;
 
+   if (gcRun) return grpWrite(Buff, Bsz, Offs);
+
    do {rc = pwrite(pocFD, Buff, Bsz, Offs);} while(rc < 0 && errno == EINTR);
 
    if (rc >= 0 && Bsz > 8)
@@ -376,6 +434,86 @@ bool XrdOfsPoscq::ReWrite(XrdOfsPoscq::recEnt *rP)
    return aOK;
 }
 
+/******************************************************************************/
+/*                           S t a r t S y n c e r                            */
+/******************************************************************************/
+
+bool XrdOfsPoscq::StartSyncer()
+{
+   pthread_t tid;
+   int rc;
+
+// Nothing to do unless group commits were requested
+//
+   if (!pocGC) return true;
+
+// Start the thread that writes and syncs queued records
+//
+   if ((rc = XrdSysThread::Run(&tid, XrdOfsPoscqSyncer, (void *)this,
+                               0, "Posc syncer")))
+      {eDest->Emsg("Init", rc, "create posc syncer thread");
+       return false;
+      }
+   gcRun = true;
+   return true;
+}
+
+/******************************************************************************/
+/*                                S y n c e r                                 */
+/******************************************************************************/
+
+void XrdOfsPoscq::Syncer()
+{
+   WriteReq *wP, *batch;
+   struct timeval cTime;
+   int rc, n;
+   bool aOK;
+
+// Each time we are woken up take everything that was queued, write it, and
+// sync the file once. Requests queued while we do so form the next batch.
+//
+do{gcSem.Wait();
+   gcCV.Lock();
+   batch = gcFirst; gcFirst = gcLast = 0;
+   gcCV.UnLock();
+   if (!batch) continue;
+
+   XrdSysTimer cTimer;
+   cTime.tv_sec = cTime.tv_usec = 0;
+   aOK = true; n = 0;
+   for (wP = batch; wP; wP = wP->Next, n++)
+       {do {rc = pwrite(pocFD, wP->Buff, wP->Bsz, wP->Offs);}
+           while(rc < 0 && errno == EINTR);
+        if (rc >= 0) wP->aOK = true;
+           else {eDest->Emsg("Syncer", errno, "write", pocFN);
+                 wP->aOK = false;
+                }
+       }
+   if (fdatasync(pocFD))
+      {eDest->Emsg("Syncer", errno, "sync", pocFN); aOK = false;}
+   cTimer.Report(cTime);
+
+// Update the statistics
+//
+   OfsStats.sdMutex.Lock();
+   OfsStats.Data.numPoscCmt++;
+   OfsStats.Data.numPoscReq += n;
+   if (n > OfsStats.Data.maxPoscBat) OfsStats.Data.maxPoscBat = n;
+   OfsStats.Data.poscCmtUS  += cTime.tv_sec*1000000LL + cTime.tv_usec;
+   OfsStats.sdMutex.UnLock();
+
+// Release everyone that was waiting on this batch
+//
+   gcCV.Lock();
+   for (wP = batch; wP; wP = wP->Next)
+       {if (!aOK) wP->aOK = false;
+        wP->Done = true;
+       }
+   gcCV.Broadcast();
+   gcCV.UnLock();
+  } while(1);
+}
+
 /******************************************************************************/
 /*                             V e r O f f s e t                              */
 /******************************************************************************/
@@ -76,14 +76,18 @@ static recEnt *List(XrdSysError *Say, const char *theFN);
 inline int     Num() {return pocIQ;}
 
                XrdOfsPoscq(XrdSysError *erp, XrdOss *oss, const char *fn,
-                           int sv=1);
+                           int sv=1, bool gc=false);
               ~XrdOfsPoscq() {}
 
+void   Syncer();  // Internal use only!
+
 private:
 void   FailIni(const char *lfn);
+bool   grpWrite(void *Buff, int Bsz, int Offs);
 //int    reqRead(void *Buff, int Offs);
 bool   reqWrite(void *Buff, int Bsz, int Offs);
 bool   ReWrite(recEnt *rP);
+bool   StartSyncer();
 bool   VerOffset(const char *Lfn, int Offset);
 
 struct FileSlot
@@ -91,9 +95,22 @@ struct FileSlot
        int       Offset;
       };
 
+struct WriteReq
+      {WriteReq *Next;
+       void     *Buff;
+       int       Bsz;
+       int       Offs;
+       bool      Done;
+       bool      aOK;
+      };
+
 std::map<std::string, int> pqMap;
 
 XrdSysMutex  myMutex;
+XrdSysCondVar gcCV;      // Group commit: protects gcFirst and signals Done
+XrdSysSemaphore gcSem;   // Group commit: wakes the syncer thread
+WriteReq    *gcFirst;
+WriteReq    *gcLast;
 XrdSysError *eDest;
 XrdOss      *ossFS;
 FileSlot    *SlotList;
@@ -106,5 +123,7 @@ unsigned
 short        pocWS;
 unsigned
 short        pocSV;
+bool         pocGC;      // Group commit requested
+bool         gcRun;      // Group commit syncer is running
 };
 #endif
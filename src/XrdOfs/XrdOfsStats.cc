@@ -42,8 +42,9 @@ int XrdOfsStats::Report(char *buff, int blen)
            "<rdr>%d</rdr><bxq>%d</bxq><rep>%d</rep><err>%d</err><dly>%d</dly>"
            "<sok>%d</sok><ser>%d</ser>"
            "<tpc><grnt>%d</grnt><deny>%d</deny><err>%d</err><exp>%d</exp></tpc>"
+           "<psq><cmt>%d</cmt><req>%d</req><max>%d</max><tus>%lld</tus></psq>"
            "</stats>";
-    static const int  statsz = sizeof(stats1) + (12*10) + 64;
+    static const int  statsz = sizeof(stats1) + (19*10) + 20 + 64;
 
     StatsData myData;
 
@@ -69,5 +70,7 @@ int XrdOfsStats::Report(char *buff, int blen)
                     myData.numErrors,   myData.numDelays,
                     myData.numSeventOK, myData.numSeventER,
                     myData.numTPCgrant, myData.numTPCdeny,
-                    myData.numTPCerrs,  myData.numTPCexpr);
+                    myData.numTPCerrs,  myData.numTPCexpr,
+                    myData.numPoscCmt,  myData.numPoscReq,
+                    myData.maxPoscBat,  myData.poscCmtUS);
 }
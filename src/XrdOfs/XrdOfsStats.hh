@@ -55,6 +55,10 @@ int         numTPCgrant;
 int         numTPCdeny;
 int         numTPCerrs;
 int         numTPCexpr;
+int         numPoscCmt; // Posc queue group commits
+int         numPoscReq; // Posc queue records written by group commits
+int         maxPoscBat; // Posc queue largest group commit
+long long   poscCmtUS;  // Posc queue time spent in group commits (usec)
 }           Data;
 
 XrdSysMutex sdMutex;
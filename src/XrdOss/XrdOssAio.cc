@@ -44,6 +44,7 @@
 #endif
 
 #include "XrdOss/XrdOssApi.hh"
+#include "XrdOss/XrdOssReadAhead.hh"
 #include "XrdOss/XrdOssTrace.hh"
 #include "XrdSys/XrdSysError.hh"
 #include "XrdSys/XrdSysPlatform.hh"
@@ -168,9 +169,15 @@ int XrdOssFile::Read(XrdSfsAio *aiop)
                            <<aiop->sfsAio.aio_offset <<" started; aiocb="
                            <<Xrd::hex1 <<aiop);
 
-       // Start the operation
+       // Start the operation. Readahead tracking uses the requested length as
+       // the bytes actually read are only known once the read completes.
        //
-          if (!(rc = aio_read(&aiop->sfsAio))) return 0;
+          if (!(rc = aio_read(&aiop->sfsAio)))
+             {if (raP && aiop->sfsAio.aio_nbytes)
+                 raP->Done(fd, aiop->sfsAio.aio_offset,
+                               aiop->sfsAio.aio_nbytes);
+              return 0;
+             }
           if (errno != EAGAIN && errno != ENOSYS) return -errno;
 
       // Aio failed keep track of the problem (msg every 1024 events). Note
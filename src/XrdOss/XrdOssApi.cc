@@ -33,6 +33,8 @@
   
 #include <unistd.h>
 #include <cerrno>
+#include <cstdint>
+#include <cstring>
 #include <fcntl.h>
 #include <signal.h>
 #include <strings.h>
@@ -47,12 +49,15 @@
 
 #include "XrdVersion.hh"
 
+#include "Xrd/XrdBuffer.hh"
 #include "XrdFrc/XrdFrcXAttr.hh"
 #include "XrdOss/XrdOssApi.hh"
 #include "XrdOss/XrdOssCache.hh"
 #include "XrdOss/XrdOssConfig.hh"
+#include "XrdOss/XrdOssCopy.hh"
 #include "XrdOss/XrdOssError.hh"
 #include "XrdOss/XrdOssMio.hh"
+#include "XrdOss/XrdOssReadAhead.hh"
 #include "XrdOss/XrdOssTrace.hh"
 #include "XrdOuc/XrdOucEnv.hh"
 #include "XrdOuc/XrdOucName2Name.hh"
@@ -60,6 +65,7 @@
 #include "XrdOuc/XrdOucXAttr.hh"
 #include "XrdSfs/XrdSfsFlags.hh"
 #include "XrdSys/XrdSysAtomics.hh"
+#include "XrdSys/XrdSysE2T.hh"
 #include "XrdSys/XrdSysError.hh"
 #include "XrdSys/XrdSysFD.hh"
 #include "XrdSys/XrdSysHeaders.hh"
@@ -80,6 +86,18 @@ XrdSysError OssEroute(0, "oss_");
 
 XrdSysTrace OssTrace("oss");
 
+namespace XrdGlobal
+{
+extern XrdBuffManager BuffPool;
+}
+
+namespace
+{
+// Largest pool buffer used to stage direct I/O for an unaligned user buffer
+//
+static const size_t dioStage = 1048576;
+}
+
 /******************************************************************************/
 /*           S t o r a g e   S y s t e m   I n s t a n t i a t o r            */
 /******************************************************************************/
@@ -403,7 +421,8 @@ int XrdOssSys::Stats(char *buff, int blen)
 
 // If only size wanted, return what size we need
 //
-   if (!buff) return statflen + getStats(0,0);
+   if (!buff) return statflen + getStats(0,0) + XrdOssReadAhead::Stats(0,0)
+                              + XrdOssCopy::Stats(0,0);
 
 // Make sure we have enough space
 //
@@ -416,6 +435,16 @@ int XrdOssSys::Stats(char *buff, int blen)
    n = getStats(bp, blen);
    bp += n; blen -= n;
 
+// Generate readahead statistics
+//
+   n = XrdOssReadAhead::Stats(bp, blen);
+   bp += n; blen -= n;
+
+// Generate file copy statistics
+//
+   n = XrdOssCopy::Stats(bp, blen);
+   bp += n; blen -= n;
+
 // Add trailer
 //
    if (blen >= (int)sizeof(statfmt2))
@@ -794,6 +823,17 @@ int XrdOssFile::Open(const char *path, int Oflag, mode_t Mode, XrdOucEnv &Env)
        if (mopts) mmFile = XrdOssMio::Map(local_path, fd, mopts);
       } else mmFile = 0;
 
+// Large requests in a direct I/O path go through a second descriptor opened
+// with O_DIRECT. Anything else (including a failure here) uses the page cache.
+//
+   if (fd >= 0 && (popts & XRDEXP_DIRECTIO) && !mmFile && !cxobj)
+      dfd = Open_dio(local_path, Oflag);
+
+// Track the access pattern if adaptive readahead is enabled
+//
+   if (fd >= 0 && XrdOssReadAhead::isOn() && !mmFile && !cxobj)
+      raP = new XrdOssReadAhead;
+
 // Return the result of this open
 //
    return (fd < 0 ? fd : XrdOssOK);
@@ -821,6 +861,8 @@ int XrdOssFile::Close(long long *retsz)
            XrdOssCache::Adjust(cacheP, buf.st_size - FSize);
         if (retsz) *retsz = buf.st_size;
        }
+    if (dfd >= 0) {close(dfd); dfd = -1; dioBad = false;}
+    if (raP) {delete raP; raP = 0;}
     if (close(fd)) return -errno;
     if (mmFile) {XrdOssMio::Recycle(mmFile); mmFile = 0;}
 #ifdef XRDOSSCX
@@ -878,6 +920,11 @@ ssize_t XrdOssFile::Read(void *buff, off_t offset, size_t blen)
 
      if (fd < 0) return (ssize_t)-XRDOSS_E8004;
 
+     if (dfd >= 0 && !dioBad && blen >= (size_t)XrdOssSS->dioMin)
+        {retval = ReadDIO((char *)buff, offset, blen);
+         if (retval != -EINVAL) return retval;
+        }
+
 #ifdef XRDOSSCX
      if (cxobj)  
         if (XrdOssSS->DirFlags & XrdOssNOSSDEC) return (ssize_t)-XRDOSS_E8021;
@@ -887,7 +934,9 @@ ssize_t XrdOssFile::Read(void *buff, off_t offset, size_t blen)
              do { retval = pread(fd, buff, blen, offset); }
                 while(retval < 0 && errno == EINTR);
 
-     return (retval >= 0 ? retval : (ssize_t)-errno);
+     if (retval < 0) return (ssize_t)-errno;
+     if (raP && retval) raP->Done(fd, offset, retval);
+     return retval;
 }
 
 /******************************************************************************/
@@ -1028,6 +1077,11 @@ ssize_t XrdOssFile::Write(const void *buff, off_t offset, size_t blen)
      if (XrdOssSS->MaxSize && (long long)(offset+blen) > XrdOssSS->MaxSize)
         return (ssize_t)-XRDOSS_E8007;
 
+     if (dfd >= 0 && !dioBad && blen >= (size_t)XrdOssSS->dioMin)
+        {retval = WriteDIO((const char *)buff, offset, blen);
+         if (retval != -EINVAL) return retval;
+        }
+
      do { retval = pwrite(fd, buff, blen, offset); }
           while(retval < 0 && errno == EINTR);
 
@@ -1217,6 +1271,222 @@ int XrdOssFile::Ftruncate(unsigned long long flen) {
 /*                     P R I V A T E    S E C T I O N                         */
 /******************************************************************************/
 /******************************************************************************/
+/*                               D I O F a i l                                */
+/******************************************************************************/
+
+// A filesystem rejects direct I/O it cannot align (e.g. "oss.directio align"
+// is smaller than the device block size). The request is then redone through
+// the page cache and this file no longer tries direct I/O.
+//
+void XrdOssFile::DIOFail(const char *what)
+{
+   static bool isWarned = false;
+
+   dioBad = true;
+   if (!isWarned)
+      {isWarned = true;
+       OssEroute.Emsg("DirectIO", EINVAL, what, "directly; using page cache");
+      }
+}
+
+/******************************************************************************/
+/*                              O p e n _ d i o                               */
+/******************************************************************************/
+
+int XrdOssFile::Open_dio(const char *path, int Oflag)
+{
+#ifdef O_DIRECT
+    EPNAME("Open_dio")
+    int myfd, newfd;
+
+// Open the file a second time for direct I/O. The file now exists so only
+// the access mode is carried over. Some filesystems refuse O_DIRECT in which
+// case all I/O simply goes through the page cache.
+//
+    do { myfd = XrdSysFD_Open(path, (Oflag & O_ACCMODE)|O_DIRECT|O_LARGEFILE);}
+       while( myfd < 0 && errno == EINTR);
+
+    if (myfd < 0)
+       {TRACE(Open, "direct I/O not used; " <<XrdSysE2T(errno) <<" path="
+                    <<path);
+        return -1;
+       }
+
+// Relocate the file descriptor as we do for the primary one
+//
+    if (myfd < XrdOssSS->FDFence)
+       {if ((newfd = XrdSysFD_Dup1(myfd, XrdOssSS->FDFence)) < 0)
+           OssEroute.Emsg("Open_dio",errno,"reloc FD",path);
+           else {close(myfd); myfd = newfd;}
+       }
+
+    TRACE(Open, "dfd=" <<myfd <<" path=" <<path);
+    return myfd;
+#else
+    return -1;
+#endif
+}
+
+/******************************************************************************/
+/*                               R e a d D I O                                */
+/******************************************************************************/
+
+/*
+  Function: Read using direct I/O, bypassing the page cache.
+
+  Input:    As for Read().
+
+  Output:   As for Read() except that -EINVAL means the read should be done
+            through the page cache instead.
+
+  Notes:    Only the part of the request that starts and ends on an alignment
+            boundary is read directly. The unaligned head and tail, if any,
+            are read through the page cache. When the user buffer is not
+            suitably aligned the data is staged through pool buffers.
+*/
+
+ssize_t XrdOssFile::ReadDIO(char *buff, off_t offset, size_t blen)
+{
+   const off_t aMask = XrdOssSS->dioAlign - 1;
+   off_t  dBeg = (offset + aMask) & ~aMask, dEnd = (offset + blen) & ~aMask;
+   size_t hLen = dBeg - offset, dLen, xLen;
+   ssize_t retval, totBytes = 0;
+   XrdBuffer *bP = 0;
+   char *dP;
+
+// Verify that there is something worth doing directly
+//
+   if (dEnd <= dBeg) return -EINVAL;
+   dLen = dEnd - dBeg;
+   if ((uintptr_t)(buff + hLen) & aMask
+   &&  !(bP = XrdGlobal::BuffPool.Obtain(dLen < dioStage ? dLen : dioStage)))
+      return -EINVAL;
+
+// Read the unaligned head through the page cache
+//
+   if (hLen)
+      {do {retval = pread(fd, buff, hLen, offset);}
+          while(retval < 0 && errno == EINTR);
+       if (retval < 0 || (size_t)retval < hLen)
+          {if (bP) XrdGlobal::BuffPool.Release(bP);
+           return (retval < 0 ? (ssize_t)-errno : retval);
+          }
+       totBytes = hLen;
+      }
+
+// Read the aligned middle directly. A short read means we reached end of file.
+// Should the filesystem reject the request, fall back to the page cache.
+//
+   while(dLen)
+        {xLen = (bP && dLen > (size_t)bP->bsize ? bP->bsize : dLen);
+         dP   = (bP ? bP->buff : buff + totBytes);
+         do {retval = pread(dfd, dP, xLen, dBeg);}
+            while(retval < 0 && errno == EINTR);
+         if (retval < 0)
+            {retval = -errno;
+             if (bP) XrdGlobal::BuffPool.Release(bP);
+             if (retval == -EINVAL) DIOFail("read");
+             return retval;
+            }
+         if (bP && retval) memcpy(buff + totBytes, dP, retval);
+         totBytes += retval;
+         if ((size_t)retval < xLen)
+            {if (bP) XrdGlobal::BuffPool.Release(bP);
+             return totBytes;
+            }
+         dBeg += xLen; dLen -= xLen;
+        }
+   if (bP) XrdGlobal::BuffPool.Release(bP);
+
+// Read the unaligned tail through the page cache
+//
+   if ((xLen = offset + blen - dEnd))
+      {do {retval = pread(fd, buff + totBytes, xLen, dEnd);}
+          while(retval < 0 && errno == EINTR);
+       if (retval < 0) return -errno;
+       totBytes += retval;
+      }
+   return totBytes;
+}
+
+/******************************************************************************/
+/*                              W r i t e D I O                               */
+/******************************************************************************/
+
+/*
+  Function: Write using direct I/O, bypassing the page cache.
+
+  Input:    As for Write().
+
+  Output:   As for Write() except that -EINVAL means the write should be done
+            through the page cache instead.
+
+  Notes:    The same splitting as for ReadDIO() applies.
+*/
+
+ssize_t XrdOssFile::WriteDIO(const char *buff, off_t offset, size_t blen)
+{
+   const off_t aMask = XrdOssSS->dioAlign - 1;
+   off_t  dBeg = (offset + aMask) & ~aMask, dEnd = (offset + blen) & ~aMask;
+   size_t hLen = dBeg - offset, dLen, xLen;
+   ssize_t retval, totBytes = 0;
+   XrdBuffer *bP = 0;
+   const char *dP;
+
+// Verify that there is something worth doing directly
+//
+   if (dEnd <= dBeg) return -EINVAL;
+   dLen = dEnd - dBeg;
+   if ((uintptr_t)(buff + hLen) & aMask
+   &&  !(bP = XrdGlobal::BuffPool.Obtain(dLen < dioStage ? dLen : dioStage)))
+      return -EINVAL;
+
+// Write the unaligned head through the page cache
+//
+   if (hLen)
+      {do {retval = pwrite(fd, buff, hLen, offset);}
+          while(retval < 0 && errno == EINTR);
+       if (retval < 0 || (size_t)retval < hLen)
+          {if (bP) XrdGlobal::BuffPool.Release(bP);
+           return (retval < 0 ? (ssize_t)-errno : retval);
+          }
+       totBytes = hLen;
+      }
+
+// Write the aligned middle directly
+//
+   while(dLen)
+        {xLen = (bP && dLen > (size_t)bP->bsize ? bP->bsize : dLen);
+         if (bP) {memcpy(bP->buff, buff + totBytes, xLen); dP = bP->buff;}
+            else dP = buff + totBytes;
+         do {retval = pwrite(dfd, dP, xLen, dBeg);}
+            while(retval < 0 && errno == EINTR);
+         if (retval < 0)
+            {retval = -errno;
+             if (bP) XrdGlobal::BuffPool.Release(bP);
+             if (retval == -EINVAL) DIOFail("write");
+             return retval;
+            }
+         totBytes += retval;
+         if ((size_t)retval < xLen)
+            {if (bP) XrdGlobal::BuffPool.Release(bP);
+             return totBytes;
+            }
+         dBeg += xLen; dLen -= xLen;
+        }
+   if (bP) XrdGlobal::BuffPool.Release(bP);
+
+// Write the unaligned tail through the page cache
+//
+   if ((xLen = offset + blen - dEnd))
+      {do {retval = pwrite(fd, buff + totBytes, xLen, dEnd);}
+          while(retval < 0 && errno == EINTR);
+       if (retval < 0) return -errno;
+       totBytes += retval;
+      }
+   return totBytes;
+}
+/******************************************************************************/
 /*                      o o s s _ O p e n _ u f s                             */
 /******************************************************************************/
 
@@ -84,6 +84,7 @@ class oocx_CXFile;
 class XrdSfsAio;
 class XrdOssCache_FS;
 class XrdOssMioFile;
+class XrdOssReadAhead;
   
 class XrdOssFile : public XrdOssDF
 {
@@ -117,20 +118,28 @@ int     Write(XrdSfsAio *aiop);
         XrdOssFile(const char *tid, int fdnum=-1)
                   : XrdOssDF(tid, DF_isFile, fdnum),
                     cxobj(0), cacheP(0), mmFile(0),
-                    rawio(0), cxpgsz(0) {cxid[0] = '\0';}
+                    raP(0), rawio(0), cxpgsz(0), dfd(-1),
+                    dioBad(false) {cxid[0] = '\0';}
 
 virtual ~XrdOssFile() {if (fd >= 0) Close();}
 
 private:
+void    DIOFail(const char *);
+int     Open_dio(const char *, int);
 int     Open_ufs(const char *, int, int, unsigned long long);
+ssize_t ReadDIO(      char *, off_t, size_t);
+ssize_t WriteDIO(const char *, off_t, size_t);
 
 static int      AioFailure;
 oocx_CXFile    *cxobj;
 XrdOssCache_FS *cacheP;
 XrdOssMioFile  *mmFile;
+XrdOssReadAhead *raP;
 long long       FSize;
 int             rawio;
 int             cxpgsz;
+int             dfd;       // O_DIRECT descriptor or -1
+bool            dioBad;    // Direct I/O was rejected by the filesystem
 char            cxid[4];
 };
 
@@ -279,6 +288,9 @@ int               prActive;  //    preread activity count
 short             prDepth;   //    preread depth
 short             prQSize;   //    preread maximum allowed
 
+int               dioMin;    //    Smallest request done as direct I/O
+int               dioAlign;  //    Direct I/O offset and length alignment
+
 XrdVersionInfo   *myVersion; //    Compilation version set by constructor
    
          XrdOssSys();
@@ -350,12 +362,14 @@ int    xalloc(XrdOucStream &Config, XrdSysError &Eroute);
 int    xcache(XrdOucStream &Config, XrdSysError &Eroute);
 int    xcachescan(XrdOucStream &Config, XrdSysError &Eroute);
 int    xdefault(XrdOucStream &Config, XrdSysError &Eroute);
+int    xdio(XrdOucStream &Config, XrdSysError &Eroute);
 int    xfdlimit(XrdOucStream &Config, XrdSysError &Eroute);
 int    xmaxsz(XrdOucStream &Config, XrdSysError &Eroute);
 int    xmemf(XrdOucStream &Config, XrdSysError &Eroute);
 int    xnml(XrdOucStream &Config, XrdSysError &Eroute);
 int    xpath(XrdOucStream &Config, XrdSysError &Eroute);
 int    xprerd(XrdOucStream &Config, XrdSysError &Eroute);
+int    xreadah(XrdOucStream &Config, XrdSysError &Eroute);
 int    xspace(XrdOucStream &Config, XrdSysError &Eroute, int *isCD=0);
 int    xspace(XrdOucStream &Config, XrdSysError &Eroute,
               const char *grp, bool isAsgn);
@@ -50,6 +50,7 @@
 #include "XrdOss/XrdOssConfig.hh"
 #include "XrdOss/XrdOssError.hh"
 #include "XrdOss/XrdOssMio.hh"
+#include "XrdOss/XrdOssReadAhead.hh"
 #include "XrdOss/XrdOssOpaque.hh"
 #include "XrdOss/XrdOssSpace.hh"
 #include "XrdOss/XrdOssTrace.hh"
@@ -213,6 +214,8 @@ XrdOssSys::XrdOssSys()
    prActive      = 0;
    prDepth       = 0;
    prQSize       = 0;
+   dioMin        = 1048576;
+   dioAlign      = 4096;
    STT_Lib       = 0;
    STT_Parms     = 0;
    STT_Func      = 0;
@@ -441,6 +444,7 @@ void XrdOssSys::Config_Display(XrdSysError &Eroute)
      Eroute.Say(buff);
 
      XrdOssMio::Display(Eroute);
+     XrdOssReadAhead::Display(Eroute);
 
      XrdOssCache::List("       oss.", Eroute);
            List_Path("       oss.defaults ", "", DirFlags, Eroute);
@@ -1051,12 +1055,14 @@ int XrdOssSys::ConfigXeq(char *var, XrdOucStream &Config, XrdSysError &Eroute)
    TS_Xeq("cachescan",     xcachescan); // Backward compatibility
    TS_Xeq("spacescan",     xcachescan);
    TS_Xeq("defaults",      xdefault);
+   TS_Xeq("directio",      xdio);
    TS_Xeq("fdlimit",       xfdlimit);
    TS_Xeq("maxsize",       xmaxsz);
    TS_Xeq("memfile",       xmemf);
    TS_Xeq("namelib",       xnml);
    TS_Xeq("path",          xpath);
    TS_Xeq("preread",       xprerd);
+   TS_Xeq("readahead",     xreadah);
    TS_Xeq("space",         xspace);
    TS_Xeq("stagecmd",      xstg);
    TS_Xeq("statlib",       xstl);
@@ -1238,6 +1244,69 @@ int XrdOssSys::xdefault(XrdOucStream &Config, XrdSysError &Eroute)
    return 0;
 }
   
+/******************************************************************************/
+/*                                  x d i o                                   */
+/******************************************************************************/
+
+/* Function: xdio
+
+   Purpose:  To parse the directive: directio [min <bytes>] [align <bytes>]
+
+             <bytes>  for min, the smallest read or write that bypasses the
+                      page cache in paths exported with the directio option.
+                      Smaller requests use the page cache. The default is 1m.
+                      For align, the offset, length, and memory alignment the
+                      filesystem requires for direct I/O. It must be a power
+                      of two between 512 and the page size. The default is 4k.
+
+   Notes:    Direct I/O is enabled per path with the directio export option
+             (e.g. oss.defaults directio). This directive only tunes it.
+
+   Output: 0 upon success or !0 upon failure.
+*/
+
+int XrdOssSys::xdio(XrdOucStream &Config, XrdSysError &Eroute)
+{
+    char *val;
+    long long minV = dioMin, algV = dioAlign;
+
+    if (!(val = Config.GetWord()))
+       {Eroute.Emsg("Config", "directio parameters not specified"); return 1;}
+
+    while(val)
+         {     if (!strcmp(val, "min"))
+                  {if (!(val = Config.GetWord()))
+                      {Eroute.Emsg("Config","directio min not specified");
+                       return 1;
+                      }
+                   if (XrdOuca2x::a2sz(Eroute,"directio min",val,&minV,
+                                       512, 0x40000000LL)) return 1;
+                  }
+          else if (!strcmp(val, "align"))
+                  {if (!(val = Config.GetWord()))
+                      {Eroute.Emsg("Config","directio align not specified");
+                       return 1;
+                      }
+                   if (XrdOuca2x::a2sz(Eroute,"directio align",val,&algV,
+                                       512, prPSize)) return 1;
+                   if (algV & (algV-1))
+                      {Eroute.Emsg("Config","directio align must be a "
+                                            "power of two");
+                       return 1;
+                      }
+                  }
+          else {Eroute.Emsg("Config","invalid directio option -",val);
+                return 1;
+               }
+          val = Config.GetWord();
+         }
+
+    if (minV < algV) minV = algV;
+    dioMin   = static_cast<int>(minV);
+    dioAlign = static_cast<int>(algV);
+    return 0;
+}
+  
 /******************************************************************************/
 /*                              x f d l i m i t                               */
 /******************************************************************************/
@@ -1534,6 +1603,66 @@ int XrdOssSys::xprerd(XrdOucStream &Config, XrdSysError &Eroute)
       return 0;
 }
   
+/******************************************************************************/
+/*                               x r e a d a h                                */
+/******************************************************************************/
+
+/* Function: xreadah
+
+   Purpose:  To parse the directive: readahead {off | [min <min>] [max <max>]}
+
+             off      disables adaptive readahead, the initial default.
+             <min>    the readahead window used when a sequential or strided
+                      stream is first detected. The default is 256k.
+             <max>    the largest the window may grow to as the stream
+                      continues. The default is 8m and the limit is 256m.
+
+   Notes:    The window doubles with each read that continues the stream and
+             returns to <min> when the stream is broken. Only reads done via
+             the oss (synchronous or asynchronous) are tracked. Reads that the
+             protocol serves with sendfile() bypass the oss and are left to
+             the kernel's own readahead.
+
+   Output: 0 upon success or !0 upon failure.
+*/
+
+int XrdOssSys::xreadah(XrdOucStream &Config, XrdSysError &Eroute)
+{
+    static const long long m256 = 256*1024*1024LL;
+    char *val;
+    long long minV = 256*1024, maxV = 8*1024*1024;
+
+    if ((val = Config.GetWord()) && !strcmp(val, "off"))
+       {XrdOssReadAhead::Config(0, 0); return 0;}
+
+    while(val)
+         {     if (!strcmp(val, "min"))
+                  {if (!(val = Config.GetWord()))
+                      {Eroute.Emsg("Config","readahead min not specified");
+                       return 1;
+                      }
+                   if (XrdOuca2x::a2sz(Eroute,"readahead min",val,&minV,
+                                       prPSize, m256)) return 1;
+                  }
+          else if (!strcmp(val, "max"))
+                  {if (!(val = Config.GetWord()))
+                      {Eroute.Emsg("Config","readahead max not specified");
+                       return 1;
+                      }
+                   if (XrdOuca2x::a2sz(Eroute,"readahead max",val,&maxV,
+                                       prPSize, m256)) return 1;
+                  }
+          else {Eroute.Emsg("Config","invalid readahead option -",val);
+                return 1;
+               }
+          val = Config.GetWord();
+         }
+
+    if (minV > maxV) minV = maxV;
+    XrdOssReadAhead::Config(static_cast<int>(minV), static_cast<int>(maxV));
+    return 0;
+}
+  
 /******************************************************************************/
 /*                                x s p a c e                                 */
 /******************************************************************************/
@@ -2094,6 +2223,7 @@ void XrdOssSys::List_Path(const char *pfx, const char *pname,
         else if (flags & XRDEXP_READONLY) rwmode = " r/o";
                 else rwmode = " r/w";
 
+     if (flags & XRDEXP_DIRECTIO) ss += " directio";
      if (flags & XRDEXP_INPLACE) ss += " inplace";
      if (flags & XRDEXP_LOCAL)   ss += " local";
      if (flags & XRDEXP_GLBLRO)  ss += " globalro";
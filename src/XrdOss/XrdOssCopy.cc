@@ -38,6 +38,10 @@
 #include <sys/mman.h>
 #include <sys/types.h>
 #include <sys/stat.h>
+#ifdef __linux__
+#include <sys/ioctl.h>
+#include <linux/fs.h>
+#endif
   
 #include "XrdOss/XrdOssCopy.hh"
 #include "XrdOss/XrdOssTrace.hh"
@@ -52,6 +56,13 @@ extern XrdSysError OssEroute;
 
 extern XrdSysTrace OssTrace;
 
+/******************************************************************************/
+/*                        S t a t i c   O b j e c t s                         */
+/******************************************************************************/
+
+XrdSysMutex          XrdOssCopy::cpMutex;
+XrdOssCopy::cpCounts XrdOssCopy::cpStats[XrdOssCopy::cpNum] = {};
+
 /******************************************************************************/
 /* Public:                          C o p y                                   */
 /******************************************************************************/
@@ -59,6 +70,7 @@ extern XrdSysTrace OssTrace;
 off_t XrdOssCopy::Copy(const char *inFn, const char *outFn, int outFD)
 {
    static const size_t segSize = 1024*1024;
+   static const off_t  pgSize  = sysconf(_SC_PAGESIZE);
    class ioFD
         {public:
          int FD;
@@ -69,9 +81,11 @@ off_t XrdOssCopy::Copy(const char *inFn, const char *outFn, int outFD)
    struct utimbuf tBuff;
    struct stat buf, bufO, bufSL;
    char *inBuff, *bP;
-   off_t  Offset=0, fileSize;
+   off_t  Offset=0, cpyBeg, fileSize;
    size_t ioSize, copySize;
    ssize_t rLen;
+   long long tBeg = Now();
+   cpType how = cpUser;
    int rc;
 
 // Open the input file
@@ -82,7 +96,7 @@ off_t XrdOssCopy::Copy(const char *inFn, const char *outFn, int outFD)
 // Get the input filesize
 //
    if (fstat(In.FD, &buf)) return -OssEroute.Emsg("Copy", errno, "stat", inFn);
-   copySize = fileSize = buf.st_size;
+   fileSize = buf.st_size;
 
 // We can dispense with the copy if both files are in the same filesystem.
 // Note that the caller must have pre-allocate thed output file. We handle
@@ -99,13 +113,25 @@ off_t XrdOssCopy::Copy(const char *inFn, const char *outFn, int outFD)
           }
        unlink(outFn);
        if (link(srcFn,outFn)) return -OssEroute.Emsg("Copy",errno,"link",outFn);
+       Done(cpLink, inFn, outFn, fileSize, tBeg);
        return fileSize;
       }
 
-// We now copy 1MB segments using direct I/O
+// Ask the file system to share the source blocks with the target (reflink).
+// This works across devices that are part of the same file system (e.g. btrfs
+// subvolumes). Otherwise, have the kernel copy the data. Whatever the kernel
+// could not copy is copied below. Both fail without side effects when the
+// files systems do not support them.
+//
+   if (Clone(In.FD, Out.FD)) {how = cpClone; Offset = fileSize;}
+      else if ((Offset = Kernel(In.FD, Out.FD, fileSize))) how = cpKernel;
+   copySize = fileSize - Offset;
+   cpyBeg   = Offset;
+
+// We now copy 1MB segments using direct I/O. The offset must be page aligned.
 //
-   ioSize = (fileSize < (off_t)segSize ? fileSize : segSize);
-   while(copySize)
+   ioSize = (copySize < segSize ? copySize : segSize);
+   while(copySize && !(Offset % pgSize))
         {if ((inBuff = (char *)mmap(0, ioSize, PROT_READ, 
 #if defined(__FreeBSD__)
                        MAP_RESERVED0040|MAP_PRIVATE, In.FD, Offset)) == MAP_FAILED)
@@ -125,11 +151,11 @@ off_t XrdOssCopy::Copy(const char *inFn, const char *outFn, int outFD)
 // check if there was an error and if we can recover
 
    if (copySize)
-   { if ((off_t)copySize != fileSize) return -EIO;
-     // Do a traditional copy (note that we didn't copy anything yet)
+   { if (Offset != cpyBeg) return -EIO;
+     // Do a traditional copy of whatever was not copied above
      OssEroute.Emsg("Copy", "Trying traditional copy for", inFn, "...");
      char ioBuff[segSize];
-     off_t rdSize, wrSize = segSize, inOff=0;
+     off_t rdSize, wrSize = segSize, inOff=Offset;
      while(copySize)
           {if (copySize < segSize) rdSize = wrSize = copySize;
               else rdSize = segSize;
@@ -159,9 +185,121 @@ off_t XrdOssCopy::Copy(const char *inFn, const char *outFn, int outFD)
 
 // Success
 //
+   Done(how, inFn, outFn, fileSize, tBeg);
    return fileSize;
 }
 
+/******************************************************************************/
+/* Public:                         S t a t s                                  */
+/******************************************************************************/
+  
+int XrdOssCopy::Stats(char *buff, int blen)
+{
+   static const char *tName[cpNum] = {"lnk", "cln", "kcp", "ucp"};
+   static const char statfmt[] = "<%s><n>%lld</n><b>%lld</b><us>%lld</us></%s>";
+   static const int  statflen = 12 + (sizeof(statfmt) + 20*3)*cpNum;
+   cpCounts cpNow[cpNum];
+   char *bp = buff;
+
+// If only size wanted, return what size we need
+//
+   if (!buff) return statflen;
+   if (blen < statflen) return 0;
+
+// Format the counters
+//
+   cpMutex.Lock();
+   memcpy(cpNow, cpStats, sizeof(cpNow));
+   cpMutex.UnLock();
+   strcpy(bp, "<cpy>"); bp += 5;
+   for (int i = 0; i < cpNum; i++)
+       bp += sprintf(bp, statfmt, tName[i], cpNow[i].Num, cpNow[i].Bytes,
+                                  cpNow[i].Usec, tName[i]);
+   strcpy(bp, "</cpy>"); bp += 6;
+   return bp - buff;
+}
+
+/******************************************************************************/
+/* private:                        C l o n e                                  */
+/******************************************************************************/
+  
+bool XrdOssCopy::Clone(int inFD, int outFD)
+{
+#ifdef FICLONE
+   return ioctl(outFD, FICLONE, inFD) == 0;
+#else
+   (void)inFD; (void)outFD;
+   return false;
+#endif
+}
+
+/******************************************************************************/
+/* private:                         D o n e                                   */
+/******************************************************************************/
+  
+void XrdOssCopy::Done(cpType how, const char *inFn, const char *outFn,
+                      off_t fSize, long long tBeg)
+{
+   static const char *hName[cpNum] = {"link", "reflink", "kernel copy", "copy"};
+   long long usec = Now() - tBeg;
+   char buff[128];
+
+// Update the statistics
+//
+   cpMutex.Lock();
+   cpStats[how].Num++;
+   cpStats[how].Bytes += fSize;
+   cpStats[how].Usec  += usec;
+   cpMutex.UnLock();
+
+// Relocations are infrequent so we always say how long this one took
+//
+   snprintf(buff, sizeof(buff), " by %s; %lld bytes in %.3f ms",
+            hName[how], (long long)fSize, usec/1000.0);
+   OssEroute.Say("Copy: ", inFn, " copied to ", outFn, buff);
+}
+
+/******************************************************************************/
+/* private:                       K e r n e l                                 */
+/******************************************************************************/
+  
+off_t XrdOssCopy::Kernel(int inFD, int outFD, off_t fSize)
+{
+#ifdef HAVE_COPY_FILE_RANGE
+   static const off_t maxSeg = 1024*1024*1024;
+   loff_t inOff = 0, outOff = 0;
+   ssize_t rLen;
+
+// Have the kernel copy the data in 1GB segments. We stop at the first error,
+// which is usually EXDEV or EOPNOTSUPP; the caller copies whatever is left.
+//
+   while(inOff < fSize)
+        {rLen = copy_file_range(inFD, &inOff, outFD, &outOff,
+                               (fSize-inOff < maxSeg ? fSize-inOff : maxSeg),0);
+         if (rLen <= 0)
+            {if (rLen < 0 && errno == EINTR) continue;
+             break;
+            }
+        }
+   return inOff;
+#else
+   (void)inFD; (void)outFD; (void)fSize;
+   return 0;
+#endif
+}
+
+/******************************************************************************/
+/* private:                          N o w                                    */
+/******************************************************************************/
+  
+long long XrdOssCopy::Now()
+{
+   struct timespec ts;
+
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+   return (long long)ts.tv_sec*1000000LL + ts.tv_nsec/1000;
+}
+
 /******************************************************************************/
 /* private:                        W r i t e                                  */
 /******************************************************************************/
@@ -30,16 +30,35 @@
 /* specific prior written permission of the institution or contributor.       */
 /******************************************************************************/
 
+#include <sys/types.h>
+
+#include "XrdSys/XrdSysPthread.hh"
+
 class XrdOssCopy
 {
 public:
 
 static off_t Copy(const char *inFn, const char *outFn, int outFD);
 
+static int   Stats(char *buff, int blen);
+
              XrdOssCopy() {}
             ~XrdOssCopy() {}
 
 private:
+
+enum cpType {cpLink = 0, cpClone, cpKernel, cpUser, cpNum};
+
+struct cpCounts {long long Num, Bytes, Usec;};
+
+static bool  Clone(int inFD, int outFD);
+static void  Done(cpType how, const char *inFn, const char *outFn,
+                  off_t fSize, long long tBeg);
+static off_t Kernel(int inFD, int outFD, off_t fSize);
+static long long Now();
 static int   Write(const char *, int, char *, size_t, off_t);
+
+static XrdSysMutex cpMutex;
+static cpCounts    cpStats[cpNum];
 };
 #endif
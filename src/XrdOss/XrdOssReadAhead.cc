@@ -0,0 +1,206 @@
+/******************************************************************************/
+/*                                                                            */
+/*                    X r d O s s R e a d A h e a d . c c                     */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <fcntl.h>
+#include <cstdio>
+#include <cstring>
+
+#include "XrdOss/XrdOssReadAhead.hh"
+#include "XrdSys/XrdSysAtomics.hh"
+
+/******************************************************************************/
+/*                        S t a t i c   O b j e c t s                         */
+/******************************************************************************/
+
+int       XrdOssReadAhead::minWin = 0;
+int       XrdOssReadAhead::maxWin = 0;
+
+namespace
+{
+XrdSysMutex totMutex;
+long long   totStr = 0;   // Streams detected
+long long   totIss = 0;   // Bytes advised
+long long   totUse = 0;   // Advised bytes that were subsequently read
+long long   totWst = 0;   // Advised bytes that were never read
+
+// Most records issued in one go for a strided stream
+//
+static const int maxRecs = 64;
+}
+
+/******************************************************************************/
+/*                               D i s p l a y                                */
+/******************************************************************************/
+
+void XrdOssReadAhead::Display(XrdSysError &Eroute)
+{
+   char buff[128];
+
+   if (!maxWin) strcpy(buff, "       oss.readahead off");
+      else snprintf(buff, sizeof(buff), "       oss.readahead min %d max %d",
+                    minWin, maxWin);
+   Eroute.Say(buff);
+}
+
+/******************************************************************************/
+/*                                  D o n e                                   */
+/******************************************************************************/
+
+void XrdOssReadAhead::Done(int fd, off_t offs, size_t blen)
+{
+   off_t endOff = offs + blen;
+   bool  isHit;
+
+// If another thread is reading this file at the same time we skip tracking
+// this read rather than wait. Such a file is unlikely to be one stream anyway.
+//
+   if (!raMutex.CondLock()) return;
+
+// Credit any advised bytes this read consumed
+//
+   if (pendB && offs < raEnd && endOff > raBeg)
+      {long long n = (endOff < raEnd ? endOff : raEnd)
+                   - (offs   > raBeg ? offs   : raBeg);
+       if (n > pendB) n = pendB;
+       pendB -= n; useB += n;
+       raBeg  = endOff;
+      }
+
+// The read continues the stream if it starts where the last one ended or if
+// it skips the same number of bytes as last time and reads the same amount.
+//
+   if (offs == nextOff) isHit = true;
+      else isHit = offs > nextOff && offs - nextOff == stride
+                && blen == recLen && stride <= maxWin;
+
+// Grow the window while the stream holds. Otherwise whatever is still
+// outstanding is wasted and we start over with this read.
+//
+   if (isHit)
+      {if (hits < 2)
+          {if (++hits == 2) {AtomicBeg(totMutex); AtomicInc(totStr);
+                             AtomicEnd(totMutex);
+                            }
+          } else if (window < maxWin)
+                    window = (window > maxWin/2 ? maxWin : window*2);
+       stride = offs - nextOff;
+      } else {
+       if (hits) Flush(true);
+       hits   = 1;
+       window = minWin;
+       raBeg  = raEnd = 0;
+       stride = (offs > nextOff ? offs - nextOff : -1);
+      }
+   nextOff = endOff; recLen = blen;
+
+// Keep at least half a window advised ahead of the stream. A sequential
+// stream is advised as one range, a strided one record by record.
+//
+   if (hits >= 2)
+      {if (!stride)
+          {if (raEnd < endOff) raBeg = raEnd = endOff;
+           if (raEnd - endOff < window/2)
+              {Advise(fd, raEnd, endOff + window - raEnd);
+               raEnd = endOff + window;
+               Flush(false);
+              }
+          } else {
+           off_t step = recLen + stride;
+           if (raEnd < endOff + stride) raBeg = raEnd = endOff + stride;
+           if (raEnd - endOff < window/2)
+              {int n = 0;
+               while(raEnd + (off_t)recLen <= endOff + window && n++ < maxRecs)
+                    {Advise(fd, raEnd, recLen); raEnd += step;}
+               Flush(false);
+              }
+          }
+      }
+   raMutex.UnLock();
+}
+
+/******************************************************************************/
+/*                                 S t a t s                                  */
+/******************************************************************************/
+
+int XrdOssReadAhead::Stats(char *buff, int blen)
+{
+   static const char statfmt[] = "<ra><str>%lld</str><iss>%lld</iss>"
+                                 "<use>%lld</use><wst>%lld</wst></ra>";
+   static const int  statflen = sizeof(statfmt) + 16*4;
+   long long vStr, vIss, vUse, vWst;
+   int n;
+
+// If only size wanted, return what size we need
+//
+   if (!buff) return statflen;
+   if (blen < statflen) return 0;
+
+// Format the counters
+//
+   AtomicBeg(totMutex);
+   vStr = AtomicGet(totStr); vIss = AtomicGet(totIss);
+   vUse = AtomicGet(totUse); vWst = AtomicGet(totWst);
+   AtomicEnd(totMutex);
+   n = snprintf(buff, blen, statfmt, vStr, vIss, vUse, vWst);
+   return (n < blen ? n : 0);
+}
+
+/******************************************************************************/
+/*                       P r i v a t e   M e t h o d s                        */
+/******************************************************************************/
+/******************************************************************************/
+/*                                A d v i s e                                 */
+/******************************************************************************/
+
+void XrdOssReadAhead::Advise(int fd, off_t offs, size_t blen)
+{
+#if defined(__linux__) || (defined(__FreeBSD_kernel__) && defined(__GLIBC__))
+   posix_fadvise(fd, offs, blen, POSIX_FADV_WILLNEED);
+#endif
+   issB += blen; pendB += blen;
+}
+
+/******************************************************************************/
+/*                                 F l u s h                                  */
+/******************************************************************************/
+
+// Add the counters to the totals. When the stream is broken (or the file is
+// closed) the advised bytes that were not read are counted as wasted.
+//
+void XrdOssReadAhead::Flush(bool brk)
+{
+   if (brk) {wstB += pendB; pendB = 0;}
+
+   if (issB || useB || wstB)
+      {AtomicBeg(totMutex);
+       AtomicAdd(totIss, issB); AtomicAdd(totUse, useB);
+       AtomicAdd(totWst, wstB);
+       AtomicEnd(totMutex);
+       issB = useB = wstB = 0;
+      }
+}
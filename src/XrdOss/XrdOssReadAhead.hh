@@ -0,0 +1,93 @@
+#ifndef __XRDOSSREADAHEAD_HH__
+#define __XRDOSSREADAHEAD_HH__
+/******************************************************************************/
+/*                                                                            */
+/*                    X r d O s s R e a d A h e a d . h h                     */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <sys/types.h>
+
+#include "XrdSys/XrdSysError.hh"
+#include "XrdSys/XrdSysPthread.hh"
+
+/******************************************************************************/
+/*                 C l a s s   X r d O s s R e a d A h e a d                  */
+/******************************************************************************/
+
+// XrdOssReadAhead tracks the reads done on one open file. Once a read continues
+// the previous one, either sequentially or with the same stride and length,
+// the bytes the stream will need next are advised to the kernel. The window
+// doubles with each confirmed read up to the configured maximum and collapses
+// when the stream is broken.
+//
+class XrdOssReadAhead
+{
+public:
+
+// Done() is called after each successful read with the bytes actually read.
+//
+void       Done(int fd, off_t offs, size_t blen);
+
+// Config() sets the initial and largest readahead window (oss.readahead).
+//
+static void Config(int wMin, int wMax) {minWin = wMin; maxWin = wMax;}
+
+static void Display(XrdSysError &Eroute);
+
+static bool isOn() {return maxWin > 0;}
+
+// Stats() reports the readahead counters for the oss statistics.
+//
+static int  Stats(char *buff, int blen);
+
+            XrdOssReadAhead() : nextOff(0), raBeg(0), raEnd(0), pendB(0),
+                                issB(0), useB(0), wstB(0), recLen(0),
+                                stride(-1), window(minWin), hits(0) {}
+
+           ~XrdOssReadAhead() {Flush(true);}
+
+private:
+
+void        Advise(int fd, off_t offs, size_t blen);
+void        Flush(bool brk);
+
+static int  minWin;
+static int  maxWin;
+
+XrdSysMutex raMutex;
+off_t       nextOff;   // Offset the stream would read next
+off_t       raBeg;     // Advised region that was not yet read
+off_t       raEnd;
+long long   pendB;     // Advised bytes not yet read
+long long   issB;      // Counters not yet added to the totals
+long long   useB;
+long long   wstB;
+size_t      recLen;    // Length of the last read
+off_t       stride;    // Gap between the last two reads or -1
+int         window;
+int         hits;
+};
+#endif
@@ -37,6 +37,7 @@
 #include <sys/stat.h>
 #include <fcntl.h>
 
+#include <cstdlib>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -86,6 +87,17 @@ int XrdOssCsiConfig::Init(XrdSysError &Eroute, const char *config_fn, const char
       {
          disableLooseWrite_ = true;
       }
+      else if (item == "tagcache")
+      {
+         char *eP;
+         const long n = strtol(value.c_str(), &eP, 10);
+         if (value.empty() || *eP || n < 0 || n > 4096)
+         {
+            Eroute.Emsg("Config","tagcache must be a number of pages between 0 and 4096");
+            NoGo = 1;
+         }
+         else tagCachePages_ = n;
+      }
    }
 
    if (NoGo) return NoGo;
@@ -99,6 +111,7 @@ int XrdOssCsiConfig::Init(XrdSysError &Eroute, const char *config_fn, const char
    Eroute.Say("       allow files without CRCs: ", allowMissingTags_ ? "yes" : "no");
    Eroute.Say("       pgWrite can extend      : ", disablePgExtend_ ? "no" : "yes");
    Eroute.Say("       loose writes            : ", disableLooseWrite_ ? "no" : "yes");
+   Eroute.Say("       tag cache pages         : ", std::to_string((long long int)tagCachePages_).c_str());
    Eroute.Say("       trace level             : ", std::to_string((long long int)OssCsiTrace.What).c_str());
    Eroute.Say("       prefix                  : ", tagParam_.prefix_.empty() ? "[empty]" : tagParam_.prefix_.c_str());
 
@@ -209,7 +209,7 @@ int XrdOssCsiPages::UpdateRange(XrdOssDF *const fd, const void *buff, const off_
       ret = UpdateRangeAligned(buff, offset, blen, sizes);
    }
 
-   return ret;
+   return CommitTags(ret);
 }
 
 // Used by Read: At this point the user's buffer has already been filled from the file.
@@ -614,6 +614,9 @@ int XrdOssCsiPages::truncate(XrdOssDF *const fd, const off_t len, XrdOssCsiRange
       }
    }
 
+   const int cret = CommitTags(0);
+   if (cret<0) return cret;
+
    LockTruncateSize(len,true);
    rg.unlockTrackinglen();
    return 0;
@@ -753,7 +756,7 @@ int XrdOssCsiPages::StoreRange(XrdOssDF *const fd, const void *buff, const off_t
       ret = StoreRangeAligned(buff,offset,blen,sizes,csvec);
    }
 
-   return ret;
+   return CommitTags(ret);
 }
 
 int XrdOssCsiPages::VerificationStatus()
@@ -936,4 +939,22 @@ void XrdOssCsiPages::BasicConsistencyCheck(XrdOssDF *fd)
          TRACE(Warn, CRCMismatchError(tag_len, taglp, tag_crc, tagv) << " dp_ext_is_zero=" << dp_ext_is_zero << " (ignoring)");
       }
    }
+   (void)CommitTags(0);
+}
+
+// CommitTags: have the tagstore write any tags it still holds in memory.
+// Called at the end of an update, before the data itself is written, so the
+// tag file is never behind the datafile. Returns ret if that was an error.
+//
+int XrdOssCsiPages::CommitTags(const int ret)
+{
+   EPNAME("CommitTags");
+   const int cret = ts_->Commit();
+   if (cret<0)
+   {
+      TRACE(Warn, "error " << cret << " while writing crc32c values for file " << fn_);
+   }
+   if (ret<0) return ret;
+   if (cret<0) return cret;
+   return ret;
 }
@@ -103,6 +103,7 @@ protected:
    int LockSetTrackedSize(off_t);
    int LockTruncateSize(off_t,bool);
    int LockMakeUnverified();
+   int CommitTags(int);
 
    int UpdateRangeAligned(const void *, off_t, size_t, const Sizes_t &);
    int UpdateRangeUnaligned(XrdOssDF *, const void *, off_t, size_t, const Sizes_t &);
@@ -34,13 +34,17 @@
 #include "XrdSys/XrdSysPthread.hh"
 
 #include <mutex>
-#include <list>
 #include <condition_variable>
 #include <memory>
+#include <cstdint>
 
 // forward decl
 class XrdOssCsiPages;
 
+//
+// Each range is also a node of the interval tree (a treap ordered by start
+// and sequence number, with the largest end in each subtree kept in maxend)
+//
 struct XrdOssCsiRange_s
 {
    off_t start;
@@ -50,6 +54,12 @@ struct XrdOssCsiRange_s
    std::mutex mtx;
    std::condition_variable cv;
    XrdOssCsiRange_s *next;
+
+   uint64_t seq;
+   uint32_t prio;
+   off_t maxend;
+   XrdOssCsiRange_s *left;
+   XrdOssCsiRange_s *right;
 };
 
 class XrdOssCsiRanges;
@@ -100,7 +110,7 @@ private:
 class XrdOssCsiRanges
 {
 public:
-   XrdOssCsiRanges() : allocList_(NULL) { }
+   XrdOssCsiRanges() : root_(NULL), allocList_(NULL), nextseq_(0), rand_(2463534242U) { }
 
    ~XrdOssCsiRanges()
    {
@@ -118,25 +128,17 @@ public:
    void AddRange(const off_t start, const off_t end, XrdOssCsiRangeGuard &rg, bool rdonly)
    {
       std::unique_lock<std::mutex> lck(rmtx_);
-    
-      int nblocking = 0;
-      for(auto itr = ranges_.begin(); itr != ranges_.end(); ++itr)
-      {
-         if ((*itr)->start <= end && start <= (*itr)->end)
-         {
-            if (!(rdonly && (*itr)->rdonly))
-            {
-               nblocking++;
-            }
-         }
-      }
 
       XrdOssCsiRange_s *nr = AllocRange();
       nr->start = start;
       nr->end = end;
       nr->rdonly = rdonly;
-      nr->nBlockedBy = nblocking;
-      ranges_.push_back(nr);
+      nr->nBlockedBy = CountBlocking(root_, nr);
+      nr->seq = nextseq_++;
+      nr->prio = NextPrio();
+      nr->maxend = end;
+      nr->left = nr->right = NULL;
+      root_ = Insert(root_, nr);
       lck.unlock();
 
       rg.SetRange(this, nr);
@@ -154,40 +156,157 @@ public:
    void RemoveRange(XrdOssCsiRange_s *rp)
    {
       std::lock_guard<std::mutex> guard(rmtx_);
-      for(auto itr=ranges_.begin();itr!=ranges_.end();++itr)
+      root_ = Erase(root_, rp);
+
+      // only ranges added after rp counted it as blocking
+      Unblock(root_, rp);
+
+      RecycleRange(rp);
+      rp = NULL;
+   }
+
+private:
+   std::mutex rmtx_;
+   XrdOssCsiRange_s *root_;
+   XrdOssCsiRange_s *allocList_;
+   uint64_t nextseq_;
+   uint32_t rand_;
+
+   static bool Conflicts(const XrdOssCsiRange_s *a, const XrdOssCsiRange_s *b)
+   {
+      return a->start <= b->end && b->start <= a->end && !(a->rdonly && b->rdonly);
+   }
+
+   static bool Before(const XrdOssCsiRange_s *a, const XrdOssCsiRange_s *b)
+   {
+      if (a->start != b->start) return a->start < b->start;
+      return a->seq < b->seq;
+   }
+
+   static void Fix(XrdOssCsiRange_s *n)
+   {
+      n->maxend = n->end;
+      if (n->left && n->left->maxend > n->maxend) n->maxend = n->left->maxend;
+      if (n->right && n->right->maxend > n->maxend) n->maxend = n->right->maxend;
+   }
+
+   static XrdOssCsiRange_s* RotateRight(XrdOssCsiRange_s *n)
+   {
+      XrdOssCsiRange_s *l = n->left;
+      n->left = l->right;
+      l->right = n;
+      Fix(n);
+      Fix(l);
+      return l;
+   }
+
+   static XrdOssCsiRange_s* RotateLeft(XrdOssCsiRange_s *n)
+   {
+      XrdOssCsiRange_s *r = n->right;
+      n->right = r->left;
+      r->left = n;
+      Fix(n);
+      Fix(r);
+      return r;
+   }
+
+   // must be called with rmtx_ locked
+   uint32_t NextPrio()
+   {
+      rand_ ^= rand_ << 13;
+      rand_ ^= rand_ >> 17;
+      rand_ ^= rand_ << 5;
+      return rand_;
+   }
+
+   // must be called with rmtx_ locked
+   static XrdOssCsiRange_s* Insert(XrdOssCsiRange_s *n, XrdOssCsiRange_s *nr)
+   {
+      if (!n) return nr;
+      if (Before(nr, n))
       {
-         if (*itr == rp)
+         n->left = Insert(n->left, nr);
+         if (n->left->prio > n->prio) return RotateRight(n);
+      }
+      else
+      {
+         n->right = Insert(n->right, nr);
+         if (n->right->prio > n->prio) return RotateLeft(n);
+      }
+      Fix(n);
+      return n;
+   }
+
+   // must be called with rmtx_ locked
+   static XrdOssCsiRange_s* Erase(XrdOssCsiRange_s *n, XrdOssCsiRange_s *rp)
+   {
+      if (!n) return NULL;
+      if (n == rp)
+      {
+         if (!n->left) return n->right;
+         if (!n->right) return n->left;
+         if (n->left->prio > n->right->prio)
+         {
+            n = RotateRight(n);
+            n->right = Erase(n->right, rp);
+         }
+         else
          {
-            ranges_.erase(itr);
-            break;
+            n = RotateLeft(n);
+            n->left = Erase(n->left, rp);
          }
       }
+      else if (Before(rp, n))
+      {
+         n->left = Erase(n->left, rp);
+      }
+      else
+      {
+         n->right = Erase(n->right, rp);
+      }
+      Fix(n);
+      return n;
+   }
+
+   //
+   // CountBlocking: number of ranges in the tree that conflict with nr.
+   // Subtrees that end before nr starts, or start after it ends, are skipped.
+   //
+   static int CountBlocking(const XrdOssCsiRange_s *n, const XrdOssCsiRange_s *nr)
+   {
+      int nblocking = 0;
+      while(n && n->maxend >= nr->start)
+      {
+         nblocking += CountBlocking(n->left, nr);
+         if (n->start > nr->end) break;
+         if (Conflicts(n, nr)) nblocking++;
+         n = n->right;
+      }
+      return nblocking;
+   }
 
-      for(auto itr=ranges_.begin(); itr != ranges_.end(); ++itr)
+   //
+   // Unblock: wake ranges added after rp that were waiting on it
+   //
+   static void Unblock(XrdOssCsiRange_s *n, const XrdOssCsiRange_s *rp)
+   {
+      while(n && n->maxend >= rp->start)
       {
-         if ((*itr)->start <= rp->end && rp->start <= (*itr)->end)
+         Unblock(n->left, rp);
+         if (n->start > rp->end) break;
+         if (n->seq > rp->seq && Conflicts(n, rp))
          {
-            if (!(rp->rdonly && (*itr)->rdonly))
+            std::unique_lock<std::mutex> l(n->mtx);
+            n->nBlockedBy--;
+            if (n->nBlockedBy == 0)
             {
-               std::unique_lock<std::mutex> l((*itr)->mtx);
-               (*itr)->nBlockedBy--;
-               if ((*itr)->nBlockedBy == 0)
-               {
-                  (*itr)->cv.notify_one();
-               }
+               n->cv.notify_one();
             }
          }
-     }
-
-     RecycleRange(rp);
-     rp = NULL;
+         n = n->right;
+      }
    }
 
-private:
-   std::mutex rmtx_;
-   std::list<XrdOssCsiRange_s *> ranges_;
-   XrdOssCsiRange_s *allocList_;
-
    // must be called with rmtx_ locked
    XrdOssCsiRange_s* AllocRange()
    {
@@ -48,6 +48,10 @@ public:
    virtual ssize_t WriteTags(const uint32_t *, off_t, size_t)=0;
    virtual ssize_t ReadTags(uint32_t *, off_t, size_t)=0;
 
+   // write any tag values still held in memory to the store. Called at the
+   // end of each update, before the corresponding data is written.
+   virtual int Commit()=0;
+
    virtual off_t GetTrackedTagSize() const=0;
    virtual off_t GetTrackedDataSize() const=0;
    virtual bool IsVerified() const=0;
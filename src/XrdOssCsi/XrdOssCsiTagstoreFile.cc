@@ -35,6 +35,7 @@
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <unistd.h>
+#include <algorithm>
 
 extern XrdOucTrace  OssCsiTrace;
 
@@ -134,6 +135,12 @@ int XrdOssCsiTagstoreFile::ResetSizes(const off_t size)
 {
    EPNAME("ResetSizes");
    if (!isOpen) return -EBADF;
+   if (cachepages_)
+   {
+      std::lock_guard<std::mutex> guard(cmtx_);
+      const int dret = DropCache();
+      if (dret<0) return dret;
+   }
    actualsize_ = size;
    struct stat sb;
    const int ssret = fd_->Fstat(&sb);
@@ -164,25 +171,48 @@ int XrdOssCsiTagstoreFile::ResetSizes(const off_t size)
 int XrdOssCsiTagstoreFile::Fsync()
 {
    if (!isOpen) return -EBADF;
+   const int cret = Commit();
+   if (cret<0) return cret;
    return fd_->Fsync();
 }
 
 void XrdOssCsiTagstoreFile::Flush()
 {
    if (!isOpen) return;
+   (void)Commit();
    fd_->Flush();
 }
 
 int XrdOssCsiTagstoreFile::Close()
 {
    if (!isOpen) return -EBADF;
+   int dret = 0;
+   if (cachepages_)
+   {
+      std::lock_guard<std::mutex> guard(cmtx_);
+      dret = DropCache();
+      // the file is going away; tags that could not be written are lost
+      // and the error is returned
+      cache_.clear();
+   }
    isOpen = false;
-   return fd_->Close();
+   const int cret = fd_->Close();
+   if (dret<0) return dret;
+   return cret;
+}
+
+int XrdOssCsiTagstoreFile::Commit()
+{
+   if (!isOpen) return -EBADF;
+   if (!cachepages_) return 0;
+   std::lock_guard<std::mutex> guard(cmtx_);
+   return CommitLocked();
 }
 
 ssize_t XrdOssCsiTagstoreFile::WriteTags(const uint32_t *const buf, const off_t off, const size_t n)
 {
    if (!isOpen) return -EBADF;
+   if (cachepages_) return WriteTags_cache(buf, off, n);
    if (machineIsBige_ != fileIsBige_) return WriteTags_swap(buf, off, n);
 
    const ssize_t nwritten = XrdOssCsiTagstoreFile::fullwrite(*fd_, buf, 20LL+4*off, 4*n);
@@ -193,6 +223,7 @@ ssize_t XrdOssCsiTagstoreFile::WriteTags(const uint32_t *const buf, const off_t
 ssize_t XrdOssCsiTagstoreFile::ReadTags(uint32_t *const buf, const off_t off, const size_t n)
 {
    if (!isOpen) return -EBADF;
+   if (cachepages_) return ReadTags_cache(buf, off, n);
    if (machineIsBige_ != fileIsBige_) return ReadTags_swap(buf, off, n);
 
    const ssize_t nread = XrdOssCsiTagstoreFile::fullread(*fd_, buf, 20LL+4*off, 4*n);
@@ -207,6 +238,14 @@ int XrdOssCsiTagstoreFile::Truncate(const off_t size, bool datatoo)
       return -EBADF;
    }
 
+   // cached pages may extend past the new length; write back and forget them
+   if (cachepages_)
+   {
+      std::lock_guard<std::mutex> guard(cmtx_);
+      const int dret = DropCache();
+      if (dret<0) return dret;
+   }
+
    // set tag file to correct length for value of size
    const off_t expected_tagfile_size = 20LL + 4*((size+XrdSys::PageSize-1)/XrdSys::PageSize);
    const int tret = fd_->Ftruncate(expected_tagfile_size);
@@ -265,3 +304,194 @@ ssize_t XrdOssCsiTagstoreFile::ReadTags_swap(uint32_t *const buf, const off_t of
    }
    return n;
 }
+
+// ReadTags_cache: as ReadTags, but served from the tag page cache.
+// A request for tags beyond the end of the tag file fails as fullread would.
+//
+ssize_t XrdOssCsiTagstoreFile::ReadTags_cache(uint32_t *const buf, const off_t off, const size_t n)
+{
+   std::lock_guard<std::mutex> guard(cmtx_);
+   size_t nread = 0;
+   while(nread<n)
+   {
+      const off_t idx = (off+nread) / tagsPerPage_;
+      const size_t i0 = (off+nread) % tagsPerPage_;
+      const size_t cnt = std::min(n-nread, tagsPerPage_-i0);
+      int ret = 0;
+      TagPage *const pg = GetPage(idx, true, ret);
+      if (!pg) return ret;
+      if (i0+cnt > pg->nvalid) return -EDOM;
+      memcpy(&buf[nread], &pg->buf[4*i0], 4*cnt);
+      if (machineIsBige_ != fileIsBige_)
+      {
+         for(size_t i=0;i<cnt;i++) buf[nread+i] = bswap_32(buf[nread+i]);
+      }
+      nread += cnt;
+   }
+   return n;
+}
+
+// WriteTags_cache: as WriteTags, but only updates the tag page cache.
+// The values reach the tag file on Commit() or when the page is reused.
+//
+ssize_t XrdOssCsiTagstoreFile::WriteTags_cache(const uint32_t *const buf, const off_t off, const size_t n)
+{
+   std::lock_guard<std::mutex> guard(cmtx_);
+   size_t nwritten = 0;
+   while(nwritten<n)
+   {
+      const off_t idx = (off+nwritten) / tagsPerPage_;
+      const size_t i0 = (off+nwritten) % tagsPerPage_;
+      const size_t cnt = std::min(n-nwritten, tagsPerPage_-i0);
+      int ret = 0;
+      // a page that is entirely overwritten need not be read first
+      TagPage *const pg = GetPage(idx, (cnt != tagsPerPage_), ret);
+      if (!pg) return ret;
+      uint32_t *const p = reinterpret_cast<uint32_t*>(&pg->buf[4*i0]);
+      memcpy(p, &buf[nwritten], 4*cnt);
+      if (machineIsBige_ != fileIsBige_)
+      {
+         for(size_t i=0;i<cnt;i++) p[i] = bswap_32(p[i]);
+      }
+      if (!pg->dirty)
+      {
+         pg->dlo = i0;
+         pg->dhi = i0+cnt;
+         pg->dirty = true;
+      }
+      else
+      {
+         pg->dlo = std::min(pg->dlo, i0);
+         pg->dhi = std::max(pg->dhi, i0+cnt);
+      }
+      if (i0+cnt > pg->nvalid)
+      {
+         pg->nvalid = i0+cnt;
+         // the tag file will extend past any earlier page (holes read as 0)
+         for(size_t i=0;i<cache_.size();i++)
+         {
+            if (cache_[i].idx >= 0 && cache_[i].idx < idx) cache_[i].nvalid = tagsPerPage_;
+         }
+      }
+      nwritten += cnt;
+   }
+   return n;
+}
+
+// GetPage: find or load the cached page with index idx. If no page is free
+// the least recently used one is reused, clean pages being preferred.
+// Must be called with cmtx_ locked.
+//
+XrdOssCsiTagstoreFile::TagPage *XrdOssCsiTagstoreFile::GetPage(const off_t idx, const bool load, int &ret)
+{
+   TagPage *pg = NULL, *clean = NULL, *dirty = NULL;
+   for(size_t i=0;i<cache_.size();i++)
+   {
+      TagPage &c = cache_[i];
+      if (c.idx == idx)
+      {
+         c.used = ++cacheclock_;
+         return &c;
+      }
+      TagPage *&lru = c.dirty ? dirty : clean;
+      if (!lru || c.used < lru->used) lru = &c;
+   }
+
+   if (cache_.size() < cachepages_)
+   {
+      if (cache_.empty()) cache_.reserve(cachepages_);
+      cache_.emplace_back();
+      pg = &cache_.back();
+   }
+   else if (clean)
+   {
+      pg = clean;
+   }
+   else
+   {
+      pg = dirty;
+      const int wret = WritePage(*pg);
+      if (wret<0)
+      {
+         ret = wret;
+         return NULL;
+      }
+   }
+
+   pg->idx = -1;
+   pg->used = 0;
+   pg->dirty = false;
+   pg->nvalid = 0;
+   size_t nread = 0;
+   if (load)
+   {
+      const off_t foff = 20LL + XrdSys::PageSize*idx;
+      while(nread < XrdSys::PageSize)
+      {
+         const ssize_t rret = fd_->Read(&pg->buf[nread], foff+nread, XrdSys::PageSize-nread);
+         if (rret<0)
+         {
+            ret = rret;
+            return NULL;
+         }
+         if (rret==0) break;
+         nread += rret;
+      }
+      pg->nvalid = nread/4;
+   }
+   memset(&pg->buf[nread], 0, XrdSys::PageSize-nread);
+   pg->idx = idx;
+   pg->used = ++cacheclock_;
+   return pg;
+}
+
+// WritePage: write the modified part of a cached page to the tag file. On
+// failure the page stays dirty, with its modified range, as it may hold tags
+// from other writers; a later commit retries it. Must be called with cmtx_
+// locked.
+//
+int XrdOssCsiTagstoreFile::WritePage(TagPage &pg)
+{
+   if (!pg.dirty) return 0;
+   const off_t foff = 20LL + XrdSys::PageSize*pg.idx + 4*pg.dlo;
+   const ssize_t wret = XrdOssCsiTagstoreFile::fullwrite(*fd_, &pg.buf[4*pg.dlo], foff, 4*(pg.dhi-pg.dlo));
+   if (wret<0) return wret;
+   pg.dirty = false;
+   return 0;
+}
+
+// CommitLocked: write all modified pages, in file order. Returns the first
+// error, if any. Must be called with cmtx_ locked.
+//
+int XrdOssCsiTagstoreFile::CommitLocked()
+{
+   std::vector<TagPage*> dpages;
+   for(size_t i=0;i<cache_.size();i++)
+   {
+      if (cache_[i].dirty) dpages.push_back(&cache_[i]);
+   }
+   if (dpages.empty()) return 0;
+
+   std::sort(dpages.begin(), dpages.end(),
+             [](const TagPage *a, const TagPage *b) { return a->idx < b->idx; });
+
+   int ret = 0;
+   for(size_t i=0;i<dpages.size();i++)
+   {
+      const int wret = WritePage(*dpages[i]);
+      if (wret<0 && ret==0) ret = wret;
+   }
+   return ret;
+}
+
+// DropCache: write back and then empty the cache, e.g. before the length of
+// the tag file is changed. If the write back fails the cache is kept, so the
+// caller must not change the tag file. Must be called with cmtx_ locked.
+//
+int XrdOssCsiTagstoreFile::DropCache()
+{
+   const int ret = CommitLocked();
+   if (ret<0) return ret;
+   cache_.clear();
+   return 0;
+}
@@ -34,15 +34,17 @@
 #include "XrdOss/XrdOss.hh"
 #include "XrdOssCsiTagstore.hh"
 #include "XrdOuc/XrdOucCRC.hh"
+#include "XrdSys/XrdSysPageSize.hh"
 
 #include <memory>
 #include <mutex>
+#include <vector>
 #include <byteswap.h>
 
 class XrdOssCsiTagstoreFile : public XrdOssCsiTagstore
 {
 public:
-   XrdOssCsiTagstoreFile(const std::string &fn, std::unique_ptr<XrdOssDF> fd, const char *tid) : fn_(fn), fd_(std::move(fd)), trackinglen_(0), isOpen(false), tident_(tid), tident(tident_.c_str()) { }
+   XrdOssCsiTagstoreFile(const std::string &fn, std::unique_ptr<XrdOssDF> fd, const char *tid, size_t cpages=0) : fn_(fn), fd_(std::move(fd)), trackinglen_(0), isOpen(false), tident_(tid), tident(tident_.c_str()), cachepages_(cpages), cacheclock_(0) { }
    virtual ~XrdOssCsiTagstoreFile() { if (isOpen) { (void)Close(); } }
 
    virtual int Open(const char *, off_t, int, XrdOucEnv &) /* override */;
@@ -53,6 +55,7 @@ public:
 
    virtual ssize_t WriteTags(const uint32_t *, off_t, size_t) /* override */;
    virtual ssize_t ReadTags(uint32_t *, off_t, size_t) /* override */;
+   virtual int Commit() /* override */;
 
    virtual int Truncate(off_t, bool) /* override */;
 
@@ -149,6 +152,37 @@ private:
    ssize_t WriteTags_swap(const uint32_t *, off_t, size_t);
    ssize_t ReadTags_swap(uint32_t *, off_t, size_t);
 
+   //
+   // Tag page cache: pages of tagsPerPage_ values held in file byte order.
+   // Updates are kept in memory until Commit(), so that the several tag
+   // writes made for one data write reach the tag file as one write per
+   // page. The cache is small and searched linearly; when it is full the
+   // least recently used page is reused, clean pages first.
+   //
+   static const size_t tagsPerPage_ = XrdSys::PageSize/4;
+
+   struct TagPage
+   {
+      off_t idx;          // page index, tags [idx*tagsPerPage_, ...)
+      size_t nvalid;      // number of tags present in the tag file or cache
+      size_t dlo, dhi;    // modified tags [dlo, dhi) when dirty
+      bool dirty;
+      uint64_t used;
+      uint8_t buf[XrdSys::PageSize];
+   };
+
+   std::mutex cmtx_;
+   std::vector<TagPage> cache_;
+   const size_t cachepages_;
+   uint64_t cacheclock_;
+
+   ssize_t ReadTags_cache(uint32_t *, off_t, size_t);
+   ssize_t WriteTags_cache(const uint32_t *, off_t, size_t);
+   TagPage *GetPage(off_t, bool, int &);
+   int WritePage(TagPage &);
+   int CommitLocked();
+   int DropCache();
+
    int WriteTrackedTagSize(const off_t size)
    {
       if (!isOpen) return -EBADF;
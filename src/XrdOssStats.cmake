@@ -0,0 +1,34 @@
+#-------------------------------------------------------------------------------
+# Modules
+#-------------------------------------------------------------------------------
+set( LIB_XRD_OSSSTATS  XrdOssStats-${PLUGIN_VERSION} )
+
+#-------------------------------------------------------------------------------
+# The XrdOssStats module
+#-------------------------------------------------------------------------------
+add_library(
+  ${LIB_XRD_OSSSTATS}
+  MODULE
+  XrdOssStats/XrdOssStats.cc                  XrdOssStats/XrdOssStats.hh
+  XrdOssStats/XrdOssStatsData.cc              XrdOssStats/XrdOssStatsData.hh
+  XrdOssStats/XrdOssStatsFile.cc              XrdOssStats/XrdOssStatsFile.hh
+  )
+
+target_link_libraries(
+  ${LIB_XRD_OSSSTATS}
+  XrdUtils
+  XrdServer
+  ${CMAKE_THREAD_LIBS_INIT} )
+
+set_target_properties(
+  ${LIB_XRD_OSSSTATS}
+  PROPERTIES
+  INTERFACE_LINK_LIBRARIES ""
+  LINK_INTERFACE_LIBRARIES "" )
+
+#-------------------------------------------------------------------------------
+# Install
+#-------------------------------------------------------------------------------
+install(
+  TARGETS ${LIB_XRD_OSSSTATS}
+  LIBRARY DESTINATION ${CMAKE_INSTALL_LIBDIR} )
@@ -0,0 +1,323 @@
+/******************************************************************************/
+/*                                                                            */
+/*                        X r d O s s S t a t s . c c                         */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+
+#include "XrdOssStats/XrdOssStats.hh"
+#include "XrdOssStats/XrdOssStatsFile.hh"
+#include "XrdOuc/XrdOuca2x.hh"
+#include "XrdOuc/XrdOucEnv.hh"
+#include "XrdOuc/XrdOucTokenizer.hh"
+#include "XrdSys/XrdSysError.hh"
+#include "XrdSys/XrdSysPthread.hh"
+#include "XrdSys/XrdSysTimer.hh"
+#include "XrdVersion.hh"
+#include "XrdXrootd/XrdXrootdGStream.hh"
+
+/******************************************************************************/
+/*                        G l o b a l   O b j e c t s                         */
+/******************************************************************************/
+
+XrdVERSIONINFO(XrdOssAddStorageSystem2,XrdOssStats)
+
+namespace
+{
+XrdSysError eDest(0, "ossstats_");
+}
+
+/******************************************************************************/
+/*                      E x t e r n a l   T h r e a d s                       */
+/******************************************************************************/
+
+void *XrdOssStatsReporter(void *carg)
+{
+   ((XrdOssStats *)carg)->Report();
+   return (void *)0;
+}
+
+/******************************************************************************/
+/*                             C o n f i g u r e                              */
+/******************************************************************************/
+
+int XrdOssStats::Configure(XrdSysLogger *logP, const char *parms,
+                           XrdOucEnv *envP)
+{
+   char *val, *pBuff = strdup(parms ? parms : "");
+   XrdOucTokenizer pList(pBuff);
+   pthread_t tid;
+   int retc, NoGo = 0;
+
+// Process the parameters
+//
+   eDest.logger(logP);
+   pList.GetLine();
+   while((val = pList.GetToken()))
+        {     if (!strcmp(val, "nosendfile")) XrdOssStatsFile::noSendFile=true;
+         else if (!strcmp(val, "interval"))
+                 {if (!(val = pList.GetToken()))
+                     {eDest.Emsg("Config", "interval value not specified");
+                      NoGo = 1; break;
+                     }
+                  if (XrdOuca2x::a2tm(eDest,"interval value",val,&repIntv,0))
+                     {NoGo = 1; break;}
+                 }
+         else {eDest.Emsg("Config", "invalid parameter -", val);
+               NoGo = 1; break;
+              }
+        }
+   free(pBuff);
+   if (NoGo) return 1;
+
+// Find out if we should report via the g-stream
+//
+   if (envP) gStream = (XrdXrootdGStream *)envP->GetPtr("oss.gStream*");
+   if (!gStream || !repIntv)
+      {eDest.Say("Config ossstats: oss gstream reporting disabled.");
+       return 0;
+      }
+
+// Start the reporting thread
+//
+   if ((retc = XrdSysThread::Run(&tid, XrdOssStatsReporter, (void *)this,
+                                 0, "OssStats reporter")))
+      {eDest.Emsg("Config", retc, "create oss statistics reporting thread");
+       return 1;
+      }
+   return 0;
+}
+
+/******************************************************************************/
+/*                               F m t J S O N                                */
+/******************************************************************************/
+
+int XrdOssStats::FmtJSON(char *buff, int blen, XrdOssStatsData::Totals &now,
+                         XrdOssStatsData::Totals &then,
+                         time_t tFrom, time_t tTo)
+{
+   static const char *sep[] = {"", ","};
+   char *bp = buff;
+   int n, hEnd, numOps = 0;
+
+// Insert the header
+//
+   n = snprintf(bp, blen, "{\"event\":\"oss_stats\",\"from\":%lld,"
+                          "\"to\":%lld,\"ops\":{",
+                (long long)tFrom, (long long)tTo);
+   bp += n; blen -= n;
+
+// Add each operation that was done in this interval
+//
+   for (int i = 0; i < XrdOssStatsData::opNum && blen > 0; i++)
+       {XrdOssStatsData::OpStats &opN = now.Op[i], &opT = then.Op[i];
+        XrdOssStatsData::OpType op = (XrdOssStatsData::OpType)i;
+        if (opN.Count == opT.Count) continue;
+        n = snprintf(bp, blen, "%s\"%s\":{\"n\":%llu,\"err\":%llu,"
+                               "\"us\":%llu",
+                     sep[numOps != 0], XrdOssStatsData::Name(op),
+                     (unsigned long long)(opN.Count - opT.Count),
+                     (unsigned long long)(opN.Errs  - opT.Errs),
+                     (unsigned long long)((opN.Nsec - opT.Nsec)/1000));
+        bp += n; blen -= n;
+        if (blen > 0 && XrdOssStatsData::isXfr(op))
+           {n = snprintf(bp, blen, ",\"bytes\":%llu",
+                         (unsigned long long)(opN.Bytes - opT.Bytes));
+            bp += n; blen -= n;
+           }
+        for (hEnd = XrdOssStatsData::histNum-1; hEnd > 0; hEnd--)
+            if (opN.Hist[hEnd] != opT.Hist[hEnd]) break;
+        for (int j = 0; j <= hEnd && blen > 0; j++)
+            {n = snprintf(bp, blen, "%s%llu", (j ? "," : ",\"hist\":["),
+                          (unsigned long long)(opN.Hist[j] - opT.Hist[j]));
+             bp += n; blen -= n;
+            }
+        if (blen > 0) {n = snprintf(bp, blen, "]}"); bp += n; blen -= n;}
+        numOps++;
+       }
+
+// Add the trailer. Return zero if nothing happened or the record did not fit.
+//
+   if (!numOps) return 0;
+   if (blen > 0) {n = snprintf(bp, blen, "}}"); bp += n; blen -= n;}
+   return (blen > 0 ? bp - buff : 0);
+}
+
+/******************************************************************************/
+/*                                F m t X M L                                 */
+/******************************************************************************/
+
+int XrdOssStats::FmtXML(char *buff, int blen, XrdOssStatsData::Totals &now)
+{
+   char *bp = buff;
+   int n, hEnd;
+
+// Insert the header
+//
+   n = snprintf(bp, blen, "<stats id=\"osslat\">");
+   bp += n; blen -= n;
+
+// Add each operation
+//
+   for (int i = 0; i < XrdOssStatsData::opNum && blen > 0; i++)
+       {XrdOssStatsData::OpStats &opN = now.Op[i];
+        XrdOssStatsData::OpType op = (XrdOssStatsData::OpType)i;
+        const char *opName = XrdOssStatsData::Name(op);
+        n = snprintf(bp, blen, "<%s><n>%llu</n><err>%llu</err><us>%llu</us>",
+                     opName, (unsigned long long)opN.Count,
+                     (unsigned long long)opN.Errs,
+                     (unsigned long long)(opN.Nsec/1000));
+        bp += n; blen -= n;
+        if (blen > 0 && XrdOssStatsData::isXfr(op))
+           {n = snprintf(bp, blen, "<bytes>%llu</bytes>",
+                         (unsigned long long)opN.Bytes);
+            bp += n; blen -= n;
+           }
+        for (hEnd = XrdOssStatsData::histNum-1; hEnd > 0; hEnd--)
+            if (opN.Hist[hEnd]) break;
+        for (int j = 0; j <= hEnd && blen > 0; j++)
+            {n = snprintf(bp, blen, "%s%llu", (j ? "," : "<hist>"),
+                          (unsigned long long)opN.Hist[j]);
+             bp += n; blen -= n;
+            }
+        if (blen > 0)
+           {n = snprintf(bp, blen, "</hist></%s>", opName);
+            bp += n; blen -= n;
+           }
+       }
+
+// Add the trailer. Return zero if the record did not fit.
+//
+   if (blen > 0) {n = snprintf(bp, blen, "</stats>"); bp += n; blen -= n;}
+   return (blen > 0 ? bp - buff : 0);
+}
+
+/******************************************************************************/
+/*                               n e w F i l e                                */
+/******************************************************************************/
+
+XrdOssDF *XrdOssStats::newFile(const char *tident)
+{
+   XrdOssDF *dfP = wrapPI.newFile(tident);
+
+   return (dfP ? new XrdOssStatsFile(dfP) : 0);
+}
+
+/******************************************************************************/
+/*                                R e p o r t                                 */
+/******************************************************************************/
+
+void XrdOssStats::Report()
+{
+   char buff[maxStatLen];
+   time_t tFrom = time(0), tTo;
+   int n, cur = 0;
+
+// Every interval send the counts for that interval to the g-stream
+//
+   XrdOssStatsData::Collect(repTot[cur]);
+   while(1)
+        {XrdSysTimer::Snooze(repIntv);
+         tTo = time(0);
+         XrdOssStatsData::Collect(repTot[cur^1]);
+         if ((n = FmtJSON(buff, sizeof(buff), repTot[cur^1], repTot[cur],
+                          tFrom, tTo))
+         && !gStream->Insert(buff, n+1))
+            eDest.Emsg("Report", "Unable to insert oss statistics record.");
+         cur ^= 1; tFrom = tTo;
+        }
+}
+
+/******************************************************************************/
+/*                                  S t a t                                   */
+/******************************************************************************/
+
+int XrdOssStats::Stat(const char *path, struct stat *buff, int opts,
+                      XrdOucEnv *envP)
+{
+   uint64_t tBeg = XrdOssStatsData::Now();
+   int retc = wrapPI.Stat(path, buff, opts, envP);
+
+   XrdOssStatsData::Add(XrdOssStatsData::opStat, tBeg, retc);
+   return retc;
+}
+
+/******************************************************************************/
+/*                                 S t a t s                                  */
+/******************************************************************************/
+
+int XrdOssStats::Stats(char *buff, int blen)
+{
+   XrdOssStatsData::Totals tot;
+   int n;
+
+// If only size wanted, return what size we need
+//
+   if (!buff) return wrapPI.Stats(0, 0) + maxStatLen;
+
+// Report the wrapped storage system followed by our statistics
+//
+   n = wrapPI.Stats(buff, blen);
+   buff += n; blen -= n;
+   XrdOssStatsData::Collect(tot);
+   return n + FmtXML(buff, blen, tot);
+}
+
+/******************************************************************************/
+/*                                U n l i n k                                 */
+/******************************************************************************/
+
+int XrdOssStats::Unlink(const char *path, int Opts, XrdOucEnv *envP)
+{
+   uint64_t tBeg = XrdOssStatsData::Now();
+   int retc = wrapPI.Unlink(path, Opts, envP);
+
+   XrdOssStatsData::Add(XrdOssStatsData::opUnlink, tBeg, retc);
+   return retc;
+}
+
+/******************************************************************************/
+/*               X r d O s s A d d S t o r a g e S y s t e m 2                */
+/******************************************************************************/
+
+XrdOss *XrdOssAddStorageSystem2(XrdOss       *curr_oss,
+                                XrdSysLogger *Logger,
+                                const char   *config_fn,
+                                const char   *parms,
+                                XrdOucEnv    *envP)
+{
+   XrdOssStats *myOss = new XrdOssStats(curr_oss);
+
+   (void)config_fn;
+   if (myOss->Configure(Logger, parms, envP))
+      {delete myOss;
+       return 0;
+      }
+   return myOss;
+}
@@ -0,0 +1,94 @@
+#ifndef __XRDOSSSTATS_HH__
+#define __XRDOSSSTATS_HH__
+/******************************************************************************/
+/*                                                                            */
+/*                        X r d O s s S t a t s . h h                         */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+
+#include "XrdOss/XrdOssWrapper.hh"
+#include "XrdOssStats/XrdOssStatsData.hh"
+
+class XrdOucEnv;
+class XrdSysLogger;
+class XrdXrootdGStream;
+
+/******************************************************************************/
+/*                     C l a s s   X r d O s s S t a t s                      */
+/******************************************************************************/
+
+// XrdOssStats is a stackable storage system plugin that records the latency
+// and byte counts of the open, read, readv, pgread, write, pgwrite, stat, sync
+// and unlink operations done by the storage system it wraps. The cumulative
+// counts are added to the summary statistics and, when the "oss" g-stream is
+// enabled, the counts for each reporting interval are sent as JSON records.
+//
+class XrdOssStats : public XrdOssWrapper
+{
+public:
+
+XrdOssDF *newFile(const char *tident) override;
+
+int       Stat(const char *path, struct stat *buff,
+               int opts=0, XrdOucEnv *envP=0) override;
+
+int       Stats(char *buff, int blen) override;
+
+int       Unlink(const char *path, int Opts=0, XrdOucEnv *envP=0) override;
+
+// Configure() processes the plugin parameters:
+//
+//    [interval <sec>] [nosendfile]
+//
+int       Configure(XrdSysLogger *logP, const char *parms, XrdOucEnv *envP);
+
+void      Report();
+
+          XrdOssStats(XrdOss *ossP) : XrdOssWrapper(*ossP), gStream(0),
+                                      repIntv(60) {}
+virtual  ~XrdOssStats() {}
+
+private:
+
+int       FmtJSON(char *buff, int blen, XrdOssStatsData::Totals &now,
+                  XrdOssStatsData::Totals &then, time_t tFrom, time_t tTo);
+int       FmtXML(char *buff, int blen, XrdOssStatsData::Totals &now);
+
+static const int maxStatLen = 8192;
+
+XrdXrootdGStream        *gStream;
+XrdOssStatsData::Totals  repTot[2];
+int                      repIntv;
+};
+
+// The plugin entry point (see XrdOss.hh)
+//
+extern "C" XrdOss *XrdOssAddStorageSystem2(XrdOss       *curr_oss,
+                                           XrdSysLogger *Logger,
+                                           const char   *config_fn,
+                                           const char   *parms,
+                                           XrdOucEnv    *envP);
+#endif
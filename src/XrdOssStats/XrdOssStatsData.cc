@@ -0,0 +1,182 @@
+/******************************************************************************/
+/*                                                                            */
+/*                    X r d O s s S t a t s D a t a . c c                     */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+
+#include <atomic>
+
+#include "XrdOssStats/XrdOssStatsData.hh"
+#include "XrdSys/XrdSysPthread.hh"
+
+/******************************************************************************/
+/*                         L o c a l   C l a s s e s                          */
+/******************************************************************************/
+
+namespace
+{
+// Counters are only ever updated by the thread owning the slab so a relaxed
+// load and store suffices; readers may see a slightly stale value.
+//
+inline void Bump(std::atomic<uint64_t> &ctr, uint64_t val)
+{
+   ctr.store(ctr.load(std::memory_order_relaxed) + val,
+             std::memory_order_relaxed);
+}
+
+struct OpCtrs
+      {std::atomic<uint64_t> Count;
+       std::atomic<uint64_t> Errs;
+       std::atomic<uint64_t> Nsec;
+       std::atomic<uint64_t> Bytes;
+       std::atomic<uint64_t> Hist[XrdOssStatsData::histNum];
+      };
+
+// The padding keeps the counters off any cache line of a neighbouring slab.
+//
+struct Slab
+      {char    Pad[64];
+       OpCtrs  Op[XrdOssStatsData::opNum];
+       Slab   *Next;
+       bool    inUse;
+       char    Pad2[64];
+
+       Slab(Slab *nP) : Next(nP), inUse(true)
+           {for (int i = 0; i < XrdOssStatsData::opNum; i++)
+                {Op[i].Count = 0; Op[i].Errs = 0; Op[i].Nsec = 0;
+                 Op[i].Bytes = 0;
+                 for (int j = 0; j < XrdOssStatsData::histNum; j++)
+                     Op[i].Hist[j] = 0;
+                }
+           }
+      };
+
+// Slabs are never freed. When a thread exits its slab is handed, counters and
+// all, to the next thread that needs one so the totals never go backwards.
+//
+XrdSysMutex slabMutex;
+Slab       *slabFirst = 0;
+
+Slab *Assign()
+{
+   XrdSysMutexHelper mHelp(slabMutex);
+   Slab *sP = slabFirst;
+
+   while(sP && sP->inUse) sP = sP->Next;
+   if (sP) sP->inUse = true;
+      else sP = slabFirst = new Slab(slabFirst);
+   return sP;
+}
+
+struct SlabRef
+      {Slab *sP;
+
+       SlabRef() : sP(0) {}
+      ~SlabRef() {if (sP) {XrdSysMutexHelper mHelp(slabMutex);
+                           sP->inUse = false;
+                          }
+                 }
+      };
+
+thread_local SlabRef mySlab;
+}
+
+/******************************************************************************/
+/*                                   A d d                                    */
+/******************************************************************************/
+
+void XrdOssStatsData::Add(OpType op, uint64_t tBeg, long long rc)
+{
+   uint64_t tEnd = Now(), nsec = (tEnd > tBeg ? tEnd - tBeg : 0);
+   uint64_t usec = nsec / 1000;
+   Slab *sP = mySlab.sP;
+   int hix;
+
+// Get a slab if this thread does not yet have one
+//
+   if (!sP) sP = mySlab.sP = Assign();
+   OpCtrs &opc = sP->Op[op];
+
+// Count the operation
+//
+   Bump(opc.Count, 1);
+   Bump(opc.Nsec, nsec);
+        if (rc < 0)   Bump(opc.Errs, 1);
+   else if (isXfr(op)) Bump(opc.Bytes, rc);
+
+// Record the latency in a power of two bucket
+//
+   hix = (usec < 2 ? 0 : 63 - __builtin_clzll(usec));
+   if (hix >= histNum) hix = histNum-1;
+   Bump(opc.Hist[hix], 1);
+}
+
+/******************************************************************************/
+/*                               C o l l e c t                                */
+/******************************************************************************/
+
+void XrdOssStatsData::Collect(Totals &tot)
+{
+   XrdSysMutexHelper mHelp(slabMutex);
+   Slab *sP = slabFirst;
+
+// Clear the totals
+//
+   for (int i = 0; i < opNum; i++)
+       {OpStats &ops = tot.Op[i];
+        ops.Count = ops.Errs = ops.Nsec = ops.Bytes = 0;
+        for (int j = 0; j < histNum; j++) ops.Hist[j] = 0;
+       }
+
+// Sum up every slab
+//
+   while(sP)
+        {for (int i = 0; i < opNum; i++)
+             {OpStats &ops = tot.Op[i];
+              OpCtrs  &opc = sP->Op[i];
+              ops.Count += opc.Count.load(std::memory_order_relaxed);
+              ops.Errs  += opc.Errs .load(std::memory_order_relaxed);
+              ops.Nsec  += opc.Nsec .load(std::memory_order_relaxed);
+              ops.Bytes += opc.Bytes.load(std::memory_order_relaxed);
+              for (int j = 0; j < histNum; j++)
+                  ops.Hist[j] += opc.Hist[j].load(std::memory_order_relaxed);
+             }
+         sP = sP->Next;
+        }
+}
+
+/******************************************************************************/
+/*                                  N a m e                                   */
+/******************************************************************************/
+
+const char *XrdOssStatsData::Name(OpType op)
+{
+   static const char *opName[opNum] = {"open",  "read", "readv",
+                                       "pgread","write","pgwrite",
+                                       "stat",  "sync", "unlink"};
+
+   return (op >= 0 && op < opNum ? opName[op] : "?");
+}
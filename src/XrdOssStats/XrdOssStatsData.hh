@@ -0,0 +1,86 @@
+#ifndef __XRDOSSSTATSDATA_HH__
+#define __XRDOSSSTATSDATA_HH__
+/******************************************************************************/
+/*                                                                            */
+/*                    X r d O s s S t a t s D a t a . h h                     */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+
+#include <cstdint>
+#include <ctime>
+
+/******************************************************************************/
+/*                 C l a s s   X r d O s s S t a t s D a t a                  */
+/******************************************************************************/
+
+// XrdOssStatsData accumulates the number of calls, errors, elapsed time, bytes
+// moved and a latency histogram for each timed operation. Every thread that
+// records an operation gets its own block of counters so that recording never
+// takes a lock or shares a cache line with another thread. Blocks are reused
+// when their thread exits and Collect() sums all blocks when a report is due.
+//
+class XrdOssStatsData
+{
+public:
+
+enum OpType {opOpen = 0, opRead, opReadV, opPgRead, opWrite, opPgWrite,
+             opStat, opSync, opUnlink, opNum};
+
+// Bucket i of the histogram counts latencies below 2**(i+1) microseconds;
+// the last bucket counts everything longer.
+//
+static const int histNum = 24;
+
+struct OpStats
+      {uint64_t Count;
+       uint64_t Errs;
+       uint64_t Nsec;
+       uint64_t Bytes;
+       uint64_t Hist[histNum];
+      };
+
+struct Totals {OpStats Op[opNum];};
+
+// Add() records an operation that started at tBeg (see Now()) and ended with
+//       the return code rc. For read and write operations a positive return
+//       code is the number of bytes moved.
+//
+static void        Add(OpType op, uint64_t tBeg, long long rc);
+
+// Collect() returns the sum of all counters recorded so far.
+//
+static void        Collect(Totals &tot);
+
+static bool        isXfr(OpType op) {return op >= opRead && op <= opPgWrite;}
+
+static const char *Name(OpType op);
+
+static uint64_t    Now() {struct timespec ts;
+                          clock_gettime(CLOCK_MONOTONIC, &ts);
+                          return (uint64_t)ts.tv_sec*1000000000ULL+ts.tv_nsec;
+                         }
+};
+#endif
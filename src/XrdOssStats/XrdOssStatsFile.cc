@@ -0,0 +1,170 @@
+/******************************************************************************/
+/*                                                                            */
+/*                    X r d O s s S t a t s F i l e . c c                     */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+
+#include "XrdOssStats/XrdOssStatsData.hh"
+#include "XrdOssStats/XrdOssStatsFile.hh"
+
+/******************************************************************************/
+/*                        G l o b a l   S t a t i c s                         */
+/******************************************************************************/
+
+bool XrdOssStatsFile::noSendFile = false;
+
+/******************************************************************************/
+/*                                 F s t a t                                  */
+/******************************************************************************/
+
+int XrdOssStatsFile::Fstat(struct stat *buf)
+{
+   uint64_t tBeg = XrdOssStatsData::Now();
+   int retc = wrapDF.Fstat(buf);
+
+   XrdOssStatsData::Add(XrdOssStatsData::opStat, tBeg, retc);
+   return retc;
+}
+
+/******************************************************************************/
+/*                                 F s y n c                                  */
+/******************************************************************************/
+
+int XrdOssStatsFile::Fsync()
+{
+   uint64_t tBeg = XrdOssStatsData::Now();
+   int retc = wrapDF.Fsync();
+
+   XrdOssStatsData::Add(XrdOssStatsData::opSync, tBeg, retc);
+   return retc;
+}
+
+/******************************************************************************/
+/*                                  O p e n                                   */
+/******************************************************************************/
+
+int XrdOssStatsFile::Open(const char *path, int Oflag, mode_t Mode,
+                          XrdOucEnv &env)
+{
+   uint64_t tBeg = XrdOssStatsData::Now();
+   int retc = wrapDF.Open(path, Oflag, Mode, env);
+
+   XrdOssStatsData::Add(XrdOssStatsData::opOpen, tBeg, retc);
+   return retc;
+}
+
+/******************************************************************************/
+/*                                p g R e a d                                 */
+/******************************************************************************/
+
+ssize_t XrdOssStatsFile::pgRead(void* buffer, off_t offset, size_t rdlen,
+                                uint32_t* csvec, uint64_t opts)
+{
+   uint64_t tBeg = XrdOssStatsData::Now();
+   ssize_t retval = wrapDF.pgRead(buffer, offset, rdlen, csvec, opts);
+
+   XrdOssStatsData::Add(XrdOssStatsData::opPgRead, tBeg, retval);
+   return retval;
+}
+
+/******************************************************************************/
+/*                               p g W r i t e                                */
+/******************************************************************************/
+
+ssize_t XrdOssStatsFile::pgWrite(void* buffer, off_t offset, size_t wrlen,
+                                 uint32_t* csvec, uint64_t opts)
+{
+   uint64_t tBeg = XrdOssStatsData::Now();
+   ssize_t retval = wrapDF.pgWrite(buffer, offset, wrlen, csvec, opts);
+
+   XrdOssStatsData::Add(XrdOssStatsData::opPgWrite, tBeg, retval);
+   return retval;
+}
+
+/******************************************************************************/
+/*                                  R e a d                                   */
+/******************************************************************************/
+
+ssize_t XrdOssStatsFile::Read(void *buffer, off_t offset, size_t size)
+{
+   uint64_t tBeg = XrdOssStatsData::Now();
+   ssize_t retval = wrapDF.Read(buffer, offset, size);
+
+   XrdOssStatsData::Add(XrdOssStatsData::opRead, tBeg, retval);
+   return retval;
+}
+
+/******************************************************************************/
+/*                               R e a d R a w                                */
+/******************************************************************************/
+
+ssize_t XrdOssStatsFile::ReadRaw(void *buffer, off_t offset, size_t size)
+{
+   uint64_t tBeg = XrdOssStatsData::Now();
+   ssize_t retval = wrapDF.ReadRaw(buffer, offset, size);
+
+   XrdOssStatsData::Add(XrdOssStatsData::opRead, tBeg, retval);
+   return retval;
+}
+
+/******************************************************************************/
+/*                                 R e a d V                                  */
+/******************************************************************************/
+
+ssize_t XrdOssStatsFile::ReadV(XrdOucIOVec *readV, int rdvcnt)
+{
+   uint64_t tBeg = XrdOssStatsData::Now();
+   ssize_t retval = wrapDF.ReadV(readV, rdvcnt);
+
+   XrdOssStatsData::Add(XrdOssStatsData::opReadV, tBeg, retval);
+   return retval;
+}
+
+/******************************************************************************/
+/*                                 W r i t e                                  */
+/******************************************************************************/
+
+ssize_t XrdOssStatsFile::Write(const void *buffer, off_t offset, size_t size)
+{
+   uint64_t tBeg = XrdOssStatsData::Now();
+   ssize_t retval = wrapDF.Write(buffer, offset, size);
+
+   XrdOssStatsData::Add(XrdOssStatsData::opWrite, tBeg, retval);
+   return retval;
+}
+
+/******************************************************************************/
+/*                                W r i t e V                                 */
+/******************************************************************************/
+
+ssize_t XrdOssStatsFile::WriteV(XrdOucIOVec *writeV, int wrvcnt)
+{
+   uint64_t tBeg = XrdOssStatsData::Now();
+   ssize_t retval = wrapDF.WriteV(writeV, wrvcnt);
+
+   XrdOssStatsData::Add(XrdOssStatsData::opWrite, tBeg, retval);
+   return retval;
+}
@@ -0,0 +1,88 @@
+#ifndef __XRDOSSSTATSFILE_HH__
+#define __XRDOSSSTATSFILE_HH__
+/******************************************************************************/
+/*                                                                            */
+/*                    X r d O s s S t a t s F i l e . h h                     */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+
+#include "XrdOss/XrdOssWrapper.hh"
+
+/******************************************************************************/
+/*                 C l a s s   X r d O s s S t a t s F i l e                  */
+/******************************************************************************/
+
+// XrdOssStatsFile times the synchronous file operations and passes everything
+// else, including asynchronous I/O, straight to the wrapped file object.
+//
+class XrdOssStatsFile : public XrdOssWrapDF
+{
+public:
+
+using XrdOssWrapDF::pgRead;
+using XrdOssWrapDF::pgWrite;
+using XrdOssWrapDF::Read;
+using XrdOssWrapDF::Write;
+using XrdOssWrapDF::Fsync;
+
+int     Fstat(struct stat *buf) override;
+
+int     Fsync() override;
+
+int     getFD() override {return (noSendFile ? -1 : wrapDF.getFD());}
+
+int     Open(const char *path, int Oflag, mode_t Mode,
+             XrdOucEnv &env) override;
+
+ssize_t pgRead (void* buffer, off_t offset, size_t rdlen,
+                uint32_t* csvec, uint64_t opts) override;
+
+ssize_t pgWrite(void* buffer, off_t offset, size_t wrlen,
+                uint32_t* csvec, uint64_t opts) override;
+
+ssize_t Read(void *buffer, off_t offset, size_t size) override;
+
+ssize_t ReadRaw(void *buffer, off_t offset, size_t size) override;
+
+ssize_t ReadV(XrdOucIOVec *readV, int rdvcnt) override;
+
+ssize_t Write(const void *buffer, off_t offset, size_t size) override;
+
+ssize_t WriteV(XrdOucIOVec *writeV, int wrvcnt) override;
+
+// When noSendFile is set the file descriptor is hidden so that reads which
+// would have been done with sendfile() come through Read() and are timed.
+//
+static bool noSendFile;
+
+        XrdOssStatsFile(XrdOssDF *dfP) : XrdOssWrapDF(*dfP), ossDF(dfP) {}
+virtual ~XrdOssStatsFile() {delete ossDF;}
+
+private:
+
+XrdOssDF *ossDF;
+};
+#endif
@@ -38,9 +38,9 @@
   
 /* Function: ParseDefs
 
-   Purpose:  Parse: defaults [[no]cache] [[no]check] [[no]dread]
+   Purpose:  Parse: defaults [[no]cache] [[no]check] [[no]directio]
 
-                             [[no]filter] [forcero]
+                             [[no]dread] [[no]filter] [forcero]
 
                              [inplace] [local] [global] [globalro]
                               
@@ -93,6 +93,8 @@ unsigned long long XrdOucExport::ParseDefs(XrdOucStream      &Config,
         {"nostage",       XRDEXP_STAGE,   0,              XRDEXP_STAGE_X},
         {"stage",         0,              XRDEXP_STAGE,   XRDEXP_STAGE_X},
         {"stage+",        0,              XRDEXP_STAGEMM, XRDEXP_STAGE_X},
+        {"directio",      0,              XRDEXP_DIRECTIO,XRDEXP_DIRECTIO_X},
+        {"nodirectio",    XRDEXP_DIRECTIO,0,              XRDEXP_DIRECTIO_X},
         {"dread",         XRDEXP_NODREAD, 0,              XRDEXP_DREAD_X},
         {"nodread",       0,              XRDEXP_NODREAD, XRDEXP_DREAD_X},
         {"check",         XRDEXP_NOCHECK, 0,              XRDEXP_CHECK_X},
@@ -144,6 +146,8 @@ unsigned long long XrdOucExport::ParseDefs(XrdOucStream      &Config,
              <options> a blank separated list of options:
                        [no]cache    - is [not] file caching
                        [no]check    - [don't] check if new file exists in MSS
+                       [no]directio - [don't] bypass the page cache for large
+                                      reads and writes
                        [no]dread    - [don't] read actual directory contents
                            forcero  - force r/w opens to r/o opens
                            inplace  - do not use extended cache for creation
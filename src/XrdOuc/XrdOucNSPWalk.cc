@@ -0,0 +1,294 @@
+/******************************************************************************/
+/*                                                                            */
+/*                      X r d O u c N S P W a l k . c c                       */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <cerrno>
+#include <cstring>
+#include <unistd.h>
+
+#include "XrdOuc/XrdOucNSPWalk.hh"
+#include "XrdOuc/XrdOucTList.hh"
+#include "XrdSys/XrdSysPlatform.hh"
+
+/******************************************************************************/
+/*                         L o c a l   C l a s s e s                          */
+/******************************************************************************/
+
+struct XrdOucNSPWalk::Result
+      {Result              *Next;
+       XrdOucNSWalk::NSEnt *Ents;
+       char                *Path;
+       struct stat          dStat;
+       int                  rc;
+       bool                 isEmpty;
+       bool                 lkErr;
+
+       Result() : Next(0), Ents(0), Path(0), rc(0),
+                  isEmpty(false), lkErr(false) {}
+      ~Result() {XrdOucNSWalk::NSEnt *eP;
+                 while((eP = Ents)) {Ents = eP->Next; delete eP;}
+                 if (Path) free(Path);
+                }
+      };
+  
+/******************************************************************************/
+/*                           C o n s t r u c t o r                            */
+/******************************************************************************/
+
+XrdOucNSPWalk::XrdOucNSPWalk(XrdOucNSWalk &nswalk)
+             : Main(nswalk), wrkCV(0, "NSPWalk"), wTab(0), wNum(0),
+               resFirst(0), resLast(0), numRes(0), maxRes(0), numPend(0),
+               Stop(false)
+{}
+
+/******************************************************************************/
+/*                            D e s t r u c t o r                             */
+/******************************************************************************/
+  
+XrdOucNSPWalk::~XrdOucNSPWalk()
+{
+   Result *rP;
+   int i;
+
+// Tell the workers to stop and wait for them to do so
+//
+   wrkCV.Lock();
+   Stop = true;
+   wrkCV.Broadcast();
+   wrkCV.UnLock();
+   for (i = 0; i < wNum; i++) XrdSysThread::Join(wTab[i].tID, 0);
+
+// Release whatever was not consumed
+//
+   for (i = 0; i < wNum; i++)
+       {while(!wTab[i].Dirs.empty())
+             {free(wTab[i].Dirs.back()); wTab[i].Dirs.pop_back();}
+        delete wTab[i].Walk;
+       }
+   if (wTab) delete [] wTab;
+
+   while((rP = resFirst)) {resFirst = rP->Next; delete rP;}
+}
+
+/******************************************************************************/
+/*                                 I n d e x                                  */
+/******************************************************************************/
+  
+XrdOucNSWalk::NSEnt *XrdOucNSPWalk::Index(int &rc, const char **dPath)
+{
+   XrdOucNSWalk::NSEnt *eP = 0;
+   Result *rP;
+   bool isEnd = false;
+
+// Return the next directory that has entries or that failed, reporting any
+// empty directories along the way. This is what XrdOucNSWalk::Index() does.
+//
+   rc = 0; *Main.DPath = '\0';
+   wrkCV.Lock();
+   while(1)
+        {while(!(rP = resFirst) && numPend) wrkCV.Wait();
+         if (!rP) break;
+         if (!(resFirst = rP->Next)) resLast = 0;
+         if (numRes-- >= maxRes) wrkCV.Broadcast();
+         wrkCV.UnLock();
+
+         strlcpy(Main.DPath, rP->Path, sizeof(Main.DPath));
+         eP = rP->Ents; rP->Ents = 0;
+         isEnd = eP || (rP->rc && (rP->lkErr || !Main.errOK));
+         if (isEnd) rc = rP->rc;
+            else if (Main.edCB && rP->isEmpty)
+                    Main.edCB->isEmpty(&rP->dStat, Main.DPath, Main.LKFn);
+         delete rP;
+         if (isEnd) break;
+         wrkCV.Lock();
+        }
+   if (!isEnd) wrkCV.UnLock();
+
+// Return the result
+//
+   if (dPath) *dPath = Main.DPath;
+   return eP;
+}
+
+/******************************************************************************/
+/*                                 S t a r t                                  */
+/******************************************************************************/
+  
+bool XrdOucNSPWalk::Start(int nthr)
+{
+   XrdOucTList *tP;
+   XrdOucNSWalk *wP;
+   int rc;
+
+// Each thread gets a walker with the same options as the main one. The lock
+// keeps the threads from looking for work until we are done here.
+//
+   wTab = new Worker[nthr];
+   wrkCV.Lock();
+   for (wNum = 0; wNum < nthr; wNum++)
+       {wP = new XrdOucNSWalk(Main.eDest, 0, Main.LKFn, Main.Opts, Main.XList);
+        while((tP = wP->DList)) {wP->DList = tP->next; delete tP;}
+        wP->edCB = Main.edCB;
+        wP->mPfx = Main.mPfx;
+        wTab[wNum].Walk = wP;
+        wTab[wNum].Boss = this;
+        wTab[wNum].Num  = wNum;
+        if ((rc = XrdSysThread::Run(&wTab[wNum].tID, Launch, &wTab[wNum],
+                                    XRDSYSTHREAD_HOLD, "NSWalk worker")))
+           {Main.Emsg("Start", rc, "create name space walk thread");
+            delete wP;
+            break;
+           }
+       }
+
+// If we could not start any threads then the walk will be done serially
+//
+   if (!wNum) {wrkCV.UnLock(); return false;}
+
+// Hand the directories still to be indexed to the first thread
+//
+   while((tP = Main.DList))
+        {Main.DList = tP->next;
+         wTab[0].Dirs.push_back(tP->text); tP->text = 0;
+         delete tP;
+         numPend++;
+        }
+
+// Allow a couple of results per thread to be waiting for Index()
+//
+   maxRes = wNum*2;
+   wrkCV.Broadcast();
+   wrkCV.UnLock();
+   return true;
+}
+
+/******************************************************************************/
+/*                       P r i v a t e   M e t h o d s                        */
+/******************************************************************************/
+/******************************************************************************/
+/*                               g e t W o r k                                */
+/******************************************************************************/
+
+// Must be called with wrkCV locked. Returns null when the walk is over.
+  
+char *XrdOucNSPWalk::getWork(XrdOucNSPWalk::Worker &wrk)
+{
+   char *dP;
+   int i;
+
+// Take the newest entry from our own queue. Otherwise, steal the oldest one
+// from someone else's queue. If there is nothing anywhere, wait until more
+// directories are found or until all of them have been read.
+//
+   while(!Stop)
+        {if (!wrk.Dirs.empty())
+            {dP = wrk.Dirs.back(); wrk.Dirs.pop_back(); return dP;}
+         for (i = 1; i < wNum; i++)
+             {Worker &vic = wTab[(wrk.Num+i) % wNum];
+              if (!vic.Dirs.empty())
+                 {dP = vic.Dirs.front(); vic.Dirs.pop_front(); return dP;}
+             }
+         if (!numPend) break;
+         wrkCV.Wait();
+        }
+   return 0;
+}
+
+/******************************************************************************/
+/*                                L a u n c h                                 */
+/******************************************************************************/
+  
+void *XrdOucNSPWalk::Launch(void *wrk)
+{
+   Worker *wP = (Worker *)wrk;
+
+   wP->Boss->Run(*wP);
+   return (void *)0;
+}
+
+/******************************************************************************/
+/*                                  R e a d                                   */
+/******************************************************************************/
+
+// Reads a directory the way XrdOucNSWalk::Index() does. Subdirectories are left
+// in the walker's directory list.
+  
+XrdOucNSPWalk::Result *XrdOucNSPWalk::Read(XrdOucNSWalk *wP, char *dP)
+{
+   Result *rP = new Result;
+
+// Lock the directory if need be and then read it
+//
+   wP->setPath(dP);
+   if (wP->LKFn && (rP->rc = wP->LockFile())) rP->lkErr = true;
+      else rP->rc = wP->Build();
+   if (wP->LKfd >= 0) {close(wP->LKfd); wP->LKfd = -1;}
+
+// Record the outcome
+//
+   *(wP->File) = '\0';
+   rP->Path = strdup(wP->DPath);
+   rP->Ents = wP->DEnts; wP->DEnts = 0;
+   if ((rP->isEmpty = !rP->lkErr && wP->isEmpty)) rP->dStat = wP->dStat;
+   return rP;
+}
+
+/******************************************************************************/
+/*                                   R u n                                    */
+/******************************************************************************/
+  
+void XrdOucNSPWalk::Run(XrdOucNSPWalk::Worker &wrk)
+{
+   XrdOucNSWalk *wP = wrk.Walk;
+   XrdOucTList  *tP;
+   Result       *rP;
+   char         *dP;
+
+// Read directories until there are none left. After reading one, queue its
+// subdirectories and then the result once there is room for it.
+//
+   wrkCV.Lock();
+   while((dP = getWork(wrk)))
+        {wrkCV.UnLock();
+         rP = Read(wP, dP);
+         free(dP);
+         wrkCV.Lock();
+         while((tP = wP->DList))
+              {wP->DList = tP->next;
+               wrk.Dirs.push_back(tP->text); tP->text = 0;
+               delete tP;
+               numPend++;
+              }
+         while(numRes >= maxRes && !Stop) wrkCV.Wait();
+         if (resLast) resLast->Next = rP;
+            else      resFirst      = rP;
+         resLast = rP; numRes++;
+         numPend--;
+         wrkCV.Broadcast();
+        }
+   wrkCV.UnLock();
+}
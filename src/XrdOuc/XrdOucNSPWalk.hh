@@ -0,0 +1,91 @@
+#ifndef __XRDOUCNSPWALK_HH
+#define __XRDOUCNSPWALK_HH
+/******************************************************************************/
+/*                                                                            */
+/*                      X r d O u c N S P W a l k . h h                       */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <deque>
+#include <pthread.h>
+#include <sys/stat.h>
+
+#include "XrdOuc/XrdOucNSWalk.hh"
+#include "XrdSys/XrdSysPthread.hh"
+
+/******************************************************************************/
+/*                   C l a s s   X r d O u c N S P W a l k                    */
+/******************************************************************************/
+
+// XrdOucNSPWalk reads the directories of a recursive XrdOucNSWalk traversal
+// using a set of threads. Each thread has its own XrdOucNSWalk object to read
+// a directory and its own queue of directories to be read. A thread takes the
+// most recently found directory from its own queue so that it goes depth first
+// and the number of pending directories stays small; an idle thread steals the
+// oldest directory from another thread's queue as that likely heads the largest
+// unread subtree. Directories that have been read are queued for Index(), which
+// returns them one at a time. Threads wait when that queue is full so memory
+// use is bounded regardless of the size of the name space.
+//
+class XrdOucNSPWalk
+{
+public:
+
+XrdOucNSWalk::NSEnt *Index(int &rc, const char **dPath);
+
+bool                 Start(int nthr);
+
+                     XrdOucNSPWalk(XrdOucNSWalk &nswalk);
+                    ~XrdOucNSPWalk();
+
+private:
+
+struct Result;
+
+struct Worker
+      {XrdOucNSWalk        *Walk;
+       XrdOucNSPWalk       *Boss;
+       std::deque<char *>   Dirs;
+       pthread_t            tID;
+       int                  Num;
+      };
+
+char                *getWork(Worker &wrk);
+static void         *Launch(void *wrk);
+Result              *Read(XrdOucNSWalk *wP, char *dP);
+void                 Run(Worker &wrk);
+
+XrdOucNSWalk        &Main;
+XrdSysCondVar        wrkCV;    // Protects everything below
+Worker              *wTab;
+int                  wNum;
+Result              *resFirst;
+Result              *resLast;
+int                  numRes;
+int                  maxRes;
+int                  numPend;  // Directories queued or being read
+bool                 Stop;
+};
+#endif
@@ -31,11 +31,13 @@
 /******************************************************************************/
 
 #include <cstdlib>
+#include <dirent.h>
 #include <fcntl.h>
 #include <sys/types.h>
 #include <sys/stat.h>
   
 
+class XrdOucNSPWalk;
 class XrdOucTList;
 class XrdSysError;
 
@@ -101,6 +103,14 @@ void         setCallBack(CallBack *cbP=0) {edCB = cbP;}
 //
 void         setMsgOn(const char *pfx) {mPfx = pfx;}
 
+// A recursive traversal can be sped up by having nthr threads read directories
+// in parallel. Index() still returns one directory per call and the empty
+// directory callback is still made by the thread calling Index(); however,
+// directories are returned in no particular order. This must be called before
+// the first call to Index() and has no effect unless opts & Recurse is true.
+//
+void         setThreads(int nthr);
+
 // The following are processing options passed to the constructor
 //
 static const int retDir =  0x0001; // Return directories (implies retStat)
@@ -130,6 +140,8 @@ static const int skpErrs=  0x8000; // Skip any entry causing an error
 //       as a directory entry if an empty directory call back has been set.
 
 private:
+friend class XrdOucNSPWalk;
+
 void          addEnt(XrdOucNSWalk::NSEnt *eP);
 int           Build();
 int           Emsg(const char *pfx, int rc, const char *tx1, const char *tx2=0);
@@ -139,6 +151,7 @@ int           getStat();
 int           inXList(const char *dName);
 int           isSymlink();
 int           LockFile();
+const char   *nextEnt(DIR *dP, int &dType, int &rc);
 void          setPath(char *newpath);
 
 XrdSysError  *eDest;
@@ -147,7 +160,11 @@ XrdOucTList  *XList;
 struct NSEnt *DEnts;
 struct stat   dStat;
 CallBack     *edCB;
+XrdOucNSPWalk*PWalk;
 const char   *mPfx;
+char         *DBuff;
+int           DBpos;
+int           DBend;
 char          DPath[1032];
 char         *File;
 char         *LKFn;
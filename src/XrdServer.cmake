@@ -69,6 +69,7 @@ add_library(
 #-------------------------------------------------------------------------------
   XrdOfs/XrdOfs.cc              XrdOfs/XrdOfs.hh
   XrdOfs/XrdOfsChkPnt.cc        XrdOfs/XrdOfsChkPnt.hh
+  XrdOfs/XrdOfsCksWrite.cc      XrdOfs/XrdOfsCksWrite.hh
   XrdOfs/XrdOfsConfig.cc
   XrdOfs/XrdOfsConfigCP.cc      XrdOfs/XrdOfsConfigCP.hh
   XrdOfs/XrdOfsConfigPI.cc      XrdOfs/XrdOfsConfigPI.hh
@@ -134,6 +135,7 @@ add_library(
                                XrdOss/XrdOssMioFile.hh
   XrdOss/XrdOssMSS.cc
   XrdOss/XrdOssPath.cc         XrdOss/XrdOssPath.hh
+  XrdOss/XrdOssReadAhead.cc    XrdOss/XrdOssReadAhead.hh
   XrdOss/XrdOssReloc.cc
   XrdOss/XrdOssRename.cc
   XrdOss/XrdOssSpace.cc        XrdOss/XrdOssSpace.hh
@@ -175,6 +177,7 @@ add_library(
   XrdCms/XrdCmsRTable.cc          XrdCms/XrdCmsRTable.hh
   XrdCms/XrdCmsSecurity.cc        XrdCms/XrdCmsSecurity.hh
   XrdCms/XrdCmsTalk.cc            XrdCms/XrdCmsTalk.hh
+                                  XrdCms/XrdCmsSMask.hh
                                   XrdCms/XrdCmsTypes.hh
   XrdCms/XrdCmsUtils.cc           XrdCms/XrdCmsUtils.hh
                                   XrdCms/XrdCmsVnId.hh
@@ -51,6 +51,21 @@ bool TPCHandler::Configure(const char *configfn, XrdOucEnv *myEnv)
                 m_log.Emsg("Config", "https.desthttps value is invalid", val);
                 return false;
             }
+        } else if (!strcmp("tpc.aio", val)) {
+            if (!(val = Config.GetWord())) {
+                Config.Close();
+                m_log.Emsg("Config", "tpc.aio value not specified");
+                return false;
+            }
+            if (!strcmp("1", val) || !strcasecmp("on", val) || !strcasecmp("true", val)) {
+                m_aio_write = true;
+            } else if (!strcmp("0", val) || !strcasecmp("off", val) || !strcasecmp("false", val)) {
+                m_aio_write = false;
+            } else {
+                Config.Close();
+                m_log.Emsg("Config", "tpc.aio value is invalid", val);
+                return false;
+            }
         } else if (!strcmp("tpc.trace", val)) {
             if (!ConfigureLogger(Config)) {
                 Config.Close();
@@ -268,6 +268,16 @@ int State::AvailableBuffers() const
     return m_stream->AvailableBuffers();
 }
 
+off_t State::BytesCopied() const
+{
+    return m_stream->BytesCopied();
+}
+
+off_t State::BytesWritten() const
+{
+    return m_stream->BytesWritten();
+}
+
 void State::DumpBuffers() const
 {
     m_stream->DumpBuffers();
@@ -77,8 +77,16 @@ public:
 
     CURL *GetHandle() const {return m_curl;}
 
+    bool IsPush() const {return m_push;}
+
     int AvailableBuffers() const;
 
+    // Bytes copied into the stream's reordering buffers versus bytes written
+    // to the underlying file; only meaningful for pull (non-push) transfers.
+    off_t BytesCopied() const;
+
+    off_t BytesWritten() const;
+
     void DumpBuffers() const;
 
     // Returns true if at least one byte of the response has been received,
@@ -1,15 +1,91 @@
 
+#include <new>
 #include <sstream>
 
+#include <cstdlib>
+#include <unistd.h>
+
 #include "XrdTpcStream.hh"
 
+#include "XrdSfs/XrdSfsAio.hh"
 #include "XrdSfs/XrdSfsInterface.hh"
 #include "XrdSys/XrdSysError.hh"
 
 using namespace TPC;
 
+XrdSysMutex Stream::BufferPool::m_mutex;
+std::map<size_t, std::vector<char *>> Stream::BufferPool::m_free;
+size_t Stream::BufferPool::m_idle = 0;
+
+
+char *
+Stream::BufferPool::Get(size_t size)
+{
+    {
+        XrdSysMutexHelper lock(m_mutex);
+        std::map<size_t, std::vector<char *>>::iterator iter = m_free.find(size);
+        if (iter != m_free.end() && !iter->second.empty()) {
+            char *buffer = iter->second.back();
+            iter->second.pop_back();
+            m_idle -= size;
+            return buffer;
+        }
+    }
+    void *buffer;
+    if (posix_memalign(&buffer, getpagesize(), size)) {
+        throw std::bad_alloc();
+    }
+    return static_cast<char *>(buffer);
+}
+
+
+void
+Stream::BufferPool::Put(char *buffer, size_t size)
+{
+    {
+        XrdSysMutexHelper lock(m_mutex);
+        if (m_idle + size <= m_max_idle) {
+            m_free[size].push_back(buffer);
+            m_idle += size;
+            return;
+        }
+    }
+    free(buffer);
+}
+
+
+class Stream::AioWrite : public XrdSfsAio {
+public:
+    AioWrite(Stream &stream, off_t offset, char *buffer, size_t size, size_t capacity)
+        : m_stream(stream),
+          m_buffer(buffer),
+          m_capacity(capacity)
+    {
+        sfsAio.aio_buf = buffer;
+        sfsAio.aio_nbytes = size;
+        sfsAio.aio_offset = offset;
+        Result = 0;
+    }
+
+    virtual void doneRead() {}
+
+    virtual void doneWrite() {m_stream.WriteAsyncDone(*this);}
+
+    virtual void Recycle() {delete this;}
+
+    char *Buffer() const {return m_buffer;}
+    size_t GetCapacity() const {return m_capacity;}
+
+private:
+    Stream &m_stream;
+    char *m_buffer;
+    size_t m_capacity;
+};
+
+
 Stream::~Stream()
 {
+    WaitAsync();
     for (std::vector<Entry*>::iterator buffer_iter = m_buffers.begin();
         buffer_iter != m_buffers.end();
         buffer_iter++) {
@@ -29,6 +105,9 @@ Stream::Finalize()
     }
     m_open_for_write = false;
 
+    // All asynchronous writes must land before the file handle is closed.
+    bool aio_ok = WaitAsync();
+
     for (std::vector<Entry*>::iterator buffer_iter = m_buffers.begin();
         buffer_iter != m_buffers.end();
         buffer_iter++) {
@@ -46,7 +125,7 @@ Stream::Finalize()
     }
 
     // If there are outstanding buffers to reorder, finalization failed
-    return m_avail_count == m_buffers.size();
+    return aio_ok && (m_avail_count == m_buffers.size());
 }
 
 
@@ -71,26 +150,35 @@ Stream::Write(off_t offset, const char *buf, size_t size, bool force)
         if (!m_error_buf.size()) {m_error_buf = "Logic error: writing to a buffer not opened for write";}
         return SFS_ERROR;
     }
+    if (m_async_write) {
+        // Fail fast should an asynchronous write have failed.
+        XrdSysCondVarHelper lock(m_aio_cond);
+        if (!m_aio_error.empty()) {
+            m_error_buf = m_aio_error;
+            return SFS_ERROR;
+        }
+    }
     size_t bytes_accepted = 0;
     int retval = size;
     if (offset < m_offset) {
         if (!m_error_buf.size()) {m_error_buf = "Logic error: writing to a prior offset";}
         return SFS_ERROR;
     }
-    // If this is write is appending to the stream and
-    // MB-aligned, then we write it to disk; otherwise, the
-    // data will be buffered.
-    if (offset == m_offset && (force || (size && !(size % (1024*1024))))) {
-        retval = WriteImpl(offset, buf, size);
-        bytes_accepted = retval;
+    // If this write is appending to the stream, then we write the
+    // MB-aligned portion straight to disk without copying it; the
+    // remainder (if any) will be buffered.
+    size_t direct_size = force ? size : (size - (size % (1024*1024)));
+    if (offset == m_offset && direct_size) {
+        ssize_t direct_rc = WriteImpl(offset, buf, direct_size);
             // On failure, we don't care about flushing buffers from memory --
             // the stream is now invalid.
-        if (retval < 0) {
-            return retval;
+        if (direct_rc < 0) {
+            return direct_rc;
         }
+        bytes_accepted = direct_rc;
         // If there are no in-use buffers, then we don't need to
         // do any accounting.
-        if (m_avail_count == m_buffers.size()) {
+        if (bytes_accepted == size && m_avail_count == m_buffers.size()) {
             return retval;
         }
     }
@@ -132,6 +220,7 @@ Stream::Write(off_t offset, const char *buf, size_t size, bool force)
                     buffer_was_written = true;
                 }
                 bytes_accepted += new_accept;
+                m_bytes_copied += new_accept;
             }
         }
     } while ((avail_count != m_buffers.size()) && buffer_was_written);
@@ -147,6 +236,7 @@ Stream::Write(off_t offset, const char *buf, size_t size, bool force)
             m_error_buf = "Empty re-ordering buffer was unable to to accept data; internal logic error.";
             return SFS_ERROR;
         }
+        m_bytes_copied += size - bytes_accepted;
         m_avail_count --;
     }
 
@@ -170,6 +260,9 @@ ssize_t Stream::WriteImpl(off_t offset, const char *buf, size_t size)
     retval = m_fh->write(offset, buf, size);
     if (retval != SFS_ERROR) {
         m_offset += retval;
+        m_aio_cond.Lock();
+        m_bytes_written += retval;
+        m_aio_cond.UnLock();
     } else {
         std::stringstream ss;
         const char *msg = m_fh->error.getErrText();
@@ -181,6 +274,89 @@ ssize_t Stream::WriteImpl(off_t offset, const char *buf, size_t size)
 }
 
 
+ssize_t Stream::WriteAsync(off_t offset, char *buf, size_t size, size_t capacity)
+{
+    // Throttle the number of writes in flight and fail fast if an earlier
+    // write has already failed; the stream is invalid at that point.
+    m_aio_cond.Lock();
+    while (m_aio_inflight >= m_aio_max && m_aio_error.empty()) {
+        m_aio_cond.Wait();
+    }
+    if (!m_aio_error.empty()) {
+        m_error_buf = m_aio_error;
+        m_aio_cond.UnLock();
+        BufferPool::Put(buf, capacity);
+        return SFS_ERROR;
+    }
+    m_aio_inflight++;
+    m_aio_cond.UnLock();
+
+    // Note that the completion callback may be invoked before write() returns.
+    AioWrite *aio = new AioWrite(*this, offset, buf, size, capacity);
+    if (m_fh->write(aio) == SFS_ERROR) {
+        std::stringstream ss;
+        const char *msg = m_fh->error.getErrText();
+        if (!msg || (*msg == '\0')) {msg = "(no error message provided)";}
+        ss << msg << " (code=" << m_fh->error.getErrInfo() << ")";
+        m_error_buf = ss.str();
+        BufferPool::Put(buf, capacity);
+        delete aio;
+        m_aio_cond.Lock();
+        m_aio_inflight--;
+        m_aio_cond.UnLock();
+        return SFS_ERROR;
+    }
+    m_offset += size;
+    return size;
+}
+
+
+void Stream::WriteAsyncDone(AioWrite &aio)
+{
+    ssize_t result = aio.Result;
+    size_t size = aio.sfsAio.aio_nbytes;
+    BufferPool::Put(aio.Buffer(), aio.GetCapacity());
+
+    // Once we signal, the stream may go away; do not touch it afterwards.
+    m_aio_cond.Lock();
+    if (result >= 0 && static_cast<size_t>(result) == size) {
+        m_bytes_written += result;
+    } else if (m_aio_error.empty()) {
+        std::stringstream ss;
+        ss << "Asynchronous write of " << size << " bytes at offset "
+           << aio.sfsAio.aio_offset << " failed: ";
+        if (result < 0) {ss << strerror(-result) << " (code=" << -result << ")";}
+        else {ss << "short write of " << result << " bytes";}
+        m_aio_error = ss.str();
+    }
+    m_aio_inflight--;
+    m_aio_cond.Signal();
+    m_aio_cond.UnLock();
+    aio.Recycle();
+}
+
+
+bool Stream::WaitAsync()
+{
+    XrdSysCondVarHelper lock(m_aio_cond);
+    while (m_aio_inflight) {
+        m_aio_cond.Wait();
+    }
+    if (!m_aio_error.empty()) {
+        m_error_buf = m_aio_error;
+        return false;
+    }
+    return true;
+}
+
+
+off_t Stream::BytesWritten() const
+{
+    XrdSysCondVarHelper lock(m_aio_cond);
+    return m_bytes_written;
+}
+
+
 void
 Stream::DumpBuffers() const
 {
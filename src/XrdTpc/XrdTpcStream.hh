@@ -7,12 +7,15 @@
  * supports single-stream writes.
  */
 
+#include <map>
 #include <memory>
 #include <vector>
 #include <string>
 
 #include <cstring>
 
+#include "XrdSys/XrdSysPthread.hh"
+
 struct stat;
 
 class XrdSfsFile;
@@ -21,11 +24,18 @@ class XrdSysError;
 namespace TPC {
 class Stream {
 public:
-    Stream(std::unique_ptr<XrdSfsFile> fh, size_t max_blocks, size_t buffer_size, XrdSysError &log)
+    Stream(std::unique_ptr<XrdSfsFile> fh, size_t max_blocks, size_t buffer_size, XrdSysError &log,
+           bool async_write=false)
         : m_open_for_write(false),
+          m_async_write(async_write),
           m_avail_count(max_blocks),
           m_fh(std::move(fh)),
           m_offset(0),
+          m_bytes_copied(0),
+          m_bytes_written(0),
+          m_aio_cond(0),
+          m_aio_inflight(0),
+          m_aio_max(max_blocks ? max_blocks : 1),
           m_log(log)
     {
         m_buffers.reserve(max_blocks);
@@ -68,16 +78,46 @@ public:
 
     std::string GetErrorMessage() const {return m_error_buf;}
 
+    // Number of bytes copied into the reordering buffers versus the number of
+    // bytes the underlying file handle has successfully written.  Data that
+    // arrives in order and aligned is written through without being copied.
+    off_t BytesCopied() const {return m_bytes_copied;}
+
+    off_t BytesWritten() const;
+
 private:
 
+    // A process-wide pool of page-aligned buffers shared by all transfers;
+    // this avoids allocating (and zero-filling) a block-sized buffer each time
+    // a reordering buffer is reused.  At most m_max_idle bytes are kept idle.
+    class BufferPool {
+    public:
+        static char *Get(size_t size);
+        static void  Put(char *buffer, size_t size);
+
+    private:
+        static XrdSysMutex m_mutex;
+        static std::map<size_t, std::vector<char *>> m_free;
+        static size_t m_idle;
+        static const size_t m_max_idle = 256*1024*1024;
+    };
+
+    // Asynchronous write of a buffer owned by the stream; see WriteAsync().
+    class AioWrite;
+
     class Entry {
     public:
         Entry(size_t capacity) :
             m_offset(-1),
             m_capacity(capacity),
-            m_size(0)
+            m_size(0),
+            m_buffer(NULL)
         {}
 
+        ~Entry() {
+            if (m_buffer) {BufferPool::Put(m_buffer, m_capacity);}
+        }
+
         bool Available() const {return m_offset == -1;}
 
         int Write(Stream &stream, bool force) {
@@ -90,7 +130,15 @@ private:
             if (!force && (m_size != m_capacity)) {
                 return 0;
             }
-            ssize_t retval = stream.WriteImpl(m_offset, &m_buffer[0], m_size);
+            ssize_t retval;
+            if (stream.m_async_write) {
+                // The stream takes ownership of the buffer until the write
+                // completes; this entry gets a fresh one from the pool.
+                retval = stream.WriteAsync(m_offset, m_buffer, m_size, m_capacity);
+                m_buffer = NULL;
+            } else {
+                retval = stream.WriteImpl(m_offset, m_buffer, m_size);
+            }
             // Currently the only valid negative value is SFS_ERROR (-1); checking for
             // all negative values to future-proof the code.
             if ((retval < 0) || (static_cast<size_t>(retval) != m_size)) {
@@ -98,7 +146,6 @@ private:
             }
             m_offset = -1;
             m_size = 0;
-            m_buffer.clear();
             return retval;
         }
 
@@ -113,14 +160,13 @@ private:
                 size = to_accept;
             }
 
-            // Inflate the underlying buffer if needed.
-            ssize_t new_bytes_needed = (m_size + size) - m_buffer.size();
-            if (new_bytes_needed > 0) {
-                m_buffer.resize(m_capacity);
+            // Attach a pooled buffer if we do not have one.
+            if (!m_buffer) {
+                m_buffer = BufferPool::Get(m_capacity);
             }
 
             // Finally, do the copy.
-            memcpy(&m_buffer[0] + m_size, buf, size);
+            memcpy(m_buffer + m_size, buf, size);
             m_size += size;
             if (m_offset == -1) {
                 m_offset = offset;
@@ -129,14 +175,13 @@ private:
         }
 
         void ShrinkIfUnused() {
-           if (!Available()) {return;}
-#if __cplusplus > 199711L
-           m_buffer.shrink_to_fit();
-#endif
+           if (!Available() || !m_buffer) {return;}
+           BufferPool::Put(m_buffer, m_capacity);
+           m_buffer = NULL;
         }
 
         void Move(Entry &other) {
-            m_buffer.swap(other.m_buffer);
+            std::swap(m_buffer, other.m_buffer);
             m_offset = other.m_offset;
             m_size = other.m_size;
         }
@@ -156,15 +201,31 @@ private:
         off_t m_offset;  // Offset within file that m_buffer[0] represents.
         size_t m_capacity;
         size_t m_size;  // Number of bytes held in buffer.
-        std::vector<char> m_buffer;
+        char *m_buffer;  // Pooled buffer of m_capacity bytes; NULL when not attached.
     };
 
     ssize_t WriteImpl(off_t offset, const char *buffer, size_t size);
 
+    // Submit an asynchronous write of a pooled buffer; the buffer is returned
+    // to the pool once the write completes.  At most m_aio_max writes may be
+    // in flight.  Returns size on successful submission or SFS_ERROR.
+    ssize_t WriteAsync(off_t offset, char *buffer, size_t size, size_t capacity);
+    void    WriteAsyncDone(AioWrite &aio);
+
+    // Wait for all asynchronous writes to complete; returns false if any failed.
+    bool    WaitAsync();
+
     bool m_open_for_write;
+    bool m_async_write;
     size_t m_avail_count;
     std::unique_ptr<XrdSfsFile> m_fh;
     off_t m_offset;
+    off_t m_bytes_copied;
+    off_t m_bytes_written;  // Protected by m_aio_cond
+    mutable XrdSysCondVar m_aio_cond;
+    size_t m_aio_inflight;  // Protected by m_aio_cond
+    size_t m_aio_max;
+    std::string m_aio_error;  // Protected by m_aio_cond
     std::vector<Entry*> m_buffers;
     XrdSysError &m_log;
     std::string m_error_buf;
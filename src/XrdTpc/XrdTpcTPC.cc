@@ -297,6 +297,7 @@ TPCHandler::~TPCHandler() {
   
 TPCHandler::TPCHandler(XrdSysError *log, const char *config, XrdOucEnv *myEnv) :
         m_desthttps(false),
+        m_aio_write(false),
         m_timeout(60),
         m_first_timeout(120),
         m_log(log->logger(), "TPC_"),
@@ -473,6 +474,10 @@ int TPCHandler::SendPerfMarker(XrdHttpExtReq &req, TPCLogRecord &rec, TPC::State
     ss << "Stripe Index: 0" << crlf;
     ss << "Stripe Bytes Transferred: " << state.BytesTransferred() << crlf;
     ss << "Total Stripe Count: 1" << crlf;
+    if (!state.IsPush()) {
+        ss << "Stripe Bytes Copied: " << state.BytesCopied() << crlf;
+        ss << "Stripe Bytes Written: " << state.BytesWritten() << crlf;
+    }
     // Include the TCP connection associated with this transfer; used by
     // the TPC client for monitoring purposes.
     std::string desc = state.GetConnectionDescription();
@@ -502,6 +507,8 @@ int TPCHandler::SendPerfMarker(XrdHttpExtReq &req, TPCLogRecord &rec, std::vecto
     //    Stripe Index: 0\n
     //    Stripe Bytes Transferred: 238745\n
     //    Total Stripe Count: 1\n
+    //    Stripe Bytes Copied: 65536\n
+    //    Stripe Bytes Written: 196608\n
     //    RemoteConnections: tcp:129.93.3.4:1234,tcp:[2600:900:6:1301:268a:7ff:fef6:a590]:2345\n
     //    End\n
     //
@@ -512,6 +519,12 @@ int TPCHandler::SendPerfMarker(XrdHttpExtReq &req, TPCLogRecord &rec, std::vecto
     ss << "Stripe Index: 0" << crlf;
     ss << "Stripe Bytes Transferred: " << bytes_transferred << crlf;
     ss << "Total Stripe Count: 1" << crlf;
+    // All the states share the same stream; for pulls, report how much of the
+    // data had to be copied for reordering and how much has reached the disk.
+    if (!state.empty() && !state.front()->IsPush()) {
+        ss << "Stripe Bytes Copied: " << state.front()->BytesCopied() << crlf;
+        ss << "Stripe Bytes Written: " << state.front()->BytesWritten() << crlf;
+    }
     // Build a list of TCP connections associated with this transfer; used by
     // the TPC client for monitoring purposes.
     bool first = true;
@@ -960,7 +973,8 @@ int TPCHandler::ProcessPullReq(const std::string &resource, XrdHttpExtReq &req)
     }
     ConfigureCurlCA(curl);
     curl_easy_setopt(curl, CURLOPT_URL, resource.c_str());
-    Stream stream(std::move(fh), streams * m_pipelining_multiplier, streams > 1 ? m_block_size : m_small_block_size, m_log);
+    Stream stream(std::move(fh), streams * m_pipelining_multiplier, streams > 1 ? m_block_size : m_small_block_size, m_log,
+                  m_aio_write);
     State state(0, stream, curl, false);
     state.CopyHeaders(req);
 
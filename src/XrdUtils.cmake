@@ -123,6 +123,7 @@ set ( XrdOucSources
   XrdOuc/XrdOucName2Name.cc     XrdOuc/XrdOucName2Name.hh
   XrdOuc/XrdOucN2NLoader.cc     XrdOuc/XrdOucN2NLoader.hh
   XrdOuc/XrdOucNList.cc         XrdOuc/XrdOucNList.hh
+  XrdOuc/XrdOucNSPWalk.cc       XrdOuc/XrdOucNSPWalk.hh
   XrdOuc/XrdOucNSWalk.cc        XrdOuc/XrdOucNSWalk.hh
   XrdOuc/XrdOucPgrwUtils.cc     XrdOuc/XrdOucPgrwUtils.hh
                                 XrdOuc/XrdOucPinKing.hh
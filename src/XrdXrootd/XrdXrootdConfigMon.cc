@@ -87,6 +87,8 @@ struct XrdXrootdGSReal::GSParms gsObj[] =
         {"TcpMon", 0, XROOTD_MON_TCPMO, 0, -1, XROOTD_MON_GSTCP, 0,
                    XrdXrootdGSReal::fmtBin, XrdXrootdGSReal::hdrNorm},
         {"Tpc",    0, XROOTD_MON_TPC,   0, -1, XROOTD_MON_GSTPC, 0,
+                   XrdXrootdGSReal::fmtBin, XrdXrootdGSReal::hdrNorm},
+        {"oss",    0, XROOTD_MON_OSS,   0, -1, XROOTD_MON_GSOSS, 0,
                    XrdXrootdGSReal::fmtBin, XrdXrootdGSReal::hdrNorm}
        };
 }
@@ -100,7 +102,7 @@ bool XrdXrootdProtocol::ConfigGStream(XrdOucEnv &myEnv, XrdOucEnv *urEnv)
    XrdXrootdGStream *gs;
    static const int numgs=sizeof(gsObj)/sizeof(struct XrdXrootdGSReal::GSParms);
    char vbuff[64];
-   bool aOK, gXrd[numgs] = {false, false, true, true};
+   bool aOK, gXrd[numgs] = {false, false, true, true, false};
 
 // For each enabled monitoring provider, allocate a g-stream and put
 // its address in our environment.
@@ -190,7 +192,9 @@ bool XrdXrootdProtocol::ConfigMon(XrdProtocol_Config *pi, XrdOucEnv &xrootdEnv)
                                       [rbuff <sz>] [rnums <cnt>] [window <sec>]
                                       [dest [Events] <host:port>]
 
-   Events: [ccm] [files] [fstat] [info] [io] [iov] [pfc] [redir] [tcpmon] [user]
+   Events: [ccm] [files] [fstat] [info] [io] [iov] [oss] [pfc] [redir] [tcpmon]
+
+           [tpc] [user]
 
          all                enables monitoring for all connections.
          auth               add authentication information to "user".
@@ -219,6 +223,7 @@ bool XrdXrootdProtocol::ConfigMon(XrdProtocol_Config *pi, XrdOucEnv &xrootdEnv)
          info               monitors client appid and info requests.
          io                 monitors I/O requests, and files open/close events.
          iov                like I/O but also unwinds vector reads.
+         oss                storage system latency statistics
          pfc                monitor proxy file cache
          redir              monitors request redirections
          tcpmon             monitors tcp connection closes.
@@ -350,6 +355,7 @@ int XrdXrootdProtocol::xmon(XrdOucStream &Config)
               else if (!strcmp("io",   val)) MP->monMode[i] |=  XROOTD_MON_IO;
               else if (!strcmp("iov",  val)) MP->monMode[i] |= (XROOTD_MON_IO
                                                                |XROOTD_MON_IOV);
+              else if (!strcmp("oss",  val)) MP->monMode[i] |=  XROOTD_MON_OSS;
               else if (!strcmp("pfc",  val)) MP->monMode[i] |=  XROOTD_MON_PFC;
               else if (!strcmp("redir",val)) MP->monMode[i] |=  XROOTD_MON_REDR;
               else if (!strcmp("tcpmon",val))MP->monMode[i] |=  XROOTD_MON_TCPMO;
@@ -444,7 +450,7 @@ char *XrdXrootdProtocol::xmondest(const char *what, char *val)
 
    Purpose:  Parse directive: mongstream <strm> use <opts>
 
-   <strm>:  {all | ccm | pfc | tcpmon | tpc}  [<strm>]
+   <strm>:  {all | ccm | oss | pfc | tcpmon | tpc}  [<strm>]
 
    <opts>:  [flust <t>] [maxlen <l>] [send <fmt> [noident] <host:port>]
 
@@ -454,6 +460,7 @@ char *XrdXrootdProtocol::xmondest(const char *what, char *val)
 
          all                applies options to all gstreams.
          ccm                gstream: cache context management
+         oss                gstream: storage system latency statistics
          pfc                gstream: proxy file cache
          tcpmon             gstream: tcp connection monitoring
          tpc                gstream: Third Party Copy
@@ -478,7 +485,7 @@ int XrdXrootdProtocol::xmongs(XrdOucStream &Config)
 
    int numgs = sizeof(gsObj)/sizeof(struct XrdXrootdGSReal::GSParms);
    int selAll = XROOTD_MON_CCM | XROOTD_MON_PFC | XROOTD_MON_TCPMO
-              | XROOTD_MON_TPC;
+              | XROOTD_MON_TPC | XROOTD_MON_OSS;
    int i, selMon = 0, opt = -1, hdr = -1, fmt = -1, flushVal = -1;
    long long maxlVal = -1;
    char *val, *dest = 0;
@@ -96,7 +96,9 @@ XrdXrootdGSReal::XrdXrootdGSReal(const XrdXrootdGSReal::GSParms &gsParms,
               else if (maxL >= 1024)  align = 1024;
                       else            align = sizeof(void*);
 
-   if (posix_memalign((void **)&udpBuffer, align, maxL)) {aOK = false; return;}
+   if (posix_memalign((void **)&udpBuffer, align, maxL)
+   ||  posix_memalign((void **)&stgBuffer, align, maxL)) {aOK = false; return;}
+   stgSize = stgTBeg = 0;
 
 // Setup the header as needed
 //
@@ -178,7 +180,8 @@ void XrdXrootdGSReal::DoIt()
 //
    afRunning = false;
    if (afTime)
-      {if (tBeg && time(0)-tBeg >= afTime) Expel(0);
+      {int tOld = (stgSize ? stgTBeg : tBeg);
+       if (tOld && time(0)-tOld >= afTime) Expel(0);
        AutoFlush();
       }
 }
@@ -190,9 +193,13 @@ void XrdXrootdGSReal::DoIt()
 void XrdXrootdGSReal::Expel(int dlen) // gMutex is held
 {
 
-// Check if we need to flush this buffer.
+// Check if we need to flush this buffer. A staged buffer is always sent when
+// a flush is requested.
 //
-   if (udpBFirst == udpBNext || (dlen && (udpBNext + dlen) < udpBEnd)) return;
+   if (udpBFirst == udpBNext || (dlen && (udpBNext + dlen) < udpBEnd))
+      {if (!dlen && stgSize) Ship(0);
+       return;
+      }
    int size =  udpBNext-udpBuffer;
 
 // Complete the buffer header if may be binary of text
@@ -223,10 +230,13 @@ void XrdXrootdGSReal::Expel(int dlen) // gMutex is held
 //
    *(udpBNext-1) = 0;
 
-// Send off the packet
+// If the buffer simply overflowed, stage it and continue with the alternate
+// buffer so that both can be sent using a single system call. A buffer is only
+// staged when autoflush is on as that bounds how long it waits. Otherwise,
+// send off whatever we have.
 //
-   if (udpDest) udpDest->Send(udpBuffer, size);
-      else XrdXrootdMonitor::Send(monType, udpBuffer, size, false);
+   if (dlen && !stgSize && afTime) Stage(size);
+      else Ship(size);
 
 // Reset the buffer
 //
@@ -577,6 +587,65 @@ char *XrdXrootdGSReal::Reserve(int dlen)
    return udpBNext;
 }
 
+/******************************************************************************/
+/* Private:                         S h i p                                   */
+/******************************************************************************/
+
+void XrdXrootdGSReal::Ship(int size) // gMutex is held
+{
+   struct iovec pktV[2];
+   int pktN = 0;
+
+// Send the staged buffer, if any, followed by the current buffer, if any
+//
+   if (stgSize)
+      {pktV[pktN].iov_base = stgBuffer;
+       pktV[pktN++].iov_len = stgSize;
+      }
+   if (size)
+      {pktV[pktN].iov_base = udpBuffer;
+       pktV[pktN++].iov_len = size;
+      }
+
+// Send off the packets as a batch
+//
+   if (udpDest) udpDest->SendBatch(pktV, pktN);
+      else {int pktM[2] = {monType, monType};
+            XrdXrootdMonitor::Send(pktM, pktV, pktN, false);
+           }
+   stgSize = stgTBeg = 0;
+}
+
+/******************************************************************************/
+/* Private:                        S t a g e                                  */
+/******************************************************************************/
+
+void XrdXrootdGSReal::Stage(int size) // gMutex is held
+{
+   char *oldBuff = udpBuffer;
+   long  delta;
+
+// Swap the current buffer with the alternate one and copy over the header
+//
+   udpBuffer = stgBuffer;
+   stgBuffer = oldBuff;
+   stgSize   = size;
+   stgTBeg   = tBeg;
+   memcpy(udpBuffer, stgBuffer, udpBFirst-stgBuffer);
+
+// Relocate all of the pointers that refer into the buffer
+//
+   delta = udpBuffer - stgBuffer;
+   if (binHdr) binHdr = (XrdXrootdMonGS*)udpBuffer;
+   if (hInfo.pseq)
+      {hInfo.pseq += delta;
+       hInfo.tbeg += delta;
+       hInfo.tend += delta;
+      }
+   udpBFirst += delta;
+   udpBEnd   += delta;
+}
+
 /******************************************************************************/
 /*                          S e t A u t o F l u s h                           */
 /******************************************************************************/
@@ -585,10 +654,12 @@ int XrdXrootdGSReal::SetAutoFlush(int afsec)
 {
    XrdSysMutexHelper gHelp(gMutex);
 
-// Save the current settting and establish the new one and relaunch
+// Save the current settting and establish the new one and relaunch. Should
+// autoflush be turned off, nothing would ever send a staged buffer.
 //
    int afNow = afTime;
    afTime = (afsec > 0 ? afsec : 0);
+   if (!afTime && stgSize) Ship(0);
    AutoFlush();
 
 // All done
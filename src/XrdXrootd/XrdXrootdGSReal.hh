@@ -119,6 +119,8 @@ void Expel(int dlen);
 int  hdrBIN(const GSParms &gs);
 int  hdrCGI(const GSParms &gs, char *buff, int blen);
 int  hdrJSN(const GSParms &gs, char *buff, int blen);
+void Ship(int size);
+void Stage(int size);
 
 struct HdrInfo
       {char *pseq;
@@ -137,11 +139,14 @@ XrdSysRecMutex         gMutex;
 XrdNetMsg             *udpDest;
 XrdXrootdMonGS        *binHdr;
 char                  *udpBuffer;
+char                  *stgBuffer;  // Alternate buffer for batched sends
 char                  *udpBFirst;
 char                  *udpBNext;
 char                  *udpBEnd;
 int                    tBeg;
 int                    tEnd;
+int                    stgSize;
+int                    stgTBeg;
 int                    rsvbytes;
 int                    monType;
 int                    afTime;
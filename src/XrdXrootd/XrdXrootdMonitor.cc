@@ -62,6 +62,9 @@ int                XrdXrootdMonitor::monMode2   = 0;
 XrdNetMsg         *XrdXrootdMonitor::InetDest2  = 0;
 XrdXrootdMonitor  *XrdXrootdMonitor::altMon     = 0;
 XrdSysMutex        XrdXrootdMonitor::windowMutex;
+XrdSysMutex        XrdXrootdMonitor::sendMutex;
+int                XrdXrootdMonitor::sendSeq1   = 0;
+int                XrdXrootdMonitor::sendSeq2   = 0;
 int                XrdXrootdMonitor::monRlen    = 0;
 XrdXrootdMonitor::MonRdrBuff
                    XrdXrootdMonitor::rdrMon[XrdXrootdMonitor::rdrMax];
@@ -940,8 +943,11 @@ int XrdXrootdMonitor::Redirect(kXR_unt32 mID, const char *hName, int Port,
   
 time_t XrdXrootdMonitor::Tick()
 {
+   static char *tickBuff = 0;
+   struct iovec pktV[rdrMax+1];
    time_t Now = time(0);
-   int    nextFlush;
+   char  *bP;
+   int    pktM[rdrMax+1], pktN = 0, nextFlush, size;
 
 // We can safely set the window as we are the only ones doing so and memory
 // access is atomic as long as it sits within a cache line (which it does).
@@ -950,13 +956,26 @@ time_t XrdXrootdMonitor::Tick()
    rdrTOD     = htonl(currWindow);
    nextFlush  = currWindow + autoFlush;
 
+// Due buffers are copied so that they can be reinitialized and unlocked before
+// being sent as one batch. Only the clock calls us, so one copy area will do.
+//
+   if (!tickBuff && !(tickBuff = (char *)malloc(monBlen + rdrMax*monRlen)))
+      return Now;
+   bP = tickBuff;
+
 // Check to see if we should flush the alternate monitor
 //
    if (altMon && currWindow >= FlushTime)
       {XrdXrootdMonitorLock::Lock();
        if (currWindow >= FlushTime)
-          {if (altMon->nextEnt > 1) altMon->Flush();
-              else FlushTime = nextFlush;
+          {if ((size = altMon->FlushBeg()))
+              {memcpy(bP, altMon->monBuff, size);
+               pktV[pktN].iov_base = bP;
+               pktV[pktN].iov_len  = size;
+               pktM[pktN++] = XROOTD_MON_FILE;
+               bP += size;
+               altMon->FlushEnd(currWindow);
+              } else FlushTime = nextFlush;
           }
        XrdXrootdMonitorLock::UnLock();
       }
@@ -968,11 +987,23 @@ time_t XrdXrootdMonitor::Tick()
        while(n--)
             {rdrMon[n].Mutex.Lock();
              if (rdrMon[n].nextEnt == 0) rdrMon[n].flushIt = nextFlush;
-                else if (rdrMon[n].flushIt <= currWindow) Flush(&rdrMon[n]);
+                else if (rdrMon[n].flushIt <= currWindow
+                     &&  (size = FlushBeg(&rdrMon[n])))
+                        {memcpy(bP, rdrMon[n].Buff, size);
+                         pktV[pktN].iov_base = bP;
+                         pktV[pktN].iov_len  = size;
+                         pktM[pktN++] = XROOTD_MON_REDR;
+                         bP += size;
+                         FlushEnd(&rdrMon[n]);
+                        }
              rdrMon[n].Mutex.UnLock();
             }
       }
 
+// Send whatever we have
+//
+   if (pktN) Send(pktM, pktV, pktN);
+
 // All done. Stop the clock if there is no reason for it to be running. The
 // clock always runs if we are monitoring redirects or all clients. Otherwise,
 // the clock only runs if we have a one or more client-specific monitors.
@@ -1047,18 +1078,35 @@ void XrdXrootdMonitor::fillHeader(XrdXrootdMonHeader *hdr,
   
 void XrdXrootdMonitor::Flush()
 {
+   kXR_int32 localWindow;
    int       size;
-   kXR_int32 localWindow, now;
-
-// Do not flush if the buffer is empty
-//
-   if (nextEnt <= 1) return;
 
 // Get the current window marker. No need for locks as simple memory accesses
 // are sufficiently synchrnozed for our purposes.
 //
    localWindow = currWindow;
 
+// Complete the buffer, do not flush if the buffer is empty
+//
+   if (!(size = FlushBeg())) return;
+
+// Send off the buffer and reinitialize it
+//
+   Send((this != altMon ? XROOTD_MON_IO : XROOTD_MON_FILE), (void *)monBuff, size);
+   FlushEnd(localWindow);
+}
+
+/******************************************************************************/
+
+int XrdXrootdMonitor::FlushBeg()
+{
+   int       size;
+   kXR_int32 now;
+
+// Do not flush if the buffer is empty
+//
+   if (nextEnt <= 1) return 0;
+
 // Fill in the header and in the process we will have the current time
 //
    size = (nextEnt+1)*sizeof(XrdXrootdMonTrace)+sizeof(XrdXrootdMonHeader);
@@ -1072,12 +1120,19 @@ void XrdXrootdMonitor::Flush()
    now = lastWindow + sizeWindow;
    setTMark(monBuff, nextEnt, now);
 
-// Send off the buffer and reinitialize it
+// Return the size of the buffer that must now be sent
 //
-   if (this != altMon) Send(XROOTD_MON_IO, (void *)monBuff, size);
-      else {Send(XROOTD_MON_FILE, (void *)monBuff, size);
-            FlushTime = localWindow + autoFlush;
-           }
+   return size;
+}
+
+/******************************************************************************/
+
+void XrdXrootdMonitor::FlushEnd(kXR_int32 localWindow)
+{
+
+// Reinitialize the buffer after it has been sent
+//
+   if (this == altMon) FlushTime = localWindow + autoFlush;
    setTMark(monBuff, 0, localWindow);
    nextEnt = 1;
 }
@@ -1088,11 +1143,27 @@ void XrdXrootdMonitor::Flush(XrdXrootdMonitor::MonRdrBuff *mP)
 {
    int size;
 
+// Complete the buffer, do not flush if the buffer is empty
+//
+   if (!(size = FlushBeg(mP))) return;
+
+// Send off the buffer and reinitialize it
+//
+   Send(XROOTD_MON_REDR, (void *)(mP->Buff), size);
+   FlushEnd(mP);
+}
+
+/******************************************************************************/
+
+int XrdXrootdMonitor::FlushBeg(XrdXrootdMonitor::MonRdrBuff *mP)
+{
+   int size;
+
 // Reset flush time but do not flush an empty buffer. We use the current time
 // to make sure a record atleast sits in the buffer a full flush period.
 //
    mP->flushIt = static_cast<int>(time(0)) + autoFlush;
-   if (mP->nextEnt <= 1) return;
+   if (mP->nextEnt <= 1) return 0;
 
 // Set ending timing mark and force a new one on the next fill
 //
@@ -1104,9 +1175,15 @@ void XrdXrootdMonitor::Flush(XrdXrootdMonitor::MonRdrBuff *mP)
    size = (mP->nextEnt+1)*sizeof(XrdXrootdMonRedir)+sizeof(XrdXrootdMonHeader)+8;
    fillHeader(&(mP->Buff->hdr), XROOTD_MON_MAPREDR, size);
 
-// Send off the buffer and reinitialize it
+// Return the size of the buffer that must now be sent
 //
-   Send(XROOTD_MON_REDR, (void *)(mP->Buff), size);
+   return size;
+}
+
+/******************************************************************************/
+
+void XrdXrootdMonitor::FlushEnd(XrdXrootdMonitor::MonRdrBuff *mP)
+{
    mP->nextEnt = 0;
 }
 
@@ -1174,8 +1251,6 @@ int XrdXrootdMonitor::Send(int monMode, void *buff, int blen, bool setseq)
 #ifndef NODEBUG
     const char *TraceID = "Monitor";
 #endif
-    static XrdSysMutex sendMutex;
-    static int seq1=0, seq2=0;
     XrdXrootdMonHeader *mHdr=0;
     int rc1, rc2;
 
@@ -1186,13 +1261,13 @@ int XrdXrootdMonitor::Send(int monMode, void *buff, int blen, bool setseq)
 
     sendMutex.Lock();
     if (monMode & monMode1 && InetDest1)
-       {if (mHdr) mHdr->pseq = (seq1++) & 0xff;
+       {if (mHdr) mHdr->pseq = (sendSeq1++) & 0xff;
         rc1  = InetDest1->Send((char *)buff, blen);
         TRACE(DEBUG,blen <<" bytes sent to " <<Dest1 <<" rc=" <<rc1);
        }
        else rc1 = 0;
     if (monMode & monMode2 && InetDest2)
-       {if (mHdr) mHdr->pseq = (seq2++) & 0xff;
+       {if (mHdr) mHdr->pseq = (sendSeq2++) & 0xff;
         rc2  = InetDest2->Send((char *)buff, blen);
         TRACE(DEBUG,blen <<" bytes sent to " <<Dest2 <<" rc=" <<rc2);
        }
@@ -1202,6 +1277,69 @@ int XrdXrootdMonitor::Send(int monMode, void *buff, int blen, bool setseq)
     return (rc1 ? rc1 : rc2);
 }
 
+/******************************************************************************/
+
+int XrdXrootdMonitor::Send(const int monMode[], struct iovec pktV[], int pktN,
+                           bool setseq)
+{
+   static const int pktMax = rdrMax+8;
+   struct iovec dstV[pktMax];
+   int rc1, rc2;
+
+// Split up the batch if it is too large for us to handle in one go
+//
+   if (pktN > pktMax)
+      {rc1 = Send(monMode, pktV, pktMax, setseq);
+       rc2 = Send(monMode+pktMax, pktV+pktMax, pktN-pktMax, setseq);
+       return (rc1 ? rc1 : rc2);
+      }
+
+// Send all applicable packets to each destination in a single system call.
+// Sequence numbers are assigned in packet order just as if each packet were
+// sent individually.
+//
+    sendMutex.Lock();
+    rc1 = SendBatch(InetDest1, Dest1, monMode1, sendSeq1,
+                    monMode, pktV, pktN, dstV, setseq);
+    rc2 = SendBatch(InetDest2, Dest2, monMode2, sendSeq2,
+                    monMode, pktV, pktN, dstV, setseq);
+    sendMutex.UnLock();
+
+    return (rc1 ? rc1 : rc2);
+}
+
+/******************************************************************************/
+/* Private:                    S e n d B a t c h                              */
+/******************************************************************************/
+
+int XrdXrootdMonitor::SendBatch(XrdNetMsg *netDest, const char *dName,
+                                int dMode, int &dSeq, const int monMode[],
+                                struct iovec pktV[], int pktN,
+                                struct iovec dstV[], bool setseq)
+{
+#ifndef NODEBUG
+    const char *TraceID = "Monitor";
+#endif
+   int dstN = 0, rc;
+
+// Collect the packets destined for this endpoint (sendMutex is held)
+//
+   if (!netDest) return 0;
+   for (int i = 0; i < pktN; i++)
+       {if (!(monMode[i] & dMode)) continue;
+        if (setseq) static_cast<XrdXrootdMonHeader *>(pktV[i].iov_base)->pseq
+                       = (dSeq++) & 0xff;
+        dstV[dstN++] = pktV[i];
+       }
+   if (!dstN) return 0;
+
+// Send them off
+//
+   rc = netDest->SendBatch(dstV, dstN);
+   TRACE(DEBUG,dstN <<" packets batch sent to " <<dName <<" rc=" <<rc);
+   return rc;
+}
+
 /******************************************************************************/
 /*                            s t a r t C l o c k                             */
 /******************************************************************************/
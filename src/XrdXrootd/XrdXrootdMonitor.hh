@@ -58,7 +58,9 @@
 #define XROOTD_MON_PFC   0x00000400
 #define XROOTD_MON_TCPMO 0x00000800
 #define XROOTD_MON_TPC   0x00001000
-#define XROOTD_MON_GSTRM (XROOTD_MON_CCM | XROOTD_MON_PFC | XROOTD_MON_TCPMO)
+#define XROOTD_MON_OSS   0x00002000
+#define XROOTD_MON_GSTRM (XROOTD_MON_CCM | XROOTD_MON_PFC | XROOTD_MON_TCPMO \
+                         | XROOTD_MON_OSS)
 
 #define XROOTD_MON_FSLFN    1
 #define XROOTD_MON_FSOPS    2
@@ -142,6 +144,9 @@ static int               Redirect(kXR_unt32  mID, const char *hName, int Port,
 
 static int               Send(int mmode, void *buff, int size, bool setseq=true);
 
+static int               Send(const int mmode[], struct iovec pktV[], int pktN,
+                              bool setseq=true);
+
 static time_t            Tick();
 
 /******************************************************************************/
@@ -260,14 +265,25 @@ static void              fillHeader(XrdXrootdMonHeader *hdr,
                                     const char id, int size);
 static MonRdrBuff       *Fetch();
        void              Flush();
+       int               FlushBeg();
+       void              FlushEnd(kXR_int32 localWindow);
 static void              Flush(MonRdrBuff *mP);
+static int               FlushBeg(MonRdrBuff *mP);
+static void              FlushEnd(MonRdrBuff *mP);
 static kXR_unt32         Map(char  code, XrdXrootdMonitor::User &uInfo,
                              const char *path);
        void              Mark();
+static int               SendBatch(XrdNetMsg *netDest, const char *dName,
+                                   int dMode, int &dSeq, const int monMode[],
+                                   struct iovec pktV[], int pktN,
+                                   struct iovec dstV[], bool setseq);
 static void              startClock();
 static void              unAlloc(XrdXrootdMonitor *monp);
 
 static XrdSysMutex        windowMutex;
+static XrdSysMutex        sendMutex;
+static int                sendSeq1;
+static int                sendSeq2;
 static char              *idRec;
 static int                idLen;
 static char              *Dest1;
@@ -30,6 +30,7 @@
 #include <cstdio>
   
 #include "Xrd/XrdStats.hh"
+#include "XrdNet/XrdNetMsg.hh"
 #include "XrdSfs/XrdSfsInterface.hh"
 #include "XrdXrootd/XrdXrootdResponse.hh"
 #include "XrdXrootd/XrdXrootdStats.hh"
@@ -88,10 +89,12 @@ int XrdXrootdStats::Stats(char *buff, int blen, int do_sync)
    "<sig><ok>%d</ok><bad>%d</bad><ign>%d</ign></sig>"
    "<aio><num>%lld</num><max>%d</max><rej>%lld</rej></aio>"
    "<err>%d</err><rdr>%lld</rdr><dly>%d</dly>"
-   "<lgn><num>%d</num><af>%d</af><au>%d</au><ua>%d</ua></lgn></stats>";
+   "<lgn><num>%d</num><af>%d</af><au>%d</au><ua>%d</ua></lgn>"
+   "<mon><calls>%lld</calls><pkts>%lld</pkts></mon></stats>";
 //                                   1 2 3 4 5 6 7 8
    static const long long LLMax = 0x7fffffffffffffffLL;
    static const int       INMax = 0x7fffffff;
+   long long monCalls, monPkts;
    int len;
 
 // If no buffer, caller wants the maximum size we will generate
@@ -104,12 +107,13 @@ int XrdXrootdStats::Stats(char *buff, int blen, int do_sync)
                       INMax, INMax,
                       INMax, INMax, INMax,
                       LLMax, INMax, LLMax, INMax, LLMax, INMax,
-                      INMax, INMax, INMax, INMax);
+                      INMax, INMax, INMax, INMax, LLMax, LLMax);
        return len + (fsP ? fsP->getStats(0,0) : 0);
       }
 
-// Format our statistics
+// Format our statistics. Monitoring packets sent in batches are included.
 //
+   XrdNetMsg::Stats(monCalls, monPkts);
    statsMutex.Lock();
    len = snprintf(buff, blen, statfmt,
                   Count,   openCnt, Refresh, readCnt,
@@ -118,7 +122,7 @@ int XrdXrootdStats::Stats(char *buff, int blen, int do_sync)
                   putfCnt, miscCnt,
                   aokSCnt, badSCnt, ignSCnt,
                   AsyncNum, AsyncMax, AsyncRej, errorCnt, redirCnt, stallCnt,
-                  LoginAT, AuthBad, LoginAU, LoginUA);
+                  LoginAT, AuthBad, LoginAU, LoginUA, monCalls, monPkts);
    statsMutex.UnLock();
 
 // Now include filesystem statistics and return
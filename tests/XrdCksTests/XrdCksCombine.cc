@@ -0,0 +1,320 @@
+/******************************************************************************/
+/*                                                                            */
+/*                      X r d C k s C o m b i n e . c c                       */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include "XrdCks/XrdCksCalcadler32.hh"
+#include "XrdCks/XrdCksCalccrc32.hh"
+#include "XrdCks/XrdCksCalccrc32C.hh"
+#include "XrdCks/XrdCksData.hh"
+#include "XrdCks/XrdCksManager.hh"
+#include "XrdSys/XrdSysError.hh"
+#include "XrdSys/XrdSysLogger.hh"
+#include "XrdVersion.hh"
+
+/* This program checks that XrdCksCalc::Combine() yields the same checksum as
+   a calculation over all of the data for adler32, crc32, and crc32c. It then
+   times the checksum of a file done sequentially and in parallel segments by
+   the checksum manager and verifies that both give the same result.
+
+   Usage: xrdcks-combine [-f <file>] [-r <rdsz>] [-s <size>] [-t <threads>]
+
+   -f  use this file for the timing instead of creating a temporary one.
+   -r  the checksum read size (default 1m); files of twice that are split.
+   -s  the size of the temporary file (default 64m); may be suffixed k, m, g.
+   -t  the number of threads for the parallel calculation (default 4).
+*/
+
+/******************************************************************************/
+/*                          U n i t   G l o b a l s                           */
+/******************************************************************************/
+  
+namespace
+{
+XrdSysLogger  myLogger;
+XrdSysError   myEroute(&myLogger, "cks_");
+
+const char   *MeMe = "xrdcks-combine: ";
+int           xRC  = 0;
+
+XrdVERSIONINFODEF(myVer, xrdcks-combine, XrdVNUMBER, XrdVERSION);
+}
+
+#define EMSG(x) xRC=1,fprintf(stderr, "%s%s\n", MeMe, x)
+
+/******************************************************************************/
+/*                         L o c a l   M e t h o d s                          */
+/******************************************************************************/
+  
+namespace
+{
+/******************************************************************************/
+/*                               E l a p s e d                                */
+/******************************************************************************/
+
+double Elapsed(std::chrono::steady_clock::time_point &tBeg)
+{
+   std::chrono::duration<double> secs = std::chrono::steady_clock::now()-tBeg;
+   return secs.count();
+}
+
+/******************************************************************************/
+/*                                  F i l l                                   */
+/******************************************************************************/
+
+void Fill(char *buff, long long blen, unsigned int seed)
+{
+   for (long long i = 0; i < blen; i++)
+       {seed = seed * 1103515245 + 12345;
+        buff[i] = static_cast<char>(seed >> 16);
+       }
+}
+
+/******************************************************************************/
+/*                               C h k S p l i t                              */
+/******************************************************************************/
+
+// Checksum buff in the segments ending at each of the split points and combine
+// them; the result must equal the checksum of the whole buffer.
+//
+bool ChkSplit(XrdCksCalc *csP, const char *buff, int blen,
+              std::vector<int> &cuts)
+{
+   XrdCksCalc *allP = csP->New(), *segP = csP->New(), *sumP = csP->New();
+   int csLen, pos = 0;
+   bool aOK;
+
+   csP->Type(csLen);
+   for (unsigned int i = 0; i <= cuts.size(); i++)
+       {int end = (i < cuts.size() ? cuts[i] : blen);
+        segP->Init();
+        segP->Update(buff+pos, end-pos);
+        if (!i) sumP->Update(buff, end);
+           else if (!sumP->Combine(*segP, end-pos))
+                   {allP->Recycle(); segP->Recycle(); sumP->Recycle();
+                    return false;
+                   }
+        pos = end;
+       }
+
+   aOK = !memcmp(allP->Calc(buff, blen), sumP->Final(), csLen);
+   allP->Recycle(); segP->Recycle(); sumP->Recycle();
+   return aOK;
+}
+
+/******************************************************************************/
+/*                              C h k C a l c                                 */
+/******************************************************************************/
+
+// Check one algorithm at the edges: empty and single byte segments, segment
+// boundaries next to pages, odd tails, and random multi-way splits.
+//
+int ChkCalc(XrdCksCalc *csP, const char *buff, int bmax)
+{
+   static const int Lens[] = {0, 1, 2, 3, 7, 4095, 4096, 4097, 5552, 5553,
+                              65521, 65536, 65537, 1048576+13};
+   std::vector<int> cuts;
+   unsigned int seed = 1;
+   int csLen, nBad = 0, nChk = 0;
+   const char *csName = csP->Type(csLen);
+
+   for (unsigned int i = 0; i < sizeof(Lens)/sizeof(int); i++)
+       {int blen = Lens[i];
+        if (blen > bmax) continue;
+        int Pts[] = {0, 1, blen/2, blen-1, blen, 4095, 4096, 4097};
+        for (unsigned int j = 0; j < sizeof(Pts)/sizeof(int); j++)
+            {if (Pts[j] < 0 || Pts[j] > blen) continue;
+             cuts.assign(1, Pts[j]);
+             nChk++;
+             if (!ChkSplit(csP, buff, blen, cuts)) nBad++;
+            }
+       }
+
+   for (int i = 0; i < 500; i++)
+       {int blen = rand_r(&seed) % (bmax/8), nCut = rand_r(&seed) % 6;
+        cuts.clear();
+        for (int j = 0; j < nCut; j++) cuts.push_back(rand_r(&seed)%(blen+1));
+        std::sort(cuts.begin(), cuts.end());
+        nChk++;
+        if (!ChkSplit(csP, buff, blen, cuts)) nBad++;
+       }
+
+   printf("%s: %d of %d combined checksums differ\n", csName, nBad, nChk);
+   return nBad;
+}
+
+/******************************************************************************/
+/*                               M a k e F i l e                              */
+/******************************************************************************/
+
+bool MakeFile(const char *path, long long fsize)
+{
+   static const int bsz = 1024*1024;
+   std::vector<char> buff(bsz);
+   int fd;
+
+   if ((fd = open(path, O_WRONLY|O_CREAT|O_TRUNC, 0644)) < 0) return false;
+   for (long long done = 0; done < fsize; done += bsz)
+       {int n = (fsize - done < bsz ? fsize - done : bsz);
+        Fill(&buff[0], n, static_cast<unsigned int>(done/bsz));
+        if (write(fd, &buff[0], n) != n) {close(fd); return false;}
+       }
+   return close(fd) == 0;
+}
+
+/******************************************************************************/
+/*                               T i m e C a l c                              */
+/******************************************************************************/
+
+bool TimeCalc(const char *csName, const char *path, int rdsz, int nThreads,
+              XrdCksData &Cks, double &secs)
+{
+   XrdCksManager csMan(&myEroute, rdsz, myVer);
+   std::chrono::steady_clock::time_point tBeg;
+   int rc;
+
+   if (!csMan.Init(0, csName)) return false;
+   csMan.SetThreads(nThreads);
+   Cks.Set(csName);
+   tBeg = std::chrono::steady_clock::now();
+   rc = csMan.Calc(path, Cks, 0);
+   secs = Elapsed(tBeg);
+   if (rc) {fprintf(stderr, "%s%s calc failed; %s\n", MeMe, csName,
+                    strerror(rc < 0 ? -rc : rc));
+            return false;
+           }
+   return true;
+}
+
+/******************************************************************************/
+/*                                 U s a g e                                  */
+/******************************************************************************/
+
+void Usage()
+{
+   fprintf(stderr, "Usage: xrdcks-combine [-f <file>] [-r <rdsz>] "
+                   "[-s <size>] [-t <threads>]\n");
+   exit(2);
+}
+
+/******************************************************************************/
+/*                                 V a l u e                                  */
+/******************************************************************************/
+
+long long Value(const char *arg)
+{
+   char *eP;
+   long long val = strtoll(arg, &eP, 10);
+
+   switch(*eP)
+         {case 'k': case 'K': val <<= 10; eP++; break;
+          case 'm': case 'M': val <<= 20; eP++; break;
+          case 'g': case 'G': val <<= 30; eP++; break;
+          default: break;
+         }
+   if (*eP || val < 0) Usage();
+   return val;
+}
+}
+
+/******************************************************************************/
+/*                                  m a i n                                   */
+/******************************************************************************/
+  
+int main(int argc, char **argv)
+{
+   static const int bmax = 2*1024*1024;
+   XrdCksCalcadler32 csA;
+   XrdCksCalccrc32   csB;
+   XrdCksCalccrc32C  csC;
+   XrdCksCalc       *csVec[] = {&csA, &csB, &csC};
+   XrdCksData        sCks, pCks;
+   std::vector<char> buff(bmax);
+   std::string       tmpFN;
+   const char       *path = 0;
+   char              sVal[XrdCksData::ValuSize*2+1], pVal[sizeof(sVal)];
+   long long         fsize = 64*1024*1024;
+   double            sSecs, pSecs;
+   int               c, rdsz = 1024*1024, nThreads = 4;
+
+// Process the options
+//
+   while((c = getopt(argc, argv, "f:r:s:t:")) != -1)
+        {switch(c)
+               {case 'f': path     = optarg;                      break;
+                case 'r': rdsz     = static_cast<int>(Value(optarg)); break;
+                case 's': fsize    = Value(optarg);               break;
+                case 't': nThreads = atoi(optarg);                break;
+                default:  Usage();
+               }
+        }
+   if (nThreads < 1 || rdsz < 1) Usage();
+
+// Check that combining gives the same result as a single calculation
+//
+   Fill(&buff[0], bmax, 0x5eed);
+   for (unsigned int i = 0; i < sizeof(csVec)/sizeof(csVec[0]); i++)
+       if (ChkCalc(csVec[i], &buff[0], bmax)) xRC = 1;
+
+// Create a file to checksum, if need be
+//
+   if (!path)
+      {tmpFN = "/tmp/xrdcks-combine." + std::to_string(getpid());
+       path  = tmpFN.c_str();
+       if (!MakeFile(path, fsize))
+          {EMSG("Unable to create the test file."); return 1;}
+      }
+
+// Time each checksum sequentially and in parallel; the results must agree
+//
+   for (unsigned int i = 0; i < sizeof(csVec)/sizeof(csVec[0]); i++)
+       {int csLen;
+        const char *csName = csVec[i]->Type(csLen);
+        if (!TimeCalc(csName, path, rdsz, 1,        sCks, sSecs)
+        ||  !TimeCalc(csName, path, rdsz, nThreads, pCks, pSecs))
+           {xRC = 1; continue;}
+        sCks.Get(sVal, sizeof(sVal)); pCks.Get(pVal, sizeof(pVal));
+        printf("%s: %s %.3fs sequential, %s %.3fs with %d threads\n",
+               csName, sVal, sSecs, pVal, pSecs, nThreads);
+        if (sCks != pCks) EMSG("Parallel checksum differs from sequential.");
+       }
+
+// All done
+//
+   if (!tmpFN.empty()) unlink(tmpFN.c_str());
+   return xRC;
+}
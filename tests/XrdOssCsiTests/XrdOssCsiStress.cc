@@ -0,0 +1,348 @@
+/******************************************************************************/
+/*                                                                            */
+/*                    X r d O s s C s i S t r e s s . c c                     */
+/*                                                                            */
+/* (C) Copyright 2026 CERN.                                                   */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* In applying this licence, CERN does not waive the privileges and           */
+/* immunities granted to it by virtue of its status as an Intergovernmental   */
+/* Organization or submit itself to any jurisdiction.                         */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+
+//
+// Stress test and benchmark for the OssCsi range locks and tag page cache.
+//
+// The range test has many threads take random, possibly overlapping, page
+// ranges while other ranges are held, and checks that no write range is ever
+// granted together with an overlapping range. The tag test has many threads
+// write and commit tags that share tag pages while writes to the tag file
+// fail from time to time; once the failures stop every tag must read back
+// from the tag file as last written.
+//
+
+#include "XrdOssCsiRanges.hh"
+#include "XrdOssCsiTagstoreFile.hh"
+#include "XrdOuc/XrdOucEnv.hh"
+#include "XrdOuc/XrdOucTrace.hh"
+#include "XrdSys/XrdSysError.hh"
+#include "XrdSys/XrdSysLogger.hh"
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+#include <sys/stat.h>
+
+XrdSysLogger OssCsiLogger;
+XrdSysError  OssCsiEroute(&OssCsiLogger, "osscsi_");
+XrdOucTrace  OssCsiTrace(&OssCsiEroute);
+
+namespace
+{
+
+struct Parms
+{
+   int threads = 16;
+   int ops = 20000;
+   int held = 1000;
+   int cpages = 16;
+   int ntags = 64*1024;
+   std::string dir = "/tmp";
+};
+
+double Elapsed(const std::chrono::steady_clock::time_point &t0)
+{
+   return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+//
+// A file in the local file system whose writes can be made to fail
+//
+class TestFile : public XrdOssDF
+{
+public:
+   TestFile() : failWrites(0) { }
+   virtual ~TestFile() { if (fd >= 0) ::close(fd); }
+
+   virtual int Open(const char *path, int Oflag, mode_t Mode, XrdOucEnv &env)
+   {
+      fd = ::open(path, Oflag, Mode);
+      return (fd < 0 ? -errno : 0);
+   }
+
+   virtual int Close(long long *retsz=0)
+   {
+      if (fd < 0) return -EBADF;
+      const int ret = ::close(fd);
+      fd = -1;
+      return (ret < 0 ? -errno : 0);
+   }
+
+   virtual int Fstat(struct stat *buf)
+   {
+      return (::fstat(fd, buf) < 0 ? -errno : 0);
+   }
+
+   virtual int Ftruncate(unsigned long long len)
+   {
+      return (::ftruncate(fd, len) < 0 ? -errno : 0);
+   }
+
+   virtual int Fsync() { return (::fsync(fd) < 0 ? -errno : 0); }
+
+   virtual ssize_t Read(void *buff, off_t off, size_t sz)
+   {
+      const ssize_t ret = ::pread(fd, buff, sz, off);
+      return (ret < 0 ? -errno : ret);
+   }
+
+   virtual ssize_t Write(const void *buff, off_t off, size_t sz)
+   {
+      int n = failWrites.load();
+      while(n > 0)
+      {
+         if (failWrites.compare_exchange_weak(n, n-1)) return -EIO;
+      }
+      const ssize_t ret = ::pwrite(fd, buff, sz, off);
+      return (ret < 0 ? -errno : ret);
+   }
+
+   std::atomic<int> failWrites;
+};
+
+/******************************************************************************/
+/*                            R a n g e   T e s t                             */
+/******************************************************************************/
+
+bool RangeTest(const Parms &p)
+{
+   static const off_t npages = 1024;
+   XrdOssCsiRanges ranges;
+   std::vector<std::atomic<int>> writers(npages), readers(npages);
+   std::vector<std::unique_ptr<XrdOssCsiRangeGuard>> heldv;
+   std::atomic<long> violations(0);
+   std::vector<std::thread> tv;
+
+   for(off_t i=0;i<npages;i++) { writers[i] = 0; readers[i] = 0; }
+
+   // ranges held throughout, beyond the pages being exercised, so that the
+   // lock manager has to skip over them on every add and remove
+   for(int i=0;i<p.held;i++)
+   {
+      heldv.emplace_back(new XrdOssCsiRangeGuard());
+      ranges.AddRange(npages+2*i, npages+2*i, *heldv.back(), true);
+   }
+
+   const auto t0 = std::chrono::steady_clock::now();
+   for(int t=0;t<p.threads;t++)
+   {
+      tv.emplace_back([&, t]()
+      {
+         unsigned int seed = 12345u + t;
+         for(int i=0;i<p.ops/p.threads;i++)
+         {
+            const off_t start = rand_r(&seed) % npages;
+            const off_t end = std::min(npages-1, start + (off_t)(rand_r(&seed) % 16));
+            const bool rdonly = (rand_r(&seed) & 1);
+            XrdOssCsiRangeGuard rg;
+            ranges.AddRange(start, end, rg, rdonly);
+            rg.Wait();
+            for(off_t pg=start;pg<=end;pg++)
+            {
+               if (rdonly)
+               {
+                  readers[pg]++;
+                  if (writers[pg]) violations++;
+               }
+               else
+               {
+                  if (writers[pg]++ || readers[pg]) violations++;
+               }
+            }
+            for(off_t pg=start;pg<=end;pg++)
+            {
+               if (rdonly) readers[pg]--;
+                  else writers[pg]--;
+            }
+            rg.ReleaseAll();
+         }
+      });
+   }
+   for(size_t i=0;i<tv.size();i++) tv[i].join();
+   const double secs = Elapsed(t0);
+
+   printf("ranges: %d threads, %d ops, %d held: %.3fs, %ld violations\n",
+          p.threads, (p.ops/p.threads)*p.threads, p.held, secs,
+          violations.load());
+   return violations == 0;
+}
+
+/******************************************************************************/
+/*                              T a g   T e s t                               */
+/******************************************************************************/
+
+bool TagTest(const Parms &p)
+{
+   const std::string fn = p.dir + "/xrdosscsi-stress." + std::to_string(getpid());
+   const int oflags = O_RDWR|O_CREAT;
+   std::vector<uint32_t> expect(p.ntags, 0);
+   std::vector<std::thread> tv;
+   std::atomic<long> nfail(0);
+   std::atomic<bool> failing(true);
+   XrdOucEnv env;
+   bool aOK = true;
+
+   ::unlink(fn.c_str());
+   TestFile *tf = new TestFile();
+   XrdOssCsiTagstoreFile ts(fn, std::unique_ptr<XrdOssDF>(tf), "stress", p.cpages);
+   int ret = ts.Open(fn.c_str(), 0, oflags, env);
+   if (ret<0)
+   {
+      fprintf(stderr, "tags: unable to open %s; %s\n", fn.c_str(), strerror(-ret));
+      return false;
+   }
+
+   // start with a tag file holding all the tags
+   if (ts.WriteTags(&expect[0], 0, p.ntags) != p.ntags || ts.Commit()<0)
+   {
+      fprintf(stderr, "tags: unable to initialize %s\n", fn.c_str());
+      ts.Close();
+      ::unlink(fn.c_str());
+      return false;
+   }
+
+   // each thread owns the tags with index % threads == t, so all threads
+   // share every tag page; writes are batched as in one data write
+   const auto t0 = std::chrono::steady_clock::now();
+   for(int t=0;t<p.threads;t++)
+   {
+      tv.emplace_back([&, t]()
+      {
+         unsigned int seed = 54321u + t;
+         uint32_t val;
+         for(int i=0;i<p.ops/p.threads;i++)
+         {
+            for(int j=0;j<8;j++)
+            {
+               const off_t n = rand_r(&seed) % (p.ntags/p.threads);
+               const off_t idx = n*p.threads + t;
+               val = (uint32_t)(idx*2654435761u) ^ (uint32_t)i;
+               if (ts.WriteTags(&val, idx, 1) == 1) expect[idx] = val;
+                  else nfail++;
+            }
+            if (ts.Commit()<0) nfail++;
+         }
+      });
+   }
+
+   // make writes to the tag file fail now and then while the threads run
+   std::thread fthr([&]()
+   {
+      while(failing)
+      {
+         tf->failWrites = 3;
+         std::this_thread::sleep_for(std::chrono::milliseconds(2));
+      }
+   });
+
+   for(size_t i=0;i<tv.size();i++) tv[i].join();
+   failing = false;
+   fthr.join();
+   tf->failWrites = 0;
+
+   // now that writes succeed, everything still cached must reach the file
+   if ((ret = ts.Commit())<0)
+   {
+      fprintf(stderr, "tags: final commit failed; %s\n", strerror(-ret));
+      aOK = false;
+   }
+   const double secs = Elapsed(t0);
+   ts.SetTrackedSize((off_t)p.ntags*XrdSys::PageSize);
+   ts.Close();
+
+   // read back directly from the tag file
+   XrdOssCsiTagstoreFile vs(fn, std::unique_ptr<XrdOssDF>(new TestFile()), "verify", 0);
+   if ((ret = vs.Open(fn.c_str(), (off_t)p.ntags*XrdSys::PageSize, O_RDWR, env))<0)
+   {
+      fprintf(stderr, "tags: unable to reopen %s; %s\n", fn.c_str(), strerror(-ret));
+      ::unlink(fn.c_str());
+      return false;
+   }
+   std::vector<uint32_t> got(p.ntags, 0);
+   long nbad = 0;
+   if (vs.ReadTags(&got[0], 0, p.ntags) != p.ntags) nbad = p.ntags;
+      else for(int i=0;i<p.ntags;i++) if (got[i] != expect[i]) nbad++;
+   vs.Close();
+   ::unlink(fn.c_str());
+
+   printf("tags: %d threads, %d commits, %d cache pages: %.3fs, "
+          "%ld injected failures seen, %ld lost tags\n",
+          p.threads, (p.ops/p.threads)*p.threads, p.cpages, secs,
+          nfail.load(), nbad);
+   return aOK && nbad == 0;
+}
+
+void Usage()
+{
+   fprintf(stderr, "Usage: xrdosscsi-stress [-t threads] [-n ops] [-h held] "
+                   "[-c cachepages] [-d dir]\n");
+   exit(2);
+}
+}
+
+/******************************************************************************/
+/*                                  m a i n                                   */
+/******************************************************************************/
+
+int main(int argc, char **argv)
+{
+   Parms p;
+   int c;
+
+   while((c = getopt(argc, argv, "t:n:h:c:d:")) != -1)
+   {
+      switch(c)
+      {
+         case 't': p.threads = atoi(optarg); break;
+         case 'n': p.ops     = atoi(optarg); break;
+         case 'h': p.held    = atoi(optarg); break;
+         case 'c': p.cpages  = atoi(optarg); break;
+         case 'd': p.dir     = optarg;       break;
+         default:  Usage();
+      }
+   }
+   if (p.threads < 1 || p.ops < p.threads || p.held < 0 || p.cpages < 1) Usage();
+
+   const bool rOK = RangeTest(p);
+   const bool tOK = TagTest(p);
+   return (rOK && tOK ? 0 : 1);
+}